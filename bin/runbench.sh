@@ -1,65 +1,30 @@
 #!/bin/bash
 echo "Running  SHOC Benchmarks";
 
-export MIC_ENV_PREFIX=MIC
-export MIC_USE_2MB_BUFFERS=32K
-export MIC_KMP_AFFINITY=granularity=fine,balanced
-export MIC_BUFFERSIZE=128M
-export MIC_OMP_NUM_THREADS=228
-export MIC_MKL_DYNAMIC=false
-echo "Running BusSpeedDownload";
-./BusSpeedDownload -s 4&>busspeeddownload.log
-
-echo "Running BusSpeedReadback";
-./BusSpeedReadback -s 4&>busspeedreadback.log
-
-export MIC_OMP_NUM_THREADS=228
-echo "Running DeviceMemory";
-./DeviceMemory &>devicememory.log
-
-echo "Running FFT";
-export MIC_OMP_NUM_THREADS=228
-./FFT --MB 256 &>fft.log
-
-echo "Running GEMM";
-export MIC_OMP_NUM_THREADS=228
-./GEMM --N 4096 &>gemm.log
-
-echo "Running MaxFlops";
-export MIC_OMP_NUM_THREADS=228
-./MaxFlops -s 4&>maxflops.log
-
-echo "Running Reduction";
-export MIC_OMP_NUM_THREADS=114
-./Reduction -s 4&>reduction.log
-
-echo "Running S3D";
-export MIC_OMP_NUM_THREADS=228
-./S3D -s 4&>s3d.log
-
-echo "Running Spmv";
-export MIC_OMP_NUM_THREADS=224
-./Spmv -s 4 &>spmv.log
-
-echo "Running Triad";
-export MIC_OMP_NUM_THREADS=228
-./Triad -s 4 &>triad.log
+# The shoc driver applies the MIC_ENV_PREFIX/MIC_USE_2MB_BUFFERS/
+# MIC_KMP_AFFINITY/MIC_BUFFERSIZE/MIC_MKL_DYNAMIC defaults and the
+# per-benchmark thread counts itself.  The offload runtime reads the
+# MIC_* variables once per process, so the benchmarks that need other
+# settings run in processes of their own.
+echo "Running BusSpeed, BusSpeedDownload, BusSpeedReadback, DeviceMemory,"
+echo "        MemoryLatency, FFT, GEMM, MaxFlops, Reduction, S3D, Spmv, Triad"
+./shoc -s 4 \
+       --DeviceMemory-opts "-s 1" \
+       --FFT-opts "-s 1 --MB 256" \
+       --GEMM-opts "-s 1 --N 4096" \
+       --benchmarks BusSpeed,BusSpeedDownload,BusSpeedReadback,DeviceMemory,MemoryLatency,FFT,GEMM,MaxFlops,Reduction,S3D,Spmv,Triad \
+       "$@" &>shoc.log
 
 echo "Running MD";
-export MIC_OMP_NUM_THREADS=224
+export MIC_ENV_PREFIX=MIC
 export MIC_KMP_AFFINITY=compact
 export MIC_KMP_BLOCKTIME=2s
 export MIC_USE_2MB_BUFFERS=128K
-./MD -s 4 &> md.log
+./shoc -s 4 --benchmarks MD "$@" &>md.log
 
 echo "Running Scan";
-export MIC_OMP_NUM_THREADS=228
 export KMP_DYNAMIC_MODE=load_balance
-./Scan -s 4&>scan.log
+./shoc -s 4 --benchmarks Scan "$@" &>scan.log
 
 echo "Running Stencil2D";
-export MIC_OMP_NUM_THREADS=224
-export KMP_DYNAMIC_MODE=load_balance
-export MIC_USE_2MB_BUFFERS=128K
-export MIC_OMP_NUM_THREADS=228
-./Stencil2Dmain -s 4 &>stencil2d.log
+./shoc -s 4 --benchmarks Stencil2D "$@" &>stencil2d.log
@@ -0,0 +1,283 @@
+// This example from an alpha release of the Scalable HeterOgeneous Computing
+// (SHOC) Benchmark Suite Alpha v1.1.4a-mic for Intel MIC architecture
+// Contact: Kyle Spafford <kys@ornl.gov>
+//          Rezaur Rahman <rezaur.rahman@intel.com>
+//
+// Copyright (c) 2011, UT-Battelle, LLC
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of Oak Ridge National Laboratory, nor UT-Battelle, LLC, 
+//    nor the names of its contributors may be used to endorse or promote 
+//    products derived from this software without specific prior written 
+//    permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, 
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
+// THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include "omp.h"
+
+#include "offload.h"
+#include "Backend.h"
+
+using namespace std;
+
+// ****************************************************************************
+// Function: GetBackend
+//
+// Purpose:
+//   Resolves the --backend option.  "auto" picks the offload backend when
+//   the offload runtime reports at least one coprocessor and falls back to
+//   the host otherwise.  Explicitly requesting the offload backend on a
+//   machine without a card is an error.
+//
+// Arguments:
+//   op: the options parser / parameter database
+//   backend: set to the backend kernels should run on
+//
+// Returns:  false if the option names an unknown backend, or the offload
+//           backend without a card
+//
+// ****************************************************************************
+bool GetBackend(const OptionParser &op, BackendType &backend)
+{
+    const string name = op.getOptionString("backend");
+
+    int nDevices = 0;
+#ifdef __INTEL_OFFLOAD
+    nDevices = _Offload_number_of_devices();
+#endif
+
+    if (name == "host")
+    {
+        backend = BACKEND_HOST;
+        return true;
+    }
+    else if (name == "offload")
+    {
+        if (nDevices <= 0)
+        {
+            cerr << "Error: offload backend requested but no coprocessor "
+                 << "is available" << endl;
+            return false;
+        }
+        backend = BACKEND_OFFLOAD;
+        return true;
+    }
+    else if (name == "auto")
+    {
+        backend = (nDevices > 0) ? BACKEND_OFFLOAD : BACKEND_HOST;
+        return true;
+    }
+
+    cerr << "Error: unknown backend \"" << name
+         << "\" (expected host, offload or auto)" << endl;
+    return false;
+}
+
+bool UseOffload(const OptionParser &op)
+{
+    BackendType backend;
+    return GetBackend(op, backend) && backend == BACKEND_OFFLOAD;
+}
+
+const char *BackendName(const OptionParser &op)
+{
+    return UseOffload(op) ? "offload" : "host";
+}
+
+// ****************************************************************************
+// Function: BackendThreads
+//
+// Purpose:
+//   Reports the OpenMP thread count kernels get on the selected backend, so
+//   that byte and flop counts which scale with the number of threads do not
+//   have to hard-code the 228 hardware threads of a 57-core card.
+//
+// Arguments:
+//   op: the options parser / parameter database
+//
+// Returns:  number of threads in a default parallel region
+//
+// ****************************************************************************
+int BackendThreads(const OptionParser &op)
+{
+    const bool useMIC = UseOffload(op);
+    const int micdev = op.getOptionInt("target");
+    int nThreads = 0;
+
+    #pragma offload target(mic:micdev) if(useMIC) out(nThreads)
+    {
+        nThreads = omp_get_max_threads();
+    }
+    return nThreads;
+}
+
+// ****************************************************************************
+// Function: BackendAlloc
+//
+// Purpose:
+//   Allocates an aligned buffer and zeroes it from a static OpenMP schedule.
+//   On a multi-socket host this places each page on the NUMA node of the
+//   thread that touches it first, which matches the static schedules the
+//   kernels use.  On the offload backend the buffer is the host mirror.
+//
+// Arguments:
+//   bytes:     size of the buffer
+//   alignment: required alignment (power of two)
+//
+// Returns:  the buffer, or NULL on failure
+//
+// ****************************************************************************
+void *BackendAlloc(size_t bytes, size_t alignment)
+{
+    char *ptr = (char *)_mm_malloc(bytes, alignment);
+    if (ptr == NULL)
+    {
+        return NULL;
+    }
+
+    const size_t page = 4096;
+    const long nPages = (long)((bytes + page - 1) / page);
+
+    #pragma omp parallel for schedule(static)
+    for (long p = 0; p < nPages; p++)
+    {
+        size_t offset = (size_t)p * page;
+        size_t len = (offset + page > bytes) ? bytes - offset : page;
+        memset(ptr + offset, 0, len);
+    }
+    return ptr;
+}
+
+void BackendFree(void *ptr)
+{
+    _mm_free(ptr);
+}
+
+// ****************************************************************************
+// Function: BackendCreate
+//
+// Purpose:
+//   Allocates the copy of a host buffer on the card, page aligned and
+//   without copying it.
+//   The copy stays there, found by the host address, until BackendRelease,
+//   so kernel regions name the buffer in a nocopy clause.
+//
+// Arguments:
+//   op:    the options parser / parameter database
+//   ptr:   the host buffer
+//   bytes: its size
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+void BackendCreate(const OptionParser &op, void *ptr, size_t bytes)
+{
+    const bool useMIC = UseOffload(op);
+    const int micdev = op.getOptionInt("target");
+    char *p = (char *)ptr;
+
+    #pragma offload_transfer target(mic:micdev) if(useMIC) \
+        nocopy(p:length(bytes) alloc_if(1) free_if(0) align(4096))
+}
+
+// ****************************************************************************
+// Function: BackendCopyIn
+//
+// Purpose:
+//   Copies a host buffer, or its first bytes, to its copy on the card.
+//
+// Arguments:
+//   op:    the options parser / parameter database
+//   ptr:   the host buffer, created with BackendCreate
+//   bytes: how much to copy
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+void BackendCopyIn(const OptionParser &op, void *ptr, size_t bytes)
+{
+    const bool useMIC = UseOffload(op);
+    const int micdev = op.getOptionInt("target");
+    char *p = (char *)ptr;
+
+    #pragma offload_transfer target(mic:micdev) if(useMIC) \
+        in(p:length(bytes) alloc_if(0) free_if(0))
+}
+
+// ****************************************************************************
+// Function: BackendCopyOut
+//
+// Purpose:
+//   Copies the card's copy of a host buffer, or its first bytes, back.
+//
+// Arguments:
+//   op:    the options parser / parameter database
+//   ptr:   the host buffer, created with BackendCreate
+//   bytes: how much to copy
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+void BackendCopyOut(const OptionParser &op, void *ptr, size_t bytes)
+{
+    const bool useMIC = UseOffload(op);
+    const int micdev = op.getOptionInt("target");
+    char *p = (char *)ptr;
+
+    #pragma offload_transfer target(mic:micdev) if(useMIC) \
+        out(p:length(bytes) alloc_if(0) free_if(0))
+}
+
+// ****************************************************************************
+// Function: BackendRelease
+//
+// Purpose:
+//   Frees the copy of a host buffer on the card.  The host buffer itself
+//   is freed with BackendFree.
+//
+// Arguments:
+//   op:    the options parser / parameter database
+//   ptr:   the host buffer, created with BackendCreate
+//   bytes: the size it was created with
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+void BackendRelease(const OptionParser &op, void *ptr, size_t bytes)
+{
+    const bool useMIC = UseOffload(op);
+    const int micdev = op.getOptionInt("target");
+    char *p = (char *)ptr;
+
+    #pragma offload_transfer target(mic:micdev) if(useMIC) \
+        nocopy(p:length(bytes) alloc_if(0) free_if(1))
+}
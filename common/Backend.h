@@ -0,0 +1,87 @@
+// This example from an alpha release of the Scalable HeterOgeneous Computing
+// (SHOC) Benchmark Suite Alpha v1.1.4a-mic for Intel MIC architecture
+// Contact: Kyle Spafford <kys@ornl.gov>
+//          Rezaur Rahman <rezaur.rahman@intel.com>
+//
+// Copyright (c) 2011, UT-Battelle, LLC
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of Oak Ridge National Laboratory, nor UT-Battelle, LLC, 
+//    nor the names of its contributors may be used to endorse or promote 
+//    products derived from this software without specific prior written 
+//    permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, 
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
+// THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef BACKEND_H
+#define BACKEND_H
+
+#include <stddef.h>
+#include <string>
+
+#include "OptionParser.h"
+
+// ****************************************************************************
+// File:  Backend.h
+//
+// Purpose:
+//   Selects where the benchmark kernels execute.  With the offload backend
+//   every "#pragma offload" region runs on the MIC card chosen by --target.
+//   With the host backend the same regions run natively on the host cores:
+//   each region is guarded by an if(useMIC) clause (as MD has always done),
+//   so the data clauses become no-ops and the kernel body executes in place.
+//
+//   Benchmarks obtain their buffers through BackendAlloc so that, on the
+//   host backend, pages are first touched by the OpenMP threads that will
+//   later stream through them.  Their copies on the card are created,
+//   filled, read back and released with the BackendCreate family; kernel
+//   regions then name the buffers in nocopy clauses.  On the host backend
+//   the kernels work on the host buffers, so those calls do nothing.
+//
+// Creation:    October 16, 2026
+//
+// ****************************************************************************
+enum BackendType
+{
+    BACKEND_HOST,
+    BACKEND_OFFLOAD
+};
+
+// Resolves --backend; false (with a message) if it cannot be used.  The
+// helpers below assume CheckCommonOptions has accepted it.
+bool         GetBackend(const OptionParser &op, BackendType &backend);
+bool         UseOffload(const OptionParser &op);
+const char  *BackendName(const OptionParser &op);
+
+// Number of OpenMP threads kernels will see on the selected backend
+int          BackendThreads(const OptionParser &op);
+
+// Aligned buffer allocation with parallel first touch on the host
+void        *BackendAlloc(size_t bytes, size_t alignment);
+void         BackendFree(void *ptr);
+
+// Copies of host buffers on the card of the offload backend
+void         BackendCreate(const OptionParser &op, void *ptr, size_t bytes);
+void         BackendCopyIn(const OptionParser &op, void *ptr, size_t bytes);
+void         BackendCopyOut(const OptionParser &op, void *ptr, size_t bytes);
+void         BackendRelease(const OptionParser &op, void *ptr, size_t bytes);
+
+#endif
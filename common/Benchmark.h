@@ -0,0 +1,79 @@
+// This example from an alpha release of the Scalable HeterOgeneous Computing
+// (SHOC) Benchmark Suite Alpha v1.1.4a-mic for Intel MIC architecture
+// Contact: Kyle Spafford <kys@ornl.gov>
+//          Rezaur Rahman <rezaur.rahman@intel.com>
+//
+// Copyright (c) 2011, UT-Battelle, LLC
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of Oak Ridge National Laboratory, nor UT-Battelle, LLC, 
+//    nor the names of its contributors may be used to endorse or promote 
+//    products derived from this software without specific prior written 
+//    permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, 
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
+// THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <vector>
+#include "OptionParser.h"
+#include "ResultDatabase.h"
+
+// ****************************************************************************
+// File:  Benchmark.h
+//
+// Purpose:
+//   Registry of the benchmarks linked into an executable.  Each benchmark
+//   keeps addBenchmarkSpecOptions and RunBenchmark file-local and registers
+//   them with SHOC_REGISTER_BENCHMARK, so the per-benchmark main() and the
+//   "shoc" suite driver, which links every benchmark object, find them
+//   without any name clashing.
+//
+// Creation:    October 16, 2026
+//
+// ****************************************************************************
+
+struct Benchmark
+{
+    const char *name;
+    void (*addOptions)(OptionParser &op);
+    void (*run)(OptionParser &op, ResultDatabase &resultDB);
+};
+
+// Adds a benchmark to the registry; called during static initialization
+bool RegisterBenchmark(const char *name,
+                       void (*addOptions)(OptionParser &op),
+                       void (*run)(OptionParser &op,
+                                   ResultDatabase &resultDB));
+
+// The registered benchmarks, in no particular order
+const std::vector<Benchmark> &RegisteredBenchmarks();
+
+// The registered benchmark with this name, or NULL
+const Benchmark *FindBenchmark(const char *name);
+
+// Registers the file's addBenchmarkSpecOptions and RunBenchmark
+#define SHOC_REGISTER_BENCHMARK(name)                                      \
+    static const bool shoc_registered_##name =                             \
+        RegisterBenchmark(#name, addBenchmarkSpecOptions, RunBenchmark)
+
+#endif
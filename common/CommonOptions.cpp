@@ -0,0 +1,266 @@
+// This example from an alpha release of the Scalable HeterOgeneous Computing
+// (SHOC) Benchmark Suite Alpha v1.1.4a-mic for Intel MIC architecture
+// Contact: Kyle Spafford <kys@ornl.gov>
+//          Rezaur Rahman <rezaur.rahman@intel.com>
+//
+// Copyright (c) 2011, UT-Battelle, LLC
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of Oak Ridge National Laboratory, nor UT-Battelle, LLC, 
+//    nor the names of its contributors may be used to endorse or promote 
+//    products derived from this software without specific prior written 
+//    permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, 
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
+// THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <ctime>
+#include <unistd.h>
+
+#include "Backend.h"
+#include "CommonOptions.h"
+#include "Measurement.h"
+#include "PerfCounters.h"
+#include "Timer.h"
+
+using namespace std;
+
+// Build information, normally supplied by the Makefile
+#ifndef SHOC_GIT_REVISION
+#define SHOC_GIT_REVISION "unknown"
+#endif
+#ifndef SHOC_BUILD_FLAGS
+#define SHOC_BUILD_FLAGS "unknown"
+#endif
+
+// ****************************************************************************
+// Function: RecordMetadata
+//
+// Purpose:
+//   Stores a description of the run (host, backend, threading environment
+//   and build) with the results, so exported files can be compared across
+//   machines and builds without the original log.
+//
+// Arguments:
+//   argc, argv: the command line
+//   op:         the options parser / parameter database
+//   resultDB:   the result database to annotate
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+void RecordMetadata(int argc, char **argv, const OptionParser &op,
+                    ResultDatabase &resultDB)
+{
+    char hostname[256] = "unknown";
+    gethostname(hostname, sizeof(hostname));
+    hostname[sizeof(hostname)-1] = '\0';
+    resultDB.SetMetadata("host", hostname);
+
+    string cmdline = argv[0];
+    for (int i = 1; i < argc; i++)
+    {
+        cmdline += string(" ") + argv[i];
+    }
+    resultDB.SetMetadata("command", cmdline);
+
+    char timestamp[64];
+    time_t now = time(NULL);
+    strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%S",
+             localtime(&now));
+    resultDB.SetMetadata("date", timestamp);
+
+    ostringstream threads;
+    threads << BackendThreads(op);
+    resultDB.SetMetadata("backend", BackendName(op));
+    resultDB.SetMetadata("threads", threads.str());
+
+    const char *envVars[] = { "OMP_NUM_THREADS", "KMP_AFFINITY",
+                              "MIC_OMP_NUM_THREADS", "MIC_KMP_AFFINITY",
+                              "MIC_USE_2MB_BUFFERS", "MIC_BUFFERSIZE" };
+    for (int i = 0; i < sizeof(envVars) / sizeof(envVars[0]); i++)
+    {
+        const char *value = getenv(envVars[i]);
+        resultDB.SetMetadata(envVars[i], value ? value : "");
+    }
+
+    ostringstream timer;
+    timer << "resolution " << TimerResolution() * 1.0e9 << " ns, overhead "
+          << TimerOverhead() * 1.0e9 << " ns";
+    resultDB.SetMetadata("timer", timer.str());
+
+    resultDB.SetMetadata("compiler", __VERSION__);
+    resultDB.SetMetadata("build_flags", SHOC_BUILD_FLAGS);
+    resultDB.SetMetadata("git_revision", SHOC_GIT_REVISION);
+}
+
+// ****************************************************************************
+// Function: AddCommonOptions
+//
+// Purpose:
+//   Registers the options shared by all benchmarks.
+//
+// Arguments:
+//   op: the options parser / parameter database
+//
+// Returns:  nothing
+//
+// ****************************************************************************
+void AddCommonOptions(OptionParser &op)
+{
+    op.addOption("verbose", OPT_BOOL, "", "enable verbose output", 'v');
+    op.addOption("passes", OPT_INT, "10", "specify number of passes", 'n');
+    Measurement::AddOptions(op);
+    PerfCounters::AddOptions(op);
+    op.addOption("size", OPT_INT, "1", "specify problem size", 's');
+    op.addOption("target", OPT_INT, "0", "specify MIC target device number",
+                 't');
+    op.addOption("backend", OPT_STRING, "auto",
+                 "where kernels run: host, offload or auto", 'b');
+    op.addOption("output-format", OPT_STRING, "text",
+                 "result format: text, json or csv");
+    op.addOption("output-file", OPT_STRING, "",
+                 "write results to this file instead of stdout");
+    op.addOption("roofline", OPT_STRING, "",
+                 "add a roofline report: table or json");
+    op.addOption("roofline-file", OPT_STRING, "",
+                 "write the roofline report to this file");
+    op.addOption("peak-gflops-sp", OPT_FLOAT, "0",
+                 "SP compute ceiling for --roofline (0: measured)");
+    op.addOption("peak-gflops-dp", OPT_FLOAT, "0",
+                 "DP compute ceiling for --roofline (0: measured)");
+    op.addOption("peak-bandwidth", OPT_FLOAT, "0",
+                 "memory ceiling in GB/s for --roofline (0: measured)");
+}
+
+bool CheckCommonOptions(const OptionParser &op)
+{
+    const string format = op.getOptionString("output-format");
+    if (format != "text" && format != "json" && format != "csv")
+    {
+        cerr << "Error: unknown output format \"" << format
+             << "\" (expected text, json or csv)" << endl;
+        return false;
+    }
+    const string roofline = op.getOptionString("roofline");
+    if (roofline != "" && roofline != "table" && roofline != "json")
+    {
+        cerr << "Error: unknown roofline format \"" << roofline
+             << "\" (expected table or json)" << endl;
+        return false;
+    }
+    if (roofline != "" && format == "csv" &&
+        op.getOptionString("output-file") == "" &&
+        op.getOptionString("roofline-file") == "")
+    {
+        cerr << "Error: --roofline with CSV output on stdout needs "
+             << "--roofline-file" << endl;
+        return false;
+    }
+    BackendType backend;
+    if (!GetBackend(op, backend))
+    {
+        return false;
+    }
+    return true;
+}
+
+// ****************************************************************************
+// Function: DumpResults
+//
+// Purpose:
+//   Prints the results to stdout, or to --output-file, in the format chosen
+//   with --output-format, and the roofline report when --roofline is
+//   given.  The report goes to --roofline-file if set.  Otherwise it is
+//   the "roofline" member of JSON output, follows text output, and goes to
+//   <output-file>.roofline next to CSV output, so machine-readable output
+//   stays a single document.
+//
+// Arguments:
+//   op:       the options parser / parameter database
+//   resultDB: the results to print
+//
+// Returns:  false if an output file could not be opened
+//
+// ****************************************************************************
+bool DumpResults(const OptionParser &op, ResultDatabase &resultDB)
+{
+    ofstream outFile;
+    const string outName = op.getOptionString("output-file");
+    if (!outName.empty())
+    {
+        outFile.open(outName.c_str());
+        if (!outFile)
+        {
+            cerr << "Error: unable to open output file " << outName << endl;
+            return false;
+        }
+    }
+    ostream &out = outName.empty() ? cout : outFile;
+
+    const string format = op.getOptionString("output-format");
+    const string roofline = op.getOptionString("roofline");
+    string rooflineName = op.getOptionString("roofline-file");
+    if (roofline != "" && rooflineName.empty() && format == "csv")
+    {
+        rooflineName = outName + ".roofline";
+    }
+    const bool embedRoofline = roofline != "" && rooflineName.empty() &&
+                               format == "json";
+    const double peakSP = op.getOptionFloat("peak-gflops-sp");
+    const double peakDP = op.getOptionFloat("peak-gflops-dp");
+    const double peakBW = op.getOptionFloat("peak-bandwidth");
+
+    if (format == "json")
+        resultDB.DumpJSON(out, embedRoofline, peakSP, peakDP, peakBW);
+    else if (format == "csv")
+        resultDB.DumpCSV(out);
+    else
+        resultDB.DumpDetailed(out);
+
+    if (roofline == "" || embedRoofline)
+    {
+        return true;
+    }
+    if (rooflineName.empty())
+    {
+        out << endl;
+        resultDB.DumpRoofline(out, roofline == "json", peakSP, peakDP,
+                              peakBW);
+        return true;
+    }
+    ofstream rooflineFile(rooflineName.c_str());
+    if (!rooflineFile)
+    {
+        cerr << "Error: unable to open roofline file " << rooflineName
+             << endl;
+        return false;
+    }
+    resultDB.DumpRoofline(rooflineFile, roofline == "json", peakSP, peakDP,
+                          peakBW);
+    return true;
+}
@@ -0,0 +1,387 @@
+// This example from an alpha release of the Scalable HeterOgeneous Computing
+// (SHOC) Benchmark Suite Alpha v1.1.4a-mic for Intel MIC architecture
+// Contact: Kyle Spafford <kys@ornl.gov>
+//          Rezaur Rahman <rezaur.rahman@intel.com>
+//
+// Copyright (c) 2011, UT-Battelle, LLC
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of Oak Ridge National Laboratory, nor UT-Battelle, LLC, 
+//    nor the names of its contributors may be used to endorse or promote 
+//    products derived from this software without specific prior written 
+//    permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, 
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
+// THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <sched.h>
+#include <unistd.h>
+#include <cpuid.h>
+#include "omp.h"
+
+#include "HostCPU.h"
+
+using namespace std;
+
+// ****************************************************************************
+// Function: HostSupports
+//
+// Purpose:
+//   Checks an instruction set with CPUID.  The wide register state must
+//   also be enabled by the operating system (XCR0), or the first AVX
+//   instruction would fault even on a CPU that implements it.
+//
+// Arguments:
+//   isa: the instruction set to check
+//
+// Returns:  true if kernels using it can run on this host
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+bool HostSupports(HostISA isa)
+{
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return false;
+
+    const bool osxsave = (ecx & (1u << 27)) != 0;
+    const bool fma     = (ecx & (1u << 12)) != 0;
+    if (!osxsave)
+        return false;
+
+    unsigned int xcr0Lo, xcr0Hi;
+    __asm__ volatile ("xgetbv" : "=a"(xcr0Lo), "=d"(xcr0Hi) : "c"(0));
+
+    if (__get_cpuid_max(0, NULL) < 7)
+        return false;
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+
+    switch (isa)
+    {
+      case ISA_AVX2:
+        // XMM and YMM state
+        return (xcr0Lo & 0x06) == 0x06 && fma && (ebx & (1u << 5));
+      case ISA_AVX512:
+        // ...plus opmask and both halves of the ZMM state
+        return (xcr0Lo & 0xe6) == 0xe6 && (ebx & (1u << 16));
+      default:
+        return false;
+    }
+}
+
+// ****************************************************************************
+// Function: HostSockets
+//
+// Purpose:
+//   Groups the CPUs in this process' affinity mask by physical package.
+//
+// Arguments:  none
+//
+// Returns:  one CPU list per socket, in package id order
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+vector<vector<int> > HostSockets()
+{
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+
+    map<int, vector<int> > packages;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    {
+        if (!CPU_ISSET(cpu, &allowed))
+            continue;
+
+        int package = 0;
+        char path[128];
+        sprintf(path, "/sys/devices/system/cpu/cpu%d/topology/"
+                "physical_package_id", cpu);
+        FILE *f = fopen(path, "r");
+        if (f)
+        {
+            if (fscanf(f, "%d", &package) != 1)
+                package = 0;
+            fclose(f);
+        }
+        packages[package].push_back(cpu);
+    }
+
+    vector<vector<int> > sockets;
+    for (map<int, vector<int> >::iterator it = packages.begin();
+         it != packages.end(); ++it)
+    {
+        sockets.push_back(it->second);
+    }
+    return sockets;
+}
+
+// ****************************************************************************
+// Function: HostPhysicalCores
+//
+// Purpose:
+//   Counts the distinct (package, core) pairs of the CPUs in this process'
+//   affinity mask.
+//
+// Arguments:  none
+//
+// Returns:  number of physical cores, at least 1
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+int HostPhysicalCores()
+{
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+
+    map<pair<int, int>, int> cores;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    {
+        if (!CPU_ISSET(cpu, &allowed))
+            continue;
+
+        // Without sysfs every CPU counts as its own core
+        int package = 0, core = cpu;
+        char path[128];
+        sprintf(path, "/sys/devices/system/cpu/cpu%d/topology/"
+                "physical_package_id", cpu);
+        FILE *f = fopen(path, "r");
+        if (f)
+        {
+            if (fscanf(f, "%d", &package) != 1)
+                package = 0;
+            fclose(f);
+        }
+        sprintf(path, "/sys/devices/system/cpu/cpu%d/topology/core_id", cpu);
+        f = fopen(path, "r");
+        if (f)
+        {
+            if (fscanf(f, "%d", &core) != 1)
+                core = cpu;
+            fclose(f);
+        }
+        cores[make_pair(package, core)]++;
+    }
+    return cores.empty() ? 1 : (int)cores.size();
+}
+
+// ****************************************************************************
+// Function: HostRatedGHz
+//
+// Purpose:
+//   Reads the rated (base, non-turbo) clock of the host CPUs, falling back
+//   to the turbo clock and then to the fastest clock in /proc/cpuinfo when
+//   cpufreq does not report it.
+//
+// Arguments:  none
+//
+// Returns:  clock rate in GHz, or 0 if unknown
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+double HostRatedGHz()
+{
+    // base_frequency is the rated clock; cpuinfo_max_freq is the turbo
+    // clock, so it is only used by drivers that lack the former
+    const char *files[] = { "base_frequency", "cpuinfo_max_freq" };
+    FILE *f;
+    for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); i++)
+    {
+        char path[128];
+        sprintf(path, "/sys/devices/system/cpu/cpu0/cpufreq/%s", files[i]);
+        f = fopen(path, "r");
+        if (f)
+        {
+            double khz = 0.0;
+            int n = fscanf(f, "%lf", &khz);
+            fclose(f);
+            if (n == 1 && khz > 0.0)
+                return khz * 1.e-6;
+        }
+    }
+
+    // Virtual machines often lack cpufreq; take the fastest core listed
+    double mhz = 0.0;
+    f = fopen("/proc/cpuinfo", "r");
+    if (f)
+    {
+        char line[256];
+        while (fgets(line, sizeof(line), f))
+        {
+            double m;
+            if (sscanf(line, "cpu MHz : %lf", &m) == 1)
+            {
+                mhz = max(mhz, m);
+            }
+        }
+        fclose(f);
+    }
+    return mhz * 1.e-3;
+}
+
+// ****************************************************************************
+// Function: HostScalingSweep
+//
+// Purpose:
+//   Orders the CPUs in this process' affinity mask for a scaling sweep, so
+//   that the first points add physical cores within a socket, the middle
+//   ones add sockets and the last ones add SMT siblings.
+//
+// Arguments:
+//   cpus: filled with the CPUs in sweep order
+//   teamSizes: filled with the team sizes to measure, ascending
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+void HostScalingSweep(vector<int> &cpus, vector<int> &teamSizes)
+{
+    // Sibling lists of each core, per socket
+    vector<vector<int> > sockets = HostSockets();
+    vector<vector<vector<int> > > cores(sockets.size());
+    size_t maxSiblings = 0;
+    for (size_t s = 0; s < sockets.size(); s++)
+    {
+        map<int, vector<int> > byCore;
+        for (size_t i = 0; i < sockets[s].size(); i++)
+        {
+            int cpu = sockets[s][i], core = cpu;
+            char path[128];
+            sprintf(path, "/sys/devices/system/cpu/cpu%d/topology/core_id",
+                    cpu);
+            FILE *f = fopen(path, "r");
+            if (f)
+            {
+                if (fscanf(f, "%d", &core) != 1)
+                    core = cpu;
+                fclose(f);
+            }
+            byCore[core].push_back(cpu);
+        }
+        for (map<int, vector<int> >::iterator it = byCore.begin();
+             it != byCore.end(); ++it)
+        {
+            cores[s].push_back(it->second);
+            maxSiblings = max(maxSiblings, it->second.size());
+        }
+    }
+
+    cpus.clear();
+    teamSizes.clear();
+    for (size_t sibling = 0; sibling < maxSiblings; sibling++)
+    {
+        for (size_t s = 0; s < cores.size(); s++)
+        {
+            for (size_t c = 0; c < cores[s].size(); c++)
+            {
+                if (sibling < cores[s][c].size())
+                    cpus.push_back(cores[s][c][sibling]);
+            }
+            teamSizes.push_back((int)cpus.size());
+        }
+    }
+    for (int n = 1; n < (int)cpus.size(); n *= 2)
+    {
+        teamSizes.push_back(n);
+    }
+    sort(teamSizes.begin(), teamSizes.end());
+    teamSizes.erase(unique(teamSizes.begin(), teamSizes.end()),
+                    teamSizes.end());
+}
+
+// Affinity and team size before the first PinOpenMPThreads call
+static bool      pinned = false;
+static cpu_set_t originalMask;
+static int       originalThreads = 0;
+static int       largestTeam = 0;
+
+// ****************************************************************************
+// Function: PinOpenMPThreads
+//
+// Purpose:
+//   Binds each thread of the OpenMP team to one CPU of the list.
+//
+// Arguments:
+//   cpus: the CPU for each thread number
+//
+// Returns:  false if the list is empty or a thread could not be bound
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+bool PinOpenMPThreads(const vector<int> &cpus)
+{
+    if (cpus.empty())
+        return false;
+
+    if (!pinned)
+    {
+        CPU_ZERO(&originalMask);
+        sched_getaffinity(0, sizeof(originalMask), &originalMask);
+        originalThreads = omp_get_max_threads();
+        pinned = true;
+    }
+
+    const int nThreads = (int)cpus.size();
+    if (nThreads > largestTeam)
+        largestTeam = nThreads;
+
+    bool ok = true;
+    omp_set_num_threads(nThreads);
+    #pragma omp parallel reduction(&&:ok)
+    {
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
+        CPU_SET(cpus[omp_get_thread_num()], &mask);
+        ok = (sched_setaffinity(0, sizeof(mask), &mask) == 0);
+    }
+
+    if (!ok)
+    {
+        cerr << "Warning: unable to pin OpenMP threads" << endl;
+    }
+    return ok;
+}
+
+void UnpinOpenMPThreads()
+{
+    if (!pinned)
+        return;
+
+    #pragma omp parallel num_threads(largestTeam)
+    {
+        sched_setaffinity(0, sizeof(originalMask), &originalMask);
+    }
+    omp_set_num_threads(originalThreads);
+    pinned = false;
+    largestTeam = 0;
+}
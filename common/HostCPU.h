@@ -0,0 +1,99 @@
+// This example from an alpha release of the Scalable HeterOgeneous Computing
+// (SHOC) Benchmark Suite Alpha v1.1.4a-mic for Intel MIC architecture
+// Contact: Kyle Spafford <kys@ornl.gov>
+//          Rezaur Rahman <rezaur.rahman@intel.com>
+//
+// Copyright (c) 2011, UT-Battelle, LLC
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of Oak Ridge National Laboratory, nor UT-Battelle, LLC, 
+//    nor the names of its contributors may be used to endorse or promote 
+//    products derived from this software without specific prior written 
+//    permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, 
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
+// THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef HOST_CPU_H
+#define HOST_CPU_H
+
+#include <vector>
+
+using std::vector;
+
+// ****************************************************************************
+// File:  HostCPU.h
+//
+// Purpose:
+//   What the host benchmarks need to know about the processor they run on:
+//   which vector instruction sets the CPU and the operating system support
+//   (so intrinsic kernels can be chosen at run time), which logical CPUs
+//   belong to which socket, and a way to pin the OpenMP team to a chosen
+//   set of CPUs so that first-touch page placement and the kernels that
+//   later stream through the pages agree on the NUMA node.
+//
+// Creation:    October 16, 2026
+//
+// ****************************************************************************
+enum HostISA
+{
+    ISA_AVX2,       // AVX2 and FMA
+    ISA_AVX512,     // AVX-512 Foundation
+    NUM_HOST_ISAS
+};
+
+bool HostSupports(HostISA isa);
+
+// Compiles one function for an instruction set the rest of the build does
+// not assume; only call it after HostSupports says the host has the ISA.
+#define SHOC_TARGET_AVX2   __attribute__((target("avx2,fma")))
+#define SHOC_TARGET_AVX512 __attribute__((target("avx512f")))
+
+// Logical CPUs of each socket (physical package), limited to the CPUs this
+// process may run on.  A single socket is reported when sysfs is missing.
+vector<vector<int> > HostSockets();
+
+// Physical cores behind the CPUs this process may run on: hyperthreads of
+// one core share its floating point units, so they count once.
+int HostPhysicalCores();
+
+// Rated (base, non-turbo) clock rate of the CPUs in GHz, from cpufreq's
+// base_frequency.  Falls back to the turbo clock in cpuinfo_max_freq, then
+// to the fastest clock in /proc/cpuinfo; 0 when none says.
+double HostRatedGHz();
+
+// CPUs in the order a thread-scaling sweep adds them: one hardware thread
+// of every core of the first socket, then of every core of the next
+// sockets, then the remaining SMT siblings in the same order.  teamSizes
+// gets the sweep's points: powers of two, the end of each socket's cores,
+// the end of the physical cores and the full count.
+void HostScalingSweep(vector<int> &cpus, vector<int> &teamSizes);
+
+// Pins thread i of every following OpenMP parallel region to cpus[i] and
+// sets the team size to cpus.size().  Relies on the OpenMP runtime reusing
+// its pool threads in order for teams of the same size, which both the GNU
+// and Intel runtimes do.  Returns false if the affinity could not be set.
+bool PinOpenMPThreads(const vector<int> &cpus);
+
+// Gives the team back the affinity mask and size it had before the first
+// PinOpenMPThreads call.
+void UnpinOpenMPThreads();
+
+#endif
@@ -0,0 +1,337 @@
+// This example from an alpha release of the Scalable HeterOgeneous Computing
+// (SHOC) Benchmark Suite Alpha v1.1.4a-mic for Intel MIC architecture
+// Contact: Kyle Spafford <kys@ornl.gov>
+//          Rezaur Rahman <rezaur.rahman@intel.com>
+//
+// Copyright (c) 2011, UT-Battelle, LLC
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of Oak Ridge National Laboratory, nor UT-Battelle, LLC, 
+//    nor the names of its contributors may be used to endorse or promote 
+//    products derived from this software without specific prior written 
+//    permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, 
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
+// THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "Measurement.h"
+
+using namespace std;
+
+// Fewest kept samples a confidence interval is computed from
+static const int MIN_CI_SAMPLES = 5;
+
+// Samples further than this many (scaled) median absolute deviations from
+// the median are outliers
+static const double OUTLIER_MADS = 3.0;
+
+// The outlier bound is never narrower than this fraction of the median, so
+// quantized timings, where most samples are equal and the MAD is 0, do not
+// reject every sample that differs from the median
+static const double OUTLIER_MIN_FRACTION = 0.01;
+
+static double SortedMedian(const vector<double> &v)
+{
+    int n = v.size();
+    if (n == 0)
+        return 0.0;
+    return (n % 2) ? v[n/2] : (v[n/2 - 1] + v[n/2]) / 2.0;
+}
+
+// Median and scaled median absolute deviation (a robust standard
+// deviation) of some samples
+static void RobustSpread(const vector<double> &samples, double &median,
+                         double &sigma)
+{
+    vector<double> sorted(samples);
+    sort(sorted.begin(), sorted.end());
+    median = SortedMedian(sorted);
+
+    vector<double> dev(sorted.size());
+    for (int i = 0; i < sorted.size(); i++)
+        dev[i] = fabs(sorted[i] - median);
+    sort(dev.begin(), dev.end());
+    sigma = 1.4826 * SortedMedian(dev);
+}
+
+// ****************************************************************************
+// Function: KeptSamples
+//
+// Purpose:
+//   Drops warm-up runs and outliers.  The steady state is taken from the
+//   second half of the samples, in the order they were taken; the leading
+//   run of samples more than one robust standard deviation (at least the
+//   timer resolution) above its median is warm-up, at most half of the
+//   samples.  The remaining samples outside median +/- OUTLIER_MADS
+//   robust standard deviations are rejected, with the bound at least
+//   OUTLIER_MIN_FRACTION of the median and the timer resolution.
+//
+// Arguments:
+//   samples: the samples in the order they were taken
+//
+// Returns:  the kept samples, in the order they were taken
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+static vector<double> KeptInOrder(const vector<double> &samples)
+{
+    const int n = samples.size();
+    double median, sigma;
+
+    // The leading samples that have not come down to the steady state yet
+    RobustSpread(vector<double>(samples.begin() + n / 2, samples.end()),
+                 median, sigma);
+    const double steady = median + max(sigma, TimerResolution());
+    int warmup = 0;
+    while (warmup < n / 2 && samples[warmup] > steady)
+    {
+        warmup++;
+    }
+
+    vector<double> rest(samples.begin() + warmup, samples.end());
+    RobustSpread(rest, median, sigma);
+    double bound = max(OUTLIER_MADS * sigma,
+                       max(OUTLIER_MIN_FRACTION * fabs(median),
+                           TimerResolution()));
+
+    vector<double> kept;
+    for (int i = 0; i < rest.size(); i++)
+    {
+        if (fabs(rest[i] - median) <= bound)
+            kept.push_back(rest[i]);
+    }
+    return kept;
+}
+
+static vector<double> KeptSamples(const vector<double> &samples)
+{
+    vector<double> kept = KeptInOrder(samples);
+    sort(kept.begin(), kept.end());
+    return kept;
+}
+
+// ****************************************************************************
+// Function: SortedRelCI
+//
+// Purpose:
+//   Distribution-free 95% confidence interval of the median, from the
+//   order statistics at ranks n/2 -/+ 0.98 sqrt(n).
+//
+// Arguments:
+//   v: sorted samples
+//
+// Returns:  half-width of the interval relative to the median; for a
+//           median of 0, 0 if the interval is empty and HUGE_VAL otherwise
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+static double SortedRelCI(const vector<double> &v)
+{
+    int n = v.size();
+    double median = SortedMedian(v);
+    if (n < 2)
+        return HUGE_VAL;
+
+    int lo = (int)floor(n / 2.0 - 0.98 * sqrt((double)n));
+    int hi = (int)ceil(n / 2.0 + 0.98 * sqrt((double)n));
+    lo = max(lo, 0);
+    hi = min(hi, n - 1);
+
+    // No relative width around a zero median: it has converged only if
+    // the samples around it are all equal
+    if (median == 0.0)
+        return (v[hi] == v[lo]) ? 0.0 : HUGE_VAL;
+    return (v[hi] - v[lo]) / (2.0 * fabs(median));
+}
+
+Measurement::Measurement(const OptionParser &op)
+{
+    passes     = op.getOptionInt("passes");
+    maxPasses  = op.getOptionInt("max-passes");
+    relCI      = op.getOptionFloat("rel-ci") / 100.0;
+    timeBudget = op.getOptionFloat("time-budget");
+    startTime  = curr_second();
+    nSamples   = 0;
+    nSamplesChecked = -1;
+}
+
+// ****************************************************************************
+// Method: Measurement::AddOptions
+//
+// Purpose:
+//   Registers the repetition options; part of the common options.
+//
+// Arguments:
+//   op: the options parser / parameter database
+//
+// Returns:  nothing
+//
+// ****************************************************************************
+void Measurement::AddOptions(OptionParser &op)
+{
+    op.addOption("rel-ci", OPT_FLOAT, "0",
+                 "repeat until the 95% CI of the median is within this "
+                 "percentage (0: run --passes times)");
+    op.addOption("max-passes", OPT_INT, "1000",
+                 "most repetitions of a region with --rel-ci");
+    op.addOption("time-budget", OPT_FLOAT, "60",
+                 "seconds after which --rel-ci stops repeating");
+}
+
+bool Measurement::OverBudget() const
+{
+    return timeBudget > 0.0 && curr_second() - startTime > timeBudget;
+}
+
+// ****************************************************************************
+// Method: Measurement::Done
+//
+// Purpose:
+//   Tells whether a region needs more samples.
+//
+// Arguments:
+//   region: the region name
+//
+// Returns:  true when the region ran --passes times (fixed mode), or when
+//           its CI target, --max-passes or the time budget was reached
+//
+// ****************************************************************************
+bool Measurement::Done(const string &region) const
+{
+    int count = timer.Count(region);
+    if (!Adaptive())
+    {
+        return count >= passes;
+    }
+    if (count >= maxPasses || OverBudget())
+    {
+        return true;
+    }
+
+    vector<double> kept = KeptSamples(timer.Samples(region));
+    return kept.size() >= MIN_CI_SAMPLES && SortedRelCI(kept) <= relCI;
+}
+
+bool Measurement::Finished()
+{
+    // A pass that started no region means every region is done
+    if (nSamplesChecked == nSamples)
+    {
+        return true;
+    }
+    nSamplesChecked = nSamples;
+
+    if (regions.empty())
+    {
+        return false;
+    }
+    for (set<string>::const_iterator it = regions.begin();
+         it != regions.end(); ++it)
+    {
+        if (!Done(*it))
+            return false;
+    }
+    return true;
+}
+
+void Measurement::Start(const string &region)
+{
+    regions.insert(region);
+    nSamples++;
+    timer.Start(region);
+}
+
+double Measurement::Stop(const string &region)
+{
+    return timer.Stop(region);
+}
+
+void Measurement::Add(const string &region, double seconds)
+{
+    regions.insert(region);
+    nSamples++;
+    timer.Add(region, seconds);
+}
+
+int Measurement::Count(const string &region) const
+{
+    return timer.Count(region);
+}
+
+// Samples used for statistics, sorted; filtering only applies with --rel-ci
+vector<double> Measurement::Kept(const string &region) const
+{
+    vector<double> samples = timer.Samples(region);
+    if (Adaptive())
+    {
+        return KeptSamples(samples);
+    }
+    sort(samples.begin(), samples.end());
+    return samples;
+}
+
+vector<double> Measurement::Samples(const string &region) const
+{
+    // Keep the order the samples were taken in
+    vector<double> samples = timer.Samples(region);
+    return Adaptive() ? KeptInOrder(samples) : samples;
+}
+
+double Measurement::Median(const string &region) const
+{
+    return SortedMedian(Kept(region));
+}
+
+double Measurement::RelCI(const string &region) const
+{
+    return SortedRelCI(Kept(region));
+}
+
+// ****************************************************************************
+// Method: Measurement::RecordConfidence
+//
+// Purpose:
+//   Stores the CI achieved for a region with a result derived from it.  The
+//   relative width is the same for a time and for a rate computed from it.
+//
+// Arguments:
+//   resultDB:   the result database
+//   region:     the timed region
+//   test, atts: the result to annotate
+//
+// Returns:  nothing
+//
+// ****************************************************************************
+void Measurement::RecordConfidence(ResultDatabase &resultDB,
+                                   const string &region, const string &test,
+                                   const string &atts) const
+{
+    double ci = RelCI(region);
+    if (ci < HUGE_VAL)
+    {
+        resultDB.SetConfidence(test, atts, ci * 100.0);
+    }
+}
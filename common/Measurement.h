@@ -0,0 +1,112 @@
+// This example from an alpha release of the Scalable HeterOgeneous Computing
+// (SHOC) Benchmark Suite Alpha v1.1.4a-mic for Intel MIC architecture
+// Contact: Kyle Spafford <kys@ornl.gov>
+//          Rezaur Rahman <rezaur.rahman@intel.com>
+//
+// Copyright (c) 2011, UT-Battelle, LLC
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of Oak Ridge National Laboratory, nor UT-Battelle, LLC, 
+//    nor the names of its contributors may be used to endorse or promote 
+//    products derived from this software without specific prior written 
+//    permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, 
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
+// THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef MEASUREMENT_H
+#define MEASUREMENT_H
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "OptionParser.h"
+#include "ResultDatabase.h"
+#include "Timer.h"
+
+using std::set;
+
+// ****************************************************************************
+// Class:  Measurement
+//
+// Purpose:
+//   Decides how often the timed regions of a benchmark are repeated.  By
+//   default every region runs exactly --passes times, as before.  With
+//   --rel-ci every region is repeated until the 95% confidence interval of
+//   its median is within the requested percentage, or until --max-passes or
+//   the --time-budget is reached.
+//
+//   With --rel-ci, warm-up samples (slow leading runs) and outliers are
+//   dropped before the statistics are computed; Samples() returns the
+//   samples that were kept.
+//
+//   Typical use keeps the benchmark's own pass/size loop structure:
+//
+//       Measurement meas(op);
+//       while (!meas.Finished())
+//           for (each size)
+//               if (!meas.Done(region)) { meas.Start(region); ...;
+//                                         meas.Stop(region); }
+//
+// Creation:    October 16, 2026
+//
+// ****************************************************************************
+class Measurement
+{
+  private:
+    RegionTimer timer;
+    set<string> regions;
+
+    int    passes;
+    int    maxPasses;
+    double relCI;
+    double timeBudget;
+    double startTime;
+
+    int nSamples;
+    int nSamplesChecked;
+
+    bool           OverBudget() const;
+    vector<double> Kept(const string &region) const;
+
+  public:
+    Measurement(const OptionParser &op);
+
+    static void AddOptions(OptionParser &op);
+
+    bool   Adaptive() const { return relCI > 0.0; }
+    bool   Done(const string &region) const;
+    bool   Finished();
+
+    void   Start(const string &region);
+    double Stop(const string &region);
+    void   Add(const string &region, double seconds);
+
+    int            Count(const string &region) const;
+    vector<double> Samples(const string &region) const;
+    double         Median(const string &region) const;
+    double         RelCI(const string &region) const;
+
+    void RecordConfidence(ResultDatabase &resultDB, const string &region,
+                          const string &test, const string &atts) const;
+};
+
+#endif
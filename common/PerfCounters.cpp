@@ -0,0 +1,328 @@
+// This example from an alpha release of the Scalable HeterOgeneous Computing
+// (SHOC) Benchmark Suite Alpha v1.1.4a-mic for Intel MIC architecture
+// Contact: Kyle Spafford <kys@ornl.gov>
+//          Rezaur Rahman <rezaur.rahman@intel.com>
+//
+// Copyright (c) 2011, UT-Battelle, LLC
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of Oak Ridge National Laboratory, nor UT-Battelle, LLC, 
+//    nor the names of its contributors may be used to endorse or promote 
+//    products derived from this software without specific prior written 
+//    permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, 
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
+// THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <linux/perf_event.h>
+
+#include "Backend.h"
+#include "PerfCounters.h"
+
+using namespace std;
+
+// Bytes moved per last level cache miss
+static const double CACHE_LINE_BYTES = 64.0;
+
+static long PerfEventOpen(struct perf_event_attr *attr, pid_t tid,
+                          int groupFd)
+{
+    return syscall(__NR_perf_event_open, attr, tid, -1, groupFd, 0);
+}
+
+PerfCounters::PerfCounters(const OptionParser &op)
+{
+    enabled = op.getOptionBool("perf-counters");
+    fpEvent = strtoull(op.getOptionString("perf-fp-event").c_str(), NULL, 0);
+
+    if (enabled && UseOffload(op))
+    {
+        cerr << "Warning: hardware counters only see host threads, "
+             << "ignoring --perf-counters with the offload backend" << endl;
+        enabled = false;
+    }
+
+    for (int e = 0; e < NUM_EVENTS; e++)
+    {
+        counts[e]  = 0.0;
+        counted[e] = false;
+    }
+}
+
+PerfCounters::~PerfCounters()
+{
+    Close();
+}
+
+// ****************************************************************************
+// Method: PerfCounters::AddOptions
+//
+// Purpose:
+//   Registers the counter options; part of the common options.
+//
+// Arguments:
+//   op: the options parser / parameter database
+//
+// Returns:  nothing
+//
+// ****************************************************************************
+void PerfCounters::AddOptions(OptionParser &op)
+{
+    op.addOption("perf-counters", OPT_BOOL, "",
+                 "collect hardware counters around kernels (host backend)");
+    op.addOption("perf-fp-event", OPT_STRING, "",
+                 "raw perf event code counting FP operations, e.g. 0x01c7");
+}
+
+// ****************************************************************************
+// Method: PerfCounters::Open
+//
+// Purpose:
+//   Opens one counter group per thread listed in /proc/self/task, led by
+//   the first event that opens, so all events of a thread are scheduled
+//   together and derived ratios such as IPC come from the same time
+//   window even when the kernel multiplexes counters.  Events the
+//   processor or kernel does not support are left out of the group; if no
+//   group can be opened the collector disables itself.
+//
+// Arguments:
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+void PerfCounters::Open()
+{
+    struct perf_event_attr attrs[NUM_EVENTS];
+    memset(attrs, 0, sizeof(attrs));
+
+    attrs[CYCLES].type           = PERF_TYPE_HARDWARE;
+    attrs[CYCLES].config         = PERF_COUNT_HW_CPU_CYCLES;
+    attrs[INSTRUCTIONS].type     = PERF_TYPE_HARDWARE;
+    attrs[INSTRUCTIONS].config   = PERF_COUNT_HW_INSTRUCTIONS;
+    attrs[LLC_REFERENCES].type   = PERF_TYPE_HARDWARE;
+    attrs[LLC_REFERENCES].config = PERF_COUNT_HW_CACHE_REFERENCES;
+    attrs[LLC_MISSES].type       = PERF_TYPE_HARDWARE;
+    attrs[LLC_MISSES].config     = PERF_COUNT_HW_CACHE_MISSES;
+    attrs[DTLB_MISSES].type      = PERF_TYPE_HW_CACHE;
+    attrs[DTLB_MISSES].config    = PERF_COUNT_HW_CACHE_DTLB |
+                                   (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                   (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attrs[FP_OPS].type           = PERF_TYPE_RAW;
+    attrs[FP_OPS].config         = fpEvent;
+
+    // Members follow their leader, which alone is enabled and read
+    for (int e = 0; e < NUM_EVENTS; e++)
+    {
+        attrs[e].size           = sizeof(struct perf_event_attr);
+        attrs[e].exclude_kernel = 1;
+        attrs[e].exclude_hv     = 1;
+        attrs[e].read_format    = PERF_FORMAT_GROUP |
+                                  PERF_FORMAT_TOTAL_TIME_ENABLED |
+                                  PERF_FORMAT_TOTAL_TIME_RUNNING;
+    }
+
+    DIR *tasks = opendir("/proc/self/task");
+    if (tasks == NULL)
+    {
+        enabled = false;
+        return;
+    }
+
+    struct dirent *entry;
+    while ((entry = readdir(tasks)) != NULL)
+    {
+        pid_t tid = atoi(entry->d_name);
+        if (tid <= 0)
+            continue;
+
+        int leader = -1;
+        vector<int> events;
+        for (int e = 0; e < NUM_EVENTS; e++)
+        {
+            if (e == FP_OPS && fpEvent == 0)
+                continue;
+
+            attrs[e].disabled = (leader < 0);
+            int fd = PerfEventOpen(&attrs[e], tid, leader);
+            if (fd >= 0)
+            {
+                fds.push_back(fd);
+                events.push_back(e);
+                if (leader < 0)
+                    leader = fd;
+            }
+        }
+        if (leader >= 0)
+        {
+            leaders.push_back(leader);
+            groupEvents.push_back(events);
+        }
+    }
+    closedir(tasks);
+
+    if (leaders.empty())
+    {
+        cerr << "Warning: perf_event_open failed (" << strerror(errno)
+             << "), check /proc/sys/kernel/perf_event_paranoid; "
+             << "disabling hardware counters" << endl;
+        enabled = false;
+    }
+}
+
+void PerfCounters::Close()
+{
+    for (int i = 0; i < fds.size(); i++)
+    {
+        close(fds[i]);
+    }
+    fds.clear();
+    leaders.clear();
+    groupEvents.clear();
+}
+
+void PerfCounters::Start()
+{
+    if (!enabled)
+        return;
+
+    Open();
+    for (int i = 0; i < leaders.size(); i++)
+    {
+        ioctl(leaders[i], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leaders[i], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+}
+
+// ****************************************************************************
+// Method: PerfCounters::Stop
+//
+// Purpose:
+//   Stops counting and adds the counts of all threads to the totals,
+//   scaled up when the kernel had to multiplex the groups.  A group that
+//   never got the counters adds nothing.
+//
+// Arguments:
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+void PerfCounters::Stop()
+{
+    if (!enabled)
+        return;
+
+    for (int i = 0; i < leaders.size(); i++)
+    {
+        ioctl(leaders[i], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+    for (int i = 0; i < leaders.size(); i++)
+    {
+        // Number of events, time enabled, time running, then the counts
+        unsigned long long value[3 + NUM_EVENTS];
+        const vector<int> &events = groupEvents[i];
+        const ssize_t bytes = (3 + events.size()) * sizeof(value[0]);
+        if (read(leaders[i], value, sizeof(value)) != bytes ||
+            value[0] != events.size() || value[2] == 0)
+        {
+            continue;
+        }
+        const double scale = (double)value[1] / value[2];
+        for (int j = 0; j < events.size(); j++)
+        {
+            counts[events[j]] += value[3 + j] * scale;
+            counted[events[j]] = true;
+        }
+    }
+    Close();
+}
+
+// ****************************************************************************
+// Method: PerfCounters::Record
+//
+// Purpose:
+//   Adds the derived metrics of the regions counted since the last call as
+//   results named <test>_IPC, <test>_LLCMissRate, <test>_dTLBMPKI and
+//   <test>_BytesPerFlop, then clears the totals.
+//
+// Arguments:
+//   resultDB:   the result database
+//   test, atts: name of the kernel result the counts belong to
+//   flops:      flops executed in those regions, used when FP operations
+//               are not counted (negative if unknown)
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+void PerfCounters::Record(ResultDatabase &resultDB, const string &test,
+                          const string &atts, double flops)
+{
+    if (!enabled)
+        return;
+
+    if (counted[CYCLES] && counted[INSTRUCTIONS] && counts[CYCLES] > 0)
+    {
+        resultDB.AddResult(test + "_IPC", atts, "instr/cycle",
+                           counts[INSTRUCTIONS] / counts[CYCLES]);
+    }
+    if (counted[LLC_REFERENCES] && counted[LLC_MISSES] &&
+        counts[LLC_REFERENCES] > 0)
+    {
+        resultDB.AddResult(test + "_LLCMissRate", atts, "%",
+                           100.0 * counts[LLC_MISSES] / counts[LLC_REFERENCES]);
+    }
+    if (counted[DTLB_MISSES] && counted[INSTRUCTIONS] &&
+        counts[INSTRUCTIONS] > 0)
+    {
+        resultDB.AddResult(test + "_dTLBMPKI", atts, "misses/kinstr",
+                           1000.0 * counts[DTLB_MISSES] / counts[INSTRUCTIONS]);
+    }
+
+    if (counted[FP_OPS])
+    {
+        flops = counts[FP_OPS];
+    }
+    if (counted[LLC_MISSES] && flops > 0)
+    {
+        resultDB.AddResult(test + "_BytesPerFlop", atts, "B/flop",
+                           counts[LLC_MISSES] * CACHE_LINE_BYTES / flops);
+    }
+
+    for (int e = 0; e < NUM_EVENTS; e++)
+    {
+        counts[e]  = 0.0;
+        counted[e] = false;
+    }
+}
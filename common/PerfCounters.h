@@ -0,0 +1,111 @@
+// This example from an alpha release of the Scalable HeterOgeneous Computing
+// (SHOC) Benchmark Suite Alpha v1.1.4a-mic for Intel MIC architecture
+// Contact: Kyle Spafford <kys@ornl.gov>
+//          Rezaur Rahman <rezaur.rahman@intel.com>
+//
+// Copyright (c) 2011, UT-Battelle, LLC
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of Oak Ridge National Laboratory, nor UT-Battelle, LLC, 
+//    nor the names of its contributors may be used to endorse or promote 
+//    products derived from this software without specific prior written 
+//    permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, 
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
+// THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <string>
+#include <vector>
+
+#include "OptionParser.h"
+#include "ResultDatabase.h"
+
+using std::string;
+using std::vector;
+
+// ****************************************************************************
+// Class:  PerfCounters
+//
+// Purpose:
+//   Optional hardware counter collection around timed kernel regions,
+//   through Linux perf_event_open.  Counts cycles, instructions, last level
+//   cache references and misses, dTLB load misses and, when a raw event
+//   code is given with --perf-fp-event, floating point operations.  Record
+//   turns them into extra result rows: IPC, LLC miss rate, dTLB misses per
+//   thousand instructions and DRAM bytes per flop.
+//
+//   Counters are opened on every thread of the process when a region
+//   starts, so threads of an existing OpenMP pool are included.  The events
+//   of a thread form one group, so they are counted over the same time.  They only
+//   see host threads: with the offload backend, kernels run on the card
+//   and the collector stays off.
+//
+// Creation:    October 16, 2026
+//
+// ****************************************************************************
+class PerfCounters
+{
+  public:
+    enum Event
+    {
+        CYCLES,
+        INSTRUCTIONS,
+        LLC_REFERENCES,
+        LLC_MISSES,
+        DTLB_MISSES,
+        FP_OPS,
+        NUM_EVENTS
+    };
+
+  private:
+    bool               enabled;
+    unsigned long long fpEvent;
+
+    // Every open counter, and per thread its group leader and the events
+    // of the group in read order
+    vector<int>          fds;
+    vector<int>          leaders;
+    vector<vector<int> > groupEvents;
+
+    double counts[NUM_EVENTS];
+    bool   counted[NUM_EVENTS];
+
+    void Open();
+    void Close();
+
+  public:
+    PerfCounters(const OptionParser &op);
+    ~PerfCounters();
+
+    static void AddOptions(OptionParser &op);
+
+    bool Enabled() const { return enabled; }
+
+    void Start();
+    void Stop();
+
+    void Record(ResultDatabase &resultDB, const string &test,
+                const string &atts, double flops = -1.0);
+};
+
+#endif
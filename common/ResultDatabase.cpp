@@ -34,6 +34,8 @@
 #include <algorithm>
 #include <cfloat>
 #include <cmath>
+#include <cstdio>
+#include <sstream>
 #include "ResultDatabase.h"
 
 using namespace std;
@@ -110,6 +112,153 @@ double ResultDatabase::Result::GetStdDev()
     return r;
 }
 
+// ****************************************************************************
+//  Method:  ResultDatabase::Percentile
+//
+//  Purpose:
+//    Returns the q-th percentile (0 <= q <= 100) of a set of values,
+//    interpolating linearly between the closest ranks, so the 50th
+//    percentile is the median.  Every report uses this definition.
+//
+//  Arguments:
+//    values     the values, in any order
+//    q          the percentile to compute
+//
+//  Creation:    October 16, 2026
+//
+// ****************************************************************************
+double ResultDatabase::Percentile(vector<double> values, double q)
+{
+    int n = values.size();
+    if (n == 0)
+        return 0.;
+    if (n == 1)
+        return values[0];
+
+    sort(values.begin(), values.end());
+
+    double pos = (q / 100.) * (n - 1);
+    if (pos <= 0.)
+        return values[0];
+    if (pos >= n - 1)
+        return values[n-1];
+
+    int lo = (int)floor(pos);
+    double frac = pos - lo;
+    return values[lo] + frac * (values[lo+1] - values[lo]);
+}
+
+double ResultDatabase::Result::GetPercentile(double q)
+{
+    return Percentile(value, q);
+}
+
+void ResultDatabase::SetMetadata(const string &key, const string &value)
+{
+    metadata[key] = value;
+}
+
+// ****************************************************************************
+//  Method:  ResultDatabase::SetConfidence
+//
+//  Purpose:
+//    Attaches the relative confidence interval achieved for the median of
+//    an existing result (see Measurement).
+//
+//  Arguments:
+//    test, atts  the result to annotate
+//    relCI       half-width of the 95% CI of the median, in % of the median
+//
+//  Creation:    October 16, 2026
+//
+// ****************************************************************************
+void ResultDatabase::SetConfidence(const string &test,
+                                   const string &atts,
+                                   double relCI)
+{
+    int index = FindResult(test, atts);
+    if (index >= 0)
+    {
+        results[index].relCI = relCI;
+    }
+}
+
+int ResultDatabase::FindResult(const string &test, const string &atts) const
+{
+    for (int i=0; i<results.size(); i++)
+    {
+        if (results[i].test == test && results[i].atts == atts)
+            return i;
+    }
+    return -1;
+}
+
+// ****************************************************************************
+//  Method:  ResultDatabase::SetWork
+//
+//  Purpose:
+//    Declares the work behind a GFLOPS result, for the roofline report.
+//
+//  Arguments:
+//    test, atts  the result to annotate
+//    flops       floating point operations of one kernel run
+//    bytes       compulsory memory traffic of that run
+//    precision   "SP" or "DP", selecting the compute ceiling
+//
+//  Creation:    October 16, 2026
+//
+// ****************************************************************************
+void ResultDatabase::SetWork(const string &test,
+                             const string &atts,
+                             double flops,
+                             double bytes,
+                             const string &precision)
+{
+    int index = FindResult(test, atts);
+    if (index >= 0)
+    {
+        results[index].flops = flops;
+        results[index].bytes = bytes;
+        results[index].precision = precision;
+    }
+}
+
+// ****************************************************************************
+//  Method:  ResultDatabase::SetCeiling
+//
+//  Purpose:
+//    Marks a result as a measurement of a roofline ceiling: "SP" or "DP"
+//    for GFLOPS peaks, "BW" for GB/s bandwidth peaks.
+//
+//  Arguments:
+//    test, atts  the result to mark
+//    kind        the ceiling it measures
+//
+//  Creation:    October 16, 2026
+//
+// ****************************************************************************
+void ResultDatabase::SetCeiling(const string &test,
+                                const string &atts,
+                                const string &kind)
+{
+    int index = FindResult(test, atts);
+    if (index >= 0)
+    {
+        results[index].ceiling = kind;
+    }
+}
+
+// Best median among the results marked as this ceiling (0: none)
+double ResultDatabase::GetCeiling(const string &kind)
+{
+    double peak = 0.0;
+    for (int i=0; i<results.size(); i++)
+    {
+        if (results[i].ceiling == kind && !results[i].value.empty())
+            peak = max(peak, results[i].GetMedian());
+    }
+    return peak;
+}
 
 void ResultDatabase::AddResults(const string &test,
                                 const string &atts,
@@ -278,3 +427,348 @@ void ResultDatabase::DumpSummary(ostream &out)
         << "might occur with a mixture of architectural capabilities." << endl;
 }
 
+
+
+// Percentiles reported by the machine-readable dumps
+static const int    nPercentiles = 4;
+static const double percentiles[nPercentiles] = { 5., 25., 75., 95. };
+
+// ****************************************************************************
+//  Function:  JSONString
+//
+//  Purpose:
+//    Quotes and escapes a string for inclusion in a JSON document.
+//
+// ****************************************************************************
+static string JSONString(const string &in)
+{
+    ostringstream out;
+    out << '"';
+    for (size_t i=0; i<in.size(); i++)
+    {
+        char c = in[i];
+        switch (c)
+        {
+          case '"':  out << "\\\""; break;
+          case '\\': out << "\\\\"; break;
+          case '\n': out << "\\n"; break;
+          case '\t': out << "\\t"; break;
+          case '\r': out << "\\r"; break;
+          default:
+            if ((unsigned char)c < 0x20)
+            {
+                char buf[8];
+                sprintf(buf, "\\u%04x", (unsigned char)c);
+                out << buf;
+            }
+            else
+            {
+                out << c;
+            }
+        }
+    }
+    out << '"';
+    return out.str();
+}
+
+// JSON has no representation for inf/nan
+static string JSONNumber(double v)
+{
+    if (isnan(v) || isinf(v))
+        return "null";
+    ostringstream out;
+    out.precision(10);
+    out << v;
+    return out.str();
+}
+
+// ****************************************************************************
+//  Function:  CSVField
+//
+//  Purpose:
+//    Quotes a CSV field when it contains a separator, quote or newline.
+//
+// ****************************************************************************
+static string CSVField(const string &in)
+{
+    if (in.find_first_of(",\"\n") == string::npos)
+        return in;
+
+    string out = "\"";
+    for (size_t i=0; i<in.size(); i++)
+    {
+        if (in[i] == '"')
+            out += '"';
+        out += in[i];
+    }
+    out += '"';
+    return out;
+}
+
+// ****************************************************************************
+//  Method:  ResultDatabase::DumpJSON
+//
+//  Purpose:
+//    Writes the run metadata and every result, with summary statistics,
+//    percentiles and all trial values, as a single JSON document.  The
+//    JSON roofline report, if requested, is its "roofline" member.
+//
+//  Arguments:
+//    out         where to print
+//    roofline    include the roofline report
+//    peakSP/DP   compute ceilings in GFLOPS (<= 0: use measured)
+//    peakBW      memory ceiling in GB/s (<= 0: use measured)
+//
+//  Creation:    October 16, 2026
+//
+// ****************************************************************************
+void ResultDatabase::DumpJSON(ostream &out, bool roofline,
+                              double peakSP, double peakDP, double peakBW)
+{
+    vector<Result> sorted(results);
+
+    sort(sorted.begin(), sorted.end());
+
+    out << "{" << endl;
+    out << "  \"metadata\": {";
+    for (map<string,string>::const_iterator it = metadata.begin();
+         it != metadata.end(); ++it)
+    {
+        out << (it == metadata.begin() ? "" : ",") << endl
+            << "    " << JSONString(it->first) << ": "
+            << JSONString(it->second);
+    }
+    out << endl << "  }," << endl;
+
+    out << "  \"results\": [";
+    for (int i=0; i<sorted.size(); i++)
+    {
+        Result &r = sorted[i];
+        out << (i == 0 ? "" : ",") << endl
+            << "    {" << endl
+            << "      \"test\": "   << JSONString(r.test) << "," << endl
+            << "      \"atts\": "   << JSONString(r.atts) << "," << endl
+            << "      \"units\": "  << JSONString(r.unit) << "," << endl
+            << "      \"median\": " << JSONNumber(r.GetMedian()) << "," << endl
+            << "      \"mean\": "   << JSONNumber(r.GetMean())   << "," << endl
+            << "      \"stddev\": " << JSONNumber(r.GetStdDev()) << "," << endl
+            << "      \"min\": "    << JSONNumber(r.GetMin())    << "," << endl
+            << "      \"max\": "    << JSONNumber(r.GetMax())    << "," << endl;
+        for (int p=0; p<nPercentiles; p++)
+        {
+            out << "      \"p" << percentiles[p] << "\": "
+                << JSONNumber(r.GetPercentile(percentiles[p])) << "," << endl;
+        }
+        out << "      \"missing\": "
+            << (r.HadAnyFLTMAXValues() ? "true" : "false") << "," << endl;
+        out << "      \"rel_ci\": "
+            << (r.relCI < 0 ? string("null") : JSONNumber(r.relCI)) << ","
+            << endl;
+        out << "      \"trials\": [";
+        for (int j=0; j<r.value.size(); j++)
+        {
+            out << (j == 0 ? "" : ", ") << JSONNumber(r.value[j]);
+        }
+        out << "]" << endl
+            << "    }";
+    }
+    out << endl << "  ]";
+
+    if (roofline)
+    {
+        // The report is a document of its own; nest it one level deeper
+        ostringstream report;
+        DumpRoofline(report, true, peakSP, peakDP, peakBW);
+        istringstream lines(report.str());
+        string line;
+        out << "," << endl << "  \"roofline\": ";
+        for (bool first = true; getline(lines, line); first = false)
+        {
+            out << (first ? "" : "\n  ") << line;
+        }
+    }
+    out << endl << "}" << endl;
+}
+
+// ****************************************************************************
+//  Method:  ResultDatabase::DumpCSV
+//
+//  Purpose:
+//    Writes the results as comma-separated values, one row per result and
+//    one column per trial.  The run metadata fills one column per key,
+//    repeated on every row, so the file stays plain CSV.
+//
+//  Arguments:
+//    out        where to print
+//
+//  Creation:    October 16, 2026
+//
+// ****************************************************************************
+void ResultDatabase::DumpCSV(ostream &out)
+{
+    vector<Result> sorted(results);
+
+    sort(sorted.begin(), sorted.end());
+
+    int maxtrials = 1;
+    for (int i=0; i<sorted.size(); i++)
+    {
+        if (sorted[i].value.size() > maxtrials)
+            maxtrials = sorted[i].value.size();
+    }
+
+    out << "test,atts,units,median,mean,stddev,min,max";
+    for (int p=0; p<nPercentiles; p++)
+        out << ",p" << percentiles[p];
+    out << ",rel_ci";
+    for (map<string,string>::const_iterator it = metadata.begin();
+         it != metadata.end(); ++it)
+        out << "," << CSVField(it->first);
+    for (int i=0; i<maxtrials; i++)
+        out << ",trial" << i;
+    out << endl;
+
+    out.precision(10);
+    for (int i=0; i<sorted.size(); i++)
+    {
+        Result &r = sorted[i];
+        out << CSVField(r.test) << ","
+            << CSVField(r.atts) << ","
+            << CSVField(r.unit) << ","
+            << r.GetMedian() << ","
+            << r.GetMean()   << ","
+            << r.GetStdDev() << ","
+            << r.GetMin()    << ","
+            << r.GetMax();
+        for (int p=0; p<nPercentiles; p++)
+            out << "," << r.GetPercentile(percentiles[p]);
+        out << ",";
+        if (r.relCI >= 0)
+            out << r.relCI;
+        for (map<string,string>::const_iterator it = metadata.begin();
+             it != metadata.end(); ++it)
+            out << "," << CSVField(it->second);
+        for (int j=0; j<maxtrials; j++)
+        {
+            out << ",";
+            if (j < r.value.size())
+                out << r.value[j];
+        }
+        out << endl;
+    }
+}
+
+// ****************************************************************************
+//  Method:  ResultDatabase::DumpRoofline
+//
+//  Purpose:
+//    Places every result with declared work on the roofline.  The compute
+//    ceilings are the best MaxFlops results of each precision and the
+//    memory ceiling the best DeviceMemory bandwidth found in this database,
+//    unless given explicitly.  For each kernel the report lists its
+//    arithmetic intensity (flops per byte), the median GFLOPS achieved,
+//    the attainable GFLOPS min(peak, intensity * bandwidth), the percentage
+//    of that reached, and whether the kernel is compute or memory bound.
+//
+//  Arguments:
+//    out         where to print
+//    json        JSON document instead of a tab-separated table
+//    peakSP/DP   compute ceilings in GFLOPS (<= 0: use measured)
+//    peakBW      memory ceiling in GB/s (<= 0: use measured)
+//
+//  Creation:    October 16, 2026
+//
+// ****************************************************************************
+void ResultDatabase::DumpRoofline(ostream &out, bool json,
+                                  double peakSP, double peakDP, double peakBW)
+{
+    if (peakSP <= 0) peakSP = GetCeiling("SP");
+    if (peakDP <= 0) peakDP = GetCeiling("DP");
+    if (peakBW <= 0) peakBW = GetCeiling("BW");
+
+    vector<Result> sorted;
+    for (int i=0; i<results.size(); i++)
+    {
+        if (results[i].flops > 0 && results[i].bytes > 0)
+            sorted.push_back(results[i]);
+    }
+    sort(sorted.begin(), sorted.end());
+
+    const double nan = NAN;
+    if (json)
+    {
+        out << "{" << endl
+            << "  \"ceilings\": {" << endl
+            << "    \"SP_GFLOPS\": " << JSONNumber(peakSP > 0 ? peakSP : nan)
+            << "," << endl
+            << "    \"DP_GFLOPS\": " << JSONNumber(peakDP > 0 ? peakDP : nan)
+            << "," << endl
+            << "    \"GB_per_s\": "  << JSONNumber(peakBW > 0 ? peakBW : nan)
+            << endl
+            << "  }," << endl
+            << "  \"kernels\": [";
+    }
+    else
+    {
+        out << "Roofline: peak SP " << peakSP << " GFLOPS, peak DP "
+            << peakDP << " GFLOPS, bandwidth " << peakBW << " GB/s"
+            << " (0: not measured)" << endl
+            << "test\tatts\tprecision\tflop/byte\tGFLOPS\t"
+            << "attainable\t%roofline\tbound" << endl;
+    }
+
+    for (int i=0; i<sorted.size(); i++)
+    {
+        Result &r = sorted[i];
+        double peak = (r.precision == "DP") ? peakDP : peakSP;
+        double intensity = r.flops / r.bytes;
+        double achieved = r.GetMedian();
+
+        // Unknown ceilings leave the attainable performance undefined
+        double attainable = nan;
+        string bound = "unknown";
+        if (peak > 0 && peakBW > 0)
+        {
+            attainable = min(peak, intensity * peakBW);
+            bound = (intensity * peakBW < peak) ? "memory" : "compute";
+        }
+        double percent = 100.0 * achieved / attainable;
+
+        if (json)
+        {
+            out << (i == 0 ? "" : ",") << endl
+                << "    {" << endl
+                << "      \"test\": " << JSONString(r.test) << "," << endl
+                << "      \"atts\": " << JSONString(r.atts) << "," << endl
+                << "      \"precision\": " << JSONString(r.precision) << ","
+                << endl
+                << "      \"flops\": " << JSONNumber(r.flops) << "," << endl
+                << "      \"bytes\": " << JSONNumber(r.bytes) << "," << endl
+                << "      \"intensity\": " << JSONNumber(intensity) << ","
+                << endl
+                << "      \"gflops\": " << JSONNumber(achieved) << "," << endl
+                << "      \"attainable\": " << JSONNumber(attainable) << ","
+                << endl
+                << "      \"percent_of_roofline\": " << JSONNumber(percent)
+                << "," << endl
+                << "      \"bound\": " << JSONString(bound) << endl
+                << "    }";
+        }
+        else
+        {
+            out << r.test << "\t" << r.atts << "\t" << r.precision << "\t"
+                << intensity << "\t" << achieved << "\t";
+            if (bound == "unknown")
+                out << "-\t-\t";
+            else
+                out << attainable << "\t" << percent << "\t";
+            out << bound << endl;
+        }
+    }
+
+    if (json)
+    {
+        out << endl << "  ]" << endl
+            << "}" << endl;
+    }
+}
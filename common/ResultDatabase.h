@@ -36,9 +36,11 @@
 
 #include <cfloat>
 #include <iostream>
+#include <map>
 #include <string>
 #include <vector>
 
+using std::map;
 using std::string;
 using std::vector;
 using std::ostream;
@@ -75,11 +77,23 @@ class ResultDatabase
         string atts;  // e.g. "pagelocked 4k^2"
         string unit;  // e.g. "MB/sec"
         vector<double> value; // e.g. "837.14"
+        double relCI; // 95% CI of the median, in % of it (<0: unknown)
+
+        // Roofline annotations: work of one kernel run ("SP"/"DP"
+        // precision), or the ceiling ("SP", "DP" or "BW") a peak
+        // measurement stands for
+        double flops;
+        double bytes;
+        string precision;
+        string ceiling;
+
+        Result() : relCI(-1.0), flops(-1.0), bytes(-1.0) { }
         double GetMin();
         double GetMax();
         double GetMedian();
         double GetMean();
         double GetStdDev();
+        double GetPercentile(double q);
 
         bool operator<(const Result &rhs) const;
 
@@ -96,7 +110,17 @@ class ResultDatabase
 
     vector<Result> results;
 
+    int    FindResult(const string &test, const string &atts) const;
+    double GetCeiling(const string &kind);
+
+    // Run description (host, threads, build...) written by the
+    // machine-readable dumps
+    map<string, string> metadata;
+
   public:
+    // The one percentile definition of every report
+    static double Percentile(vector<double> values, double q);
+
     void AddResult(const string &test,
                    const string &atts,
                    const string &unit,
@@ -105,8 +129,25 @@ class ResultDatabase
                     const string &atts,
                     const string &unit,
                     const vector<double> &values);
+    void SetMetadata(const string &key, const string &value);
+    void SetWork(const string &test,
+                 const string &atts,
+                 double flops,
+                 double bytes,
+                 const string &precision);
+    void SetCeiling(const string &test,
+                    const string &atts,
+                    const string &kind);
+    void SetConfidence(const string &test,
+                       const string &atts,
+                       double relCI);
     void DumpDetailed(ostream&);
     void DumpSummary(ostream&);
+    void DumpJSON(ostream&, bool roofline = false,
+                  double peakSP = 0, double peakDP = 0, double peakBW = 0);
+    void DumpCSV(ostream&);
+    void DumpRoofline(ostream&, bool json,
+                      double peakSP, double peakDP, double peakBW);
 };
 
 
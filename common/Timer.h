@@ -33,7 +33,79 @@
 
 #ifndef _TIMER_H
 #define _TIMER_H
-// Call gettimeofday and return result in seconds
+
+#include <map>
+#include <string>
+#include <vector>
+
+using std::map;
+using std::string;
+using std::vector;
+
+// Monotonic clock (CLOCK_MONOTONIC_RAW) in seconds; callable in offload
+// regions
 double curr_second (void);
-#endif
 
+// Resolution of curr_second, and the calibrated cost of one back-to-back
+// pair of calls (subtracted by RegionTimer), both in seconds
+double TimerResolution (void);
+double TimerOverhead (void);
+
+// ****************************************************************************
+// Class:  RegionTimer
+//
+// Purpose:
+//   Times named regions of host code and keeps every sample, so a benchmark
+//   can repeat a short operation and report the minimum or median instead
+//   of a single noisy measurement.  The calibrated timer overhead is
+//   removed from each sample.
+//
+// Creation:    October 16, 2026
+//
+// ****************************************************************************
+class RegionTimer
+{
+  private:
+    map<string, double>          started;
+    map<string, vector<double> > samples;
+
+  public:
+    void   Start(const string &region);
+    double Stop(const string &region);
+    void   Add(const string &region, double seconds);
+    void   Clear(const string &region);
+
+    int    Count(const string &region) const;
+    double Last(const string &region) const;
+    double Min(const string &region) const;
+    double Median(const string &region) const;
+    vector<double> Samples(const string &region) const;
+};
+
+// ****************************************************************************
+// Class:  ScopedRegion
+//
+// Purpose:
+//   Times the enclosing block as one sample of a RegionTimer region.
+//
+// Creation:    October 16, 2026
+//
+// ****************************************************************************
+class ScopedRegion
+{
+  private:
+    RegionTimer &timer;
+    string       region;
+
+  public:
+    ScopedRegion(RegionTimer &t, const string &r) : timer(t), region(r)
+    {
+        timer.Start(region);
+    }
+    ~ScopedRegion()
+    {
+        timer.Stop(region);
+    }
+};
+
+#endif
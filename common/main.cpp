@@ -50,6 +50,9 @@
 #include "omp.h"
 
 #include "offload.h"
+#include "Backend.h"
+#include "Benchmark.h"
+#include "CommonOptions.h"
 #include "Timer.h"
 
 #include "OptionParser.h"
@@ -62,22 +65,22 @@
 // #include <pthread_affinity_np.h>
 #endif
 
-
-// Forward Declarations
-void addBenchmarkSpecOptions(OptionParser &op);
-void RunBenchmark(OptionParser &op, ResultDatabase& resultDB);
-
 int main(int argc, char **argv)
 {
+  // The one benchmark linked with this main()
+  if (RegisteredBenchmarks().size() != 1)
+  {
+     cerr << "Error: expected one benchmark, found "
+          << RegisteredBenchmarks().size() << endl;
+     return -1;
+  }
+  const Benchmark &bench = RegisteredBenchmarks()[0];
 
 	OptionParser op;
-  op.addOption("verbose", OPT_BOOL, "", "enable verbose output", 'v');
-  op.addOption("passes", OPT_INT, "10", "specify number of passes", 'n');
-  op.addOption("size", OPT_INT, "1", "specify problem size", 's');
-  op.addOption("target", OPT_INT, "0", "specify MIC target device number", 't');
+  AddCommonOptions(op);
   
   // If benchmark has any specific options, add those
-  addBenchmarkSpecOptions(op);
+  bench.addOptions(op);
   
   if (!op.parse(argc, argv))
   {
@@ -85,13 +88,27 @@ int main(int argc, char **argv)
      return -1;
   }
 
+  if (!CheckCommonOptions(op))
+  {
+     return -1;
+  }
+
+  if (op.getOptionBool("verbose"))
+  {
+     cout << "Using " << BackendName(op) << " backend" << endl;
+  }
+
   ResultDatabase resultDB;
+  RecordMetadata(argc, argv, op, resultDB);
+
   // Run the test
-  RunBenchmark(op, resultDB);
+  bench.run(op, resultDB);
 
-  // Print out results to stdout
-  resultDB.DumpDetailed(cout);
+  // Print out results to stdout, or to the requested file
+  if (!DumpResults(op, resultDB))
+  {
+     return -1;
+  }
 
 	return 0;
 }
-
@@ -37,21 +37,17 @@
 #include <cassert>
 #include <iostream>
 #include <fstream>
+#include "Backend.h"
 #include "OptionParser.h"
 #include "ResultDatabase.h"
 #include <stdlib.h>
 
 // Constants
 #define ALIGN 4096
-#define DONT_USE_MM_MALLOC
 
-#ifdef USE_MM_MALLOC
-#define ALLOC(t,s) (t *)_mm_malloc((s)*sizeof(t), ALIGN)
-#define FREE(p) _mm_free(p)
-#else
-#define ALLOC(t,s) new t[s]
-#define FREE(p) delete[] p
-#endif
+// Host buffers come from the backend, so they can be mirrored on the card
+#define ALLOC(t,s) (t *)BackendAlloc((s)*sizeof(t), ALIGN)
+#define FREE(p) BackendFree(p)
 
 // threshold for error in GPU results
 static const double MAX_RELATIVE_ERROR = .02;
@@ -240,9 +236,9 @@ void readMatrix(char *filename, floatType **val_ptr, int **cols_ptr,
     // create CSR data structures
     *n = nElements; 
     *size = nRows; 
-    *val_ptr = new floatType[nElements]; 
-    *cols_ptr = new int[nElements];
-    *rowDelimiters_ptr = new int[nRows+1]; 
+    *val_ptr = ALLOC(floatType, nElements);
+    *cols_ptr = ALLOC(int, nElements);
+    *rowDelimiters_ptr = ALLOC(int, nRows+1);
 
     floatType *val = *val_ptr; 
     int *cols = *cols_ptr; 
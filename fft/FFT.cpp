@@ -32,33 +32,86 @@
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
 // THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
 #include <math.h>
 #include <sstream>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef HAVE_MKL
 #include "mkl.h"
+#endif
 
 #include "fftlib.h"
+#include "Backend.h"
+#include "Measurement.h"
 #include "OptionParser.h"
 #include "ResultDatabase.h"
+#include "Benchmark.h"
 #include "Timer.h"
 
 using namespace std;
 
+// MKL is optional: without HAVE_MKL only the in-tree FFT is built
+#ifdef HAVE_MKL
+#define FFT_DEFAULT_IMPL "mkl"
+#else
+#define FFT_DEFAULT_IMPL "native"
+#endif
+
 // Forward Declarations
 template <class T2>
-void RunTest(const string& name,
-    ResultDatabase &resultDb, OptionParser &op);
+static void RunTest(const string& name,
+    ResultDatabase &resultDb, OptionParser &op, bool native);
+
+// One point of the size sweep: dims sides of n points each
+struct FFTSweepPoint
+{
+    int dims;
+    int n;
+};
+
+vector<FFTSweepPoint> SweepPoints(int dims);
+
+// Data layouts of the size sweep
+enum FFTMode
+{
+    FFT_C2C,        // complex, in place
+    FFT_C2C_OOP,    // complex, out of place
+    FFT_R2C         // real to complex forward, complex to real inverse,
+                    // out of place
+};
+
+template <class T2>
+void RunSweep(const string& name, ResultDatabase &resultDB,
+    OptionParser &op, const vector<FFTSweepPoint> &points, bool native,
+    FFTMode mode);
+
+template <class T2>
+void RunConvolution(const string& name, ResultDatabase &resultDB,
+    OptionParser &op, bool native);
 
-void
+static void
 addBenchmarkSpecOptions(OptionParser &op)
 {
     op.addOption("MB", OPT_INT, "0", "data size (in MiB)");
+    op.addOption("impl", OPT_VECSTRING, FFT_DEFAULT_IMPL,
+                 "FFT implementations to run (native, mkl)");
+    op.addOption("sweep", OPT_BOOL, "",
+                 "sweep transform sizes instead of the 512-point batch");
+    op.addOption("sweep-dims", OPT_VECSTRING, "1,2,3",
+                 "dimensionalities in the size sweep (1, 2, 3)");
+    op.addOption("sweep-modes", OPT_VECSTRING, "c2c",
+                 "data layouts in the size sweep (c2c, c2c-oop, r2c)");
+    op.addOption("conv", OPT_BOOL, "",
+                 "time FFT convolution, fused per chunk and unfused");
+    op.addOption("conv-chunk", OPT_INT, "256",
+                 "data per chunk of the fused convolution (in KiB)");
 }
 
 template <typename T2>
+__declspec(target(mic))
 void init(T2 *source, int fftsz, int n_ffts)
 {
 #pragma omp parallel for
@@ -70,6 +123,19 @@ void init(T2 *source, int fftsz, int n_ffts)
     }
 }
 
+// Real input of the real transforms: the real parts of init
+template <typename T>
+__declspec(target(mic))
+void initReal(T *source, int fftsz, int n_ffts)
+{
+#pragma omp parallel for
+    for (int m = 0; m < n_ffts; ++m)
+    for (int n = 0; n < fftsz;  ++n)
+    {
+        source[n + fftsz*m] = cos((1.0+m)/fftsz * n);
+    }
+}
+
 template <class T2>
 __declspec(target(mic))
 int checkDiff(T2 *source, int fftsz, int n_ffts)
@@ -99,16 +165,34 @@ int checkDiff(T2 *source, int fftsz, int n_ffts)
     return diff;
 }
 
-template <class T2>
-void RunTest(const string& name, ResultDatabase &resultDB, OptionParser &op)
+template <class T>
+__declspec(target(mic))
+int checkDiffReal(T *source, int fftsz, int n_ffts)
 {
-    static __declspec(target(mic)) T2 *source;
-    int chk;
-    unsigned long bytes = 0;
-    const int micdev = op.getOptionInt("target");
-    const bool verbose = op.getOptionBool("verbose");
-    
-    // Get problem size
+    int diff = 0;
+#pragma omp parallel for shared(source, diff)
+    for (int m = 0; m < n_ffts; ++m)
+    for (int n = 0; n < fftsz;  ++n)
+    {
+        const double exd = fftsz * cos((1.0+m)/fftsz * n);
+        const double got = source[n + fftsz*m];
+        if ( !(fabs(got - exd) < 1e-6 * fftsz) )
+        {
+            if (diff == 0)
+            {
+                printf("[%i,%i] expected %lg got %lg\n", n, m, exd, got);
+            }
+            diff = 1;
+            break;
+        }
+    }
+    return diff;
+}
+
+// Bytes of data per test: "-s [1-4]" picks a predefined size, "--MB" sets it
+unsigned long DataBytes(OptionParser &op)
+{
+    unsigned long bytes;
     if (op.getOptionInt("MB") == 0) {
         int probSizes[4] = { 1, 8, 96, 256 };
         int sizeIndex = op.getOptionInt("size")-1;
@@ -121,7 +205,23 @@ void RunTest(const string& name, ResultDatabase &resultDB, OptionParser &op)
         bytes = op.getOptionInt("MB");
     }
     // Convert to MiB
-    bytes *= 1024 * 1024;
+    return bytes * 1024 * 1024;
+}
+
+template <class T2>
+static void
+RunTest(const string& name, ResultDatabase &resultDB, OptionParser &op,
+    bool native)
+{
+    static __declspec(target(mic)) T2 *source;
+    int chk;
+    unsigned long bytes = 0;
+    const int micdev = op.getOptionInt("target");
+    const bool useMIC = UseOffload(op);
+    const bool verbose = op.getOptionBool("verbose");
+    
+    // Get problem size
+    bytes = DataBytes(op);
 
     int passes = op.getOptionInt("passes");
 
@@ -131,15 +231,16 @@ void RunTest(const string& name, ResultDatabase &resultDB, OptionParser &op)
     int n_ffts = N/fftsz;
 
     // Allocate space (aligned)
-    source = (T2*) MKL_malloc(bytes,  4096);
+    source = (T2*) BackendAlloc(bytes,  4096);
 
     //allocate buffers and create FFT plans
-    #pragma offload target(mic:micdev) in(fftsz, n_ffts)       \
-                                       nocopy(source:length(N) \
-                                       align(4096) alloc_if(1) free_if(0))
+    BackendCreate(op, source, bytes);
+    double planTime[2];
+    #pragma offload target(mic:micdev) if(useMIC) in(fftsz, n_ffts, native) \
+                                       out(planTime)
     {
-        forward((T2*)NULL, fftsz, n_ffts);
-        inverse((T2*)NULL, fftsz, n_ffts);
+        planTime[0] = forward((T2*)NULL, fftsz, n_ffts, 1, native);
+        planTime[1] = inverse((T2*)NULL, fftsz, n_ffts, 1, native);
     }
 
     const char *sizeStr;
@@ -147,17 +248,27 @@ void RunTest(const string& name, ResultDatabase &resultDB, OptionParser &op)
     ss << "N=" << (long)N;
     sizeStr = strdup(ss.str().c_str());
 
+    // Plans are created once and reused by every pass
+    resultDB.AddResult(name+"_Plan", sizeStr, "ms", planTime[0] * 1e3);
+    resultDB.AddResult(name+"-INV_Plan", sizeStr, "ms", planTime[1] * 1e3);
+
     for(int k = 0; k < passes; k++)
     {
         init<T2>( source, fftsz, n_ffts );
         // Warmup
         if (k==0)
         {
-            #pragma offload target(mic:micdev) in(fftsz, n_ffts)   \
-                                               in(source:length(N) \
-                                               alloc_if(0)  free_if(0))
+            BackendCopyIn(op, source, bytes);
+            #pragma offload target(mic:micdev) if(useMIC) \
+                                    in(fftsz, n_ffts, native) nocopy(source)
             {
-                forward(source, fftsz, n_ffts);
+                forward(source, fftsz, n_ffts, 1, native);
+            }
+
+            // Without a card the warmup transformed the input itself
+            if (!useMIC)
+            {
+                init<T2>( source, fftsz, n_ffts );
             }
         }
 
@@ -165,34 +276,28 @@ void RunTest(const string& name, ResultDatabase &resultDB, OptionParser &op)
         double time_fwd_pcie = -curr_second();
         
         // Using in rather than inout to be consistent with CUDA version.
-        #pragma offload target(mic:micdev) in(fftsz, n_ffts)               \
-                                           in(source:length(N) alloc_if(0) \
-                                           free_if(0))
+        BackendCopyIn(op, source, bytes);
+        #pragma offload target(mic:micdev) if(useMIC) \
+                                in(fftsz, n_ffts, native) nocopy(source)
         {
-            forward(source, fftsz, n_ffts);
+            forward(source, fftsz, n_ffts, 1, native);
         }
         time_fwd_pcie += curr_second();
-        #pragma offload target(mic:micdev) out(source:length(N) alloc_if(0) \
-                free_if(0))
-        {
-        }
+        BackendCopyOut(op, source, bytes);
 
         // Time inverse fft with data transfer over PCIe
         double time_inv_pcie = -curr_second();
-        #pragma offload target(mic:micdev) in(fftsz, n_ffts)   \
-                                           in(source:length(N) \
-                                           alloc_if(0)  free_if(0))
+        BackendCopyIn(op, source, bytes);
+        #pragma offload target(mic:micdev) if(useMIC) \
+                                in(fftsz, n_ffts, native) nocopy(source)
         {
-            inverse(source, fftsz, n_ffts);
+            inverse(source, fftsz, n_ffts, 1, native);
         }
         time_inv_pcie += curr_second();
-
-        #pragma offload target(mic:micdev) out(source:length(N) alloc_if(0) \
-            free_if(0))
-        {}
+        BackendCopyOut(op, source, bytes);
 
         // Check result
-        #pragma offload target(mic:micdev) in(fftsz,n_ffts) nocopy(source) \
+        #pragma offload target(mic:micdev) if(useMIC) in(fftsz,n_ffts) nocopy(source) \
             out(chk)
         {
             chk = checkDiff(source, fftsz, n_ffts);
@@ -204,17 +309,17 @@ void RunTest(const string& name, ResultDatabase &resultDB, OptionParser &op)
 
         // Time forward fft without data transfer
         double time_fwd_native = -curr_second();
-        #pragma offload target(mic:micdev) in(fftsz, n_ffts) nocopy(source)
+        #pragma offload target(mic:micdev) if(useMIC) in(fftsz, n_ffts, native) nocopy(source)
         {
-            forward(source, fftsz, n_ffts);
+            forward(source, fftsz, n_ffts, 1, native);
         }
         time_fwd_native += curr_second();
 
         // Time inverse fft without data transfer
         double time_inv_native = -curr_second();
-        #pragma offload target(mic:micdev) in(fftsz, n_ffts) nocopy(source)
+        #pragma offload target(mic:micdev) if(useMIC) in(fftsz, n_ffts, native) nocopy(source)
         {
-            inverse(source, fftsz, n_ffts);
+            inverse(source, fftsz, n_ffts, 1, native);
         }
         time_inv_native += curr_second();
 
@@ -236,23 +341,40 @@ void RunTest(const string& name, ResultDatabase &resultDB, OptionParser &op)
                 (time_inv_pcie - time_inv_native) / time_inv_native);
     }
 
-    // Cleanup FFT plans and buffers
-    #pragma offload target(mic:micdev) nocopy(source:length(N) \
-            alloc_if(0) free_if(1))
+    // Cleanup FFT plans (all of them are cached together) and buffers
+    #pragma offload target(mic:micdev) if(useMIC)
     {
         forward((T2*)NULL, 0, 0);
-        inverse((T2*)NULL, 0, 0);
     }
-    MKL_free(source);
+    BackendRelease(op, source, bytes);
+    BackendFree(source);
 }
 
 
-void
+static void
 RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
 {
-    const bool verbose = op.getOptionBool("verbose");
+    vector<string> impls = op.getOptionVecString("impl");
+    for (size_t i = 0; i < impls.size(); i++)
+    {
+        if (impls[i] != "native" && impls[i] != "mkl")
+        {
+            cerr << "Error: unknown FFT implementation \"" << impls[i]
+                 << "\"\n";
+            return;
+        }
+#ifndef HAVE_MKL
+        if (impls[i] == "mkl")
+        {
+            cerr << "Error: this build has no MKL (build with MKL=1), "
+                 << "use --impl native\n";
+            return;
+        }
+#endif
+    }
 
-    if (verbose) // print MKL version info
+#ifdef HAVE_MKL
+    if (op.getOptionBool("verbose")) // print MKL version info
     {
         static char mklver[200];
         char *p;
@@ -262,8 +384,693 @@ RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
         if (p) while (p[0]==' ' && p[1]==0) *p-- = 0;
         printf("SHOC FFT benchmark using MKL verison %s\n",mklver);
     }
-    RunTest<cplxflt>("SP-FFT", resultDB, op);
-    RunTest<cplxdbl>("DP-FFT", resultDB, op);
+#endif
+
+    if (op.getOptionBool("sweep"))
+    {
+        vector<FFTSweepPoint> points;
+        vector<string> dims = op.getOptionVecString("sweep-dims");
+        for (size_t i = 0; i < dims.size(); i++)
+        {
+            if (dims[i] != "1" && dims[i] != "2" && dims[i] != "3")
+            {
+                cerr << "Error: unknown sweep dimensionality \"" << dims[i]
+                     << "\"\n";
+                return;
+            }
+            vector<FFTSweepPoint> add = SweepPoints(atoi(dims[i].c_str()));
+            points.insert(points.end(), add.begin(), add.end());
+        }
+        vector<string> modeNames = op.getOptionVecString("sweep-modes");
+        vector<FFTMode> modes;
+        for (size_t i = 0; i < modeNames.size(); i++)
+        {
+            if (modeNames[i] == "c2c")
+                modes.push_back(FFT_C2C);
+            else if (modeNames[i] == "c2c-oop")
+                modes.push_back(FFT_C2C_OOP);
+            else if (modeNames[i] == "r2c")
+                modes.push_back(FFT_R2C);
+            else
+            {
+                cerr << "Error: unknown sweep mode \"" << modeNames[i]
+                     << "\"\n";
+                return;
+            }
+        }
+        for (size_t i = 0; i < impls.size(); i++)
+        {
+            const bool native = impls[i] == "native";
+            const string suffix = native ? "_Native" : "";
+            for (size_t m = 0; m < modes.size(); m++)
+            {
+                // The native FFT is complex only
+                if (native && modes[m] == FFT_R2C)
+                {
+                    continue;
+                }
+                RunSweep<cplxflt>("SP-FFT" + suffix, resultDB, op, points,
+                                  native, modes[m]);
+                RunSweep<cplxdbl>("DP-FFT" + suffix, resultDB, op, points,
+                                  native, modes[m]);
+            }
+        }
+        return;
+    }
+
+    if (op.getOptionBool("conv"))
+    {
+        for (size_t i = 0; i < impls.size(); i++)
+        {
+            const bool native = impls[i] == "native";
+            const string suffix = native ? "_Native" : "";
+            RunConvolution<cplxflt>("SP-FFT" + suffix, resultDB, op,
+                                    native);
+            RunConvolution<cplxdbl>("DP-FFT" + suffix, resultDB, op,
+                                    native);
+        }
+        return;
+    }
+
+    // MKL keeps the original test names
+    for (size_t i = 0; i < impls.size(); i++)
+    {
+        const bool native = impls[i] == "native";
+        const string suffix = native ? "_Native" : "";
+        RunTest<cplxflt>("SP-FFT" + suffix, resultDB, op, native);
+        RunTest<cplxdbl>("DP-FFT" + suffix, resultDB, op, native);
+    }
+}
+
+// ****************************************************************************
+// Function: SweepPoints
+//
+// Purpose:
+//   Sizes of the sweep in one dimensionality: every power of two in range,
+//   then composite and prime sides, which take MKL off its radix-2 paths.
+//   1-D runs from 16 to 2^22 points, 2-D up to 4096 x 4096 and 3-D up to
+//   256^3.
+//
+// Arguments:
+//   dims: 1, 2 or 3
+//
+// Returns:  the points, in ascending size
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+vector<FFTSweepPoint> SweepPoints(int dims)
+{
+    static const int minLog[3] = { 4, 4, 3 };
+    static const int maxLog[3] = { 22, 12, 8 };
+    static const int extra1[] = { 17, 100, 127, 1000, 1021, 6561, 8191,
+                                  10000, 65521, 100000, 1000000 };
+    static const int extra2[] = { 100, 127, 1000, 1021 };
+    static const int extra3[] = { 31, 60, 100, 127 };
+
+    vector<int> sides;
+    for (int l = minLog[dims - 1]; l <= maxLog[dims - 1]; l++)
+    {
+        sides.push_back(1 << l);
+    }
+    if (dims == 1)
+        sides.insert(sides.end(), extra1, extra1 + 11);
+    else if (dims == 2)
+        sides.insert(sides.end(), extra2, extra2 + 4);
+    else
+        sides.insert(sides.end(), extra3, extra3 + 4);
+    sort(sides.begin(), sides.end());
+
+    vector<FFTSweepPoint> points;
+    for (size_t i = 0; i < sides.size(); i++)
+    {
+        FFTSweepPoint p = { dims, sides[i] };
+        points.push_back(p);
+    }
+    return points;
+}
+
+// ****************************************************************************
+// Function: SweepFFT
+//
+// Purpose:
+//   One batch of forward or inverse transforms of the size sweep, in the
+//   sweep's data layout, on the target.  The complex transforms read
+//   source; in place they write it back, out of place they write dest and
+//   their inverses go from dest to source.  The real forward transforms go
+//   from real to dest, and their inverses from dest to real.
+//
+// Arguments:
+//   mode: the data layout
+//   inv: inverse instead of forward transforms
+//   source, dest, real: the buffers the layout uses, or all NULL to only
+//                       create the plan
+//   fftsz, n_ffts, dims: fftsz points on each of dims sides, n_ffts times
+//   native: use the in-tree FFT instead of MKL
+//
+// Returns:  seconds spent creating the plan, 0 if it was cached
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T2>
+__declspec(target(mic))
+double SweepFFT(int mode, bool inv, T2 *source, T2 *dest,
+    typename fftReal<T2>::type *real, int fftsz, int n_ffts, int dims,
+    bool native)
+{
+    if (mode == FFT_C2C_OOP)
+        return inv ? inverseOutOfPlace(dest, source, fftsz, n_ffts, dims,
+                                       native)
+                   : forwardOutOfPlace(source, dest, fftsz, n_ffts, dims,
+                                       native);
+    if (mode == FFT_R2C)
+        return inv ? inverseReal(dest, real, fftsz, n_ffts, dims)
+                   : forwardReal<T2>(real, dest, fftsz, n_ffts, dims);
+    return inv ? inverse(source, fftsz, n_ffts, dims, native)
+               : forward(source, fftsz, n_ffts, dims, native);
+}
+
+// Fresh input for the forward transforms of a sweep mode, on the target
+template <class T2>
+__declspec(target(mic))
+void SweepInit(int mode, T2 *source, typename fftReal<T2>::type *real,
+    int size, int n_ffts)
+{
+    if (mode == FFT_R2C)
+        initReal(real, size, n_ffts);
+    else
+        init<T2>(source, size, n_ffts);
+}
+
+// ****************************************************************************
+// Function: RunSweep
+//
+// Purpose:
+//   Times batched forward and inverse transforms over a list of sizes, with
+//   the data resident on the target.  Each batch fills the data size of the
+//   main test ("-s", "--MB") with complex points, or holds one transform if
+//   that is larger; every layout runs the same batches, so its results line
+//   up with the in-place complex ones.  GFLOPS counts the nominal 5 N
+//   log2(N) flops of an N-point complex transform and half that for a real
+//   one, so non-power-of-two sizes compare on the same scale.  Bandwidth
+//   counts reading the input and writing the output once.  A round trip of
+//   every size is checked first.  Plan creation is timed on its own.  The
+//   native FFT skips the sizes it does not support.
+//
+// Arguments:
+//   name: SP-FFT or DP-FFT, with the implementation suffix
+//   resultDB: the benchmark stores its results in this ResultDatabase
+//   op: the options parser / parameter database
+//   points: the sizes to run
+//   native: run the in-tree FFT instead of MKL
+//   mode: the data layout
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T2>
+void RunSweep(const string& name, ResultDatabase &resultDB,
+    OptionParser &op, const vector<FFTSweepPoint> &points, bool native,
+    FFTMode mode)
+{
+    typedef typename fftReal<T2>::type T;
+    static __declspec(target(mic)) T2 *source;
+    static __declspec(target(mic)) T2 *dest;
+    static __declspec(target(mic)) T *real;
+    const int micdev = op.getOptionInt("target");
+    const bool useMIC = UseOffload(op);
+    const bool verbose = op.getOptionBool("verbose");
+    const unsigned long bytes = DataBytes(op);
+
+    // Test names of the forward and the inverse transforms
+    static const char *tags[3][2] = { { "", "-INV" },
+                                      { "_OOP", "_OOP-INV" },
+                                      { "_R2C", "_C2R" } };
+    const string tests[2] = { name + tags[mode][0], name + tags[mode][1] };
+
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        const int dims = points[i].dims;
+        const int fftsz = points[i].n;
+        if (native && !NativeFFTSupports(fftsz))
+        {
+            continue;
+        }
+        int size = 1;
+        for (int d = 0; d < dims; d++)
+        {
+            size *= fftsz;
+        }
+        const int n_ffts = max(1, (int)(bytes / sizeof(T2) / size));
+        const int N = size * n_ffts;
+
+        // The complex side of a real transform stores half its last
+        // dimension, plus one point
+        const int half = size / fftsz * (fftsz / 2 + 1);
+        const int nSource = mode == FFT_R2C ? 0 : N;
+        const int nDest = mode == FFT_C2C ? 0
+                        : mode == FFT_R2C ? half * n_ffts : N;
+        const int nReal = mode == FFT_R2C ? N : 0;
+
+        char atts[64];
+        if (dims == 1)
+            sprintf(atts, "%d Batch:%d", fftsz, n_ffts);
+        else if (dims == 2)
+            sprintf(atts, "%dx%d Batch:%d", fftsz, fftsz, n_ffts);
+        else
+            sprintf(atts, "%dx%dx%d Batch:%d", fftsz, fftsz, fftsz, n_ffts);
+
+        const size_t sourceBytes = (size_t)nSource * sizeof(T2);
+        const size_t destBytes = (size_t)nDest * sizeof(T2);
+        const size_t realBytes = (size_t)nReal * sizeof(T);
+        source = nSource ? (T2*) BackendAlloc(sourceBytes, 4096) : NULL;
+        dest = nDest ? (T2*) BackendAlloc(destBytes, 4096) : NULL;
+        real = nReal ? (T*) BackendAlloc(realBytes, 4096) : NULL;
+        if ((nSource && !source) || (nDest && !dest) || (nReal && !real))
+        {
+            cerr << "memory allocation failed" << endl;
+            BackendFree(source);
+            BackendFree(dest);
+            BackendFree(real);
+            return;
+        }
+
+        // Buffers a layout does not use are NULL and of length 0
+        BackendCreate(op, source, sourceBytes);
+        BackendCreate(op, dest, destBytes);
+        BackendCreate(op, real, realBytes);
+
+        double planTime[2];
+        #pragma offload target(mic:micdev) if(useMIC) \
+            in(mode, fftsz, n_ffts, dims, native) out(planTime)
+        {
+            for (int inv = 0; inv < 2; inv++)
+            {
+                planTime[inv] = SweepFFT<T2>(mode, inv, NULL, NULL, NULL,
+                                             fftsz, n_ffts, dims, native);
+            }
+        }
+        for (int inv = 0; inv < 2; inv++)
+        {
+            resultDB.AddResult(tests[inv] + "_Plan", atts, "ms",
+                    planTime[inv] * 1e3);
+        }
+
+        // Check a round trip, which also warms up both plans
+        int chk;
+        #pragma offload target(mic:micdev) if(useMIC) \
+            in(mode, fftsz, size, n_ffts, dims, native) \
+            nocopy(source, dest, real) out(chk)
+        {
+            SweepInit<T2>(mode, source, real, size, n_ffts);
+            SweepFFT<T2>(mode, false, source, dest, real, fftsz, n_ffts,
+                         dims, native);
+            SweepFFT<T2>(mode, true, source, dest, real, fftsz, n_ffts,
+                         dims, native);
+            chk = mode == FFT_R2C ? checkDiffReal(real, size, n_ffts)
+                                  : checkDiff(source, size, n_ffts);
+        }
+        if (verbose || chk)
+        {
+            cout << "Test " << tests[0] << " " << atts
+                 << ((chk) ? ": Failed\n" : ": Passed\n");
+        }
+
+        const string regions[2] = { tests[0] + "_Sweep " + atts,
+                                    tests[1] + "_Sweep " + atts };
+        Measurement meas(op);
+        while (!meas.Finished())
+        {
+            for (int inv = 0; inv < 2; inv++)
+            {
+                if (meas.Done(regions[inv]))
+                {
+                    continue;
+                }
+
+                // Fresh data, so repeated transforms cannot overflow.  Out
+                // of place, the inverse reads what a forward transform of
+                // it wrote.
+                #pragma offload target(mic:micdev) if(useMIC) \
+                    in(mode, inv, fftsz, size, n_ffts, dims, native) \
+                    nocopy(source, dest, real)
+                {
+                    SweepInit<T2>(mode, source, real, size, n_ffts);
+                    if (inv && mode != FFT_C2C)
+                        SweepFFT<T2>(mode, false, source, dest, real, fftsz,
+                                     n_ffts, dims, native);
+                }
+
+                meas.Start(regions[inv]);
+                #pragma offload target(mic:micdev) if(useMIC) \
+                    in(mode, inv, fftsz, n_ffts, dims, native) \
+                    nocopy(source, dest, real)
+                {
+                    SweepFFT<T2>(mode, inv, source, dest, real, fftsz,
+                                 n_ffts, dims, native);
+                }
+                meas.Stop(regions[inv]);
+            }
+        }
+
+        // Real transforms do half the flops of complex ones, and move N
+        // reals one way and the half spectrum the other
+        const double flop_count = (double)n_ffts * 5 * size * log2(size) *
+                                  (mode == FFT_R2C ? 0.5 : 1.);
+        const double byte_count = mode == FFT_R2C
+            ? (double)n_ffts * (size * sizeof(T) + half * sizeof(T2))
+            : 2. * N * sizeof(T2);
+        for (int inv = 0; inv < 2; inv++)
+        {
+            vector<double> times = meas.Samples(regions[inv]);
+            for (size_t j = 0; j < times.size(); j++)
+            {
+                resultDB.AddResult(tests[inv] + "_Sweep", atts, "GFLOPS",
+                        flop_count / (times[j] * 1e9));
+                resultDB.AddResult(tests[inv] + "-Bandwidth_Sweep", atts,
+                        "GB/s", byte_count / (times[j] * 1e9));
+            }
+            meas.RecordConfidence(resultDB, regions[inv],
+                    tests[inv] + "_Sweep", atts);
+        }
+
+        // The plans stay cached; the least recently used make way for new
+        // sizes
+        BackendRelease(op, source, sourceBytes);
+        BackendRelease(op, dest, destBytes);
+        BackendRelease(op, real, realBytes);
+        BackendFree(source);
+        BackendFree(dest);
+        BackendFree(real);
+    }
+
+    #pragma offload target(mic:micdev) if(useMIC)
+    {
+        forward((T2*)NULL, 0, 0);
+    }
+}
+
+// Taps of the convolution kernel, h[k] = 2^-(k+1)
+#define CONV_TAPS 4
+
+// ****************************************************************************
+// Function: initFilter
+//
+// Purpose:
+//   Computes the spectrum of the convolution kernel, scaled by 1 / fftsz so
+//   a forward transform, a product with it and an inverse transform
+//   convolve without changing the scale.
+//
+// Arguments:
+//   filter: fftsz complex points
+//   fftsz: transform size
+//   native: transform with the in-tree FFT instead of MKL
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T2>
+__declspec(target(mic))
+void initFilter(T2 *filter, int fftsz, bool native)
+{
+    for (int n = 0; n < fftsz; ++n)
+    {
+        filter[n].x = n < CONV_TAPS ? 1.0 / (2 << n) : 0.0;
+        filter[n].y = 0;
+    }
+    forward(filter, fftsz, 1, 1, native);
+    for (int n = 0; n < fftsz; ++n)
+    {
+        filter[n].x /= fftsz;
+        filter[n].y /= fftsz;
+    }
+}
+
+// Multiplies count spectra of fftsz points by the filter, point by point
+template <class T2>
+__declspec(target(mic))
+void multiplySpectra(T2 *data, const T2 *filter, int fftsz, int count)
+{
+    for (int m = 0; m < count; ++m)
+    {
+        T2 *d = data + (size_t)m * fftsz;
+        for (int n = 0; n < fftsz; ++n)
+        {
+            const T2 a = d[n];
+            d[n].x = a.x * filter[n].x - a.y * filter[n].y;
+            d[n].y = a.x * filter[n].y + a.y * filter[n].x;
+        }
+    }
+}
+
+// Compares the convolution of the data of init with the kernel to the
+// circular convolution summed directly
+template <class T2>
+__declspec(target(mic))
+int checkConvolution(T2 *source, int fftsz, int n_ffts)
+{
+    int diff = 0;
+#pragma omp parallel for shared(source, diff)
+    for (int m = 0; m < n_ffts; ++m)
+    for (int n = 0; n < fftsz;  ++n)
+    {
+        double exd_x = 0, exd_y = 0;
+        for (int k = 0; k < CONV_TAPS; ++k)
+        {
+            const int j = (n - k + fftsz) % fftsz;
+            exd_x += cos((1.0+m)/fftsz * j) / (2 << k);
+            exd_y += sin((1.0+m)/fftsz * j) / (2 << k);
+        }
+        const T2 got = source[n + fftsz*m];
+        if ( !(fabs(got.x - exd_x) < 1e-4 && fabs(got.y - exd_y) < 1e-4) )
+        {
+            if (diff == 0)
+            {
+                printf("[%i,%i] expected (%lg,%lg) got (%lg,%lg)\n",
+                       n,m,exd_x,exd_y,got.x,got.y);
+            }
+            diff = 1;
+            break;
+        }
+    }
+    return diff;
+}
+
+// ****************************************************************************
+// Function: convolveFused
+//
+// Purpose:
+//   Convolves a batch with the filter a chunk at a time: each thread takes
+//   chunks of the batch and runs the forward transforms, the product with
+//   the filter and the inverse transforms of one chunk before it moves on,
+//   so the chunk stays in that core's cache.  The transforms of a chunk
+//   run on the thread that owns it.
+//
+// Arguments:
+//   source: n_ffts transforms of fftsz points
+//   filter: the spectrum of initFilter
+//   fftsz, n_ffts: transform size and count
+//   chunk: transforms per chunk; the last chunk may be smaller
+//   native: use the in-tree FFT instead of MKL
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T2>
+__declspec(target(mic))
+void convolveFused(T2 *source, const T2 *filter, int fftsz, int n_ffts,
+    int chunk, bool native)
+{
+    const int chunks = (n_ffts + chunk - 1) / chunk;
+    const int tail = n_ffts - (chunks - 1) * chunk;
+
+    // Plans for the full chunks and for the last one
+    const fftPlan *fwd[2], *inv[2];
+    fwd[0] = threadPlan<T2>(fftsz, chunk, 1, native, false);
+    inv[0] = threadPlan<T2>(fftsz, chunk, 1, native, true);
+    fwd[1] = threadPlan<T2>(fftsz, tail, 1, native, false);
+    inv[1] = threadPlan<T2>(fftsz, tail, 1, native, true);
+
+#pragma omp parallel for schedule(static)
+    for (int c = 0; c < chunks; ++c)
+    {
+        const int last = c == chunks - 1;
+        T2 *data = source + (size_t)c * chunk * fftsz;
+        runPlan<T2>(fwd[last], data, data);
+        multiplySpectra(data, filter, fftsz, last ? tail : chunk);
+        runPlan<T2>(inv[last], data, data);
+    }
+}
+
+// Convolves a batch with the filter in three passes over all of it
+template <class T2>
+__declspec(target(mic))
+void convolveUnfused(T2 *source, const T2 *filter, int fftsz, int n_ffts,
+    bool native)
+{
+    forward(source, fftsz, n_ffts, 1, native);
+#pragma omp parallel for
+    for (int m = 0; m < n_ffts; ++m)
+    {
+        multiplySpectra(source + (size_t)m * fftsz, filter, fftsz, 1);
+    }
+    inverse(source, fftsz, n_ffts, 1, native);
+}
+
+// ****************************************************************************
+// Function: RunConvolution
+//
+// Purpose:
+//   Times the convolution of batches of 512-point signals with a short
+//   kernel by FFT: forward transforms, a pointwise product with the
+//   kernel's spectrum and inverse transforms.  The fused version works
+//   through the batch a cache-sized chunk per thread at a time
+//   (convolveFused).  The unfused version makes three passes over the
+//   whole batch: all forward transforms, all products, all inverse
+//   transforms.  Both report GFLOPS for two transforms and a complex
+//   product per point, with the data on the target, and are checked
+//   against a direct convolution.
+//
+// Arguments:
+//   name: SP-FFT or DP-FFT, with the implementation suffix
+//   resultDB: the benchmark stores its results in this ResultDatabase
+//   op: the options parser / parameter database
+//   native: run the in-tree FFT instead of MKL
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T2>
+void RunConvolution(const string& name, ResultDatabase &resultDB,
+    OptionParser &op, bool native)
+{
+    static __declspec(target(mic)) T2 *source;
+    static __declspec(target(mic)) T2 *filter;
+    const int micdev = op.getOptionInt("target");
+    const bool useMIC = UseOffload(op);
+    const bool verbose = op.getOptionBool("verbose");
+
+    const int fftsz = 512;
+    const int n_ffts = max(1, (int)(DataBytes(op) / sizeof(T2) / fftsz));
+    const int N = fftsz * n_ffts;
+
+    // Transforms per chunk that fit the chunk size
+    const int request = max(1, (int)(op.getOptionInt("conv-chunk") *
+                                     1024L / (fftsz * sizeof(T2))));
+
+    const size_t sourceBytes = (size_t)N * sizeof(T2);
+    const size_t filterBytes = fftsz * sizeof(T2);
+    source = (T2*) BackendAlloc(sourceBytes, 4096);
+    filter = (T2*) BackendAlloc(filterBytes, 4096);
+    if (!source || !filter)
+    {
+        cerr << "memory allocation failed" << endl;
+        BackendFree(source);
+        BackendFree(filter);
+        return;
+    }
+    BackendCreate(op, source, sourceBytes);
+    BackendCreate(op, filter, filterBytes);
+
+    // The filter spectrum, and a chunk small enough that every thread
+    // gets one
+    int chunk;
+    #pragma offload target(mic:micdev) if(useMIC) \
+        in(fftsz, n_ffts, request, native) nocopy(filter) out(chunk)
+    {
+        initFilter(filter, fftsz, native);
+        const int threads = omp_get_max_threads();
+        chunk = min(request, (n_ffts + threads - 1) / threads);
+    }
+
+    char atts[64];
+    sprintf(atts, "N=%d Chunk:%d", N, chunk);
+    const string tests[2] = { name + "_Conv", name + "_ConvUnfused" };
+
+    // Check both versions, which also creates their plans
+    for (int v = 0; v < 2; v++)
+    {
+        int chk;
+        #pragma offload target(mic:micdev) if(useMIC) \
+            in(v, fftsz, n_ffts, chunk, native) nocopy(source, filter) \
+            out(chk)
+        {
+            init<T2>(source, fftsz, n_ffts);
+            if (v == 0)
+                convolveFused(source, filter, fftsz, n_ffts, chunk, native);
+            else
+                convolveUnfused(source, filter, fftsz, n_ffts, native);
+            chk = checkConvolution(source, fftsz, n_ffts);
+        }
+        if (verbose || chk)
+        {
+            cout << "Test " << tests[v] << ((chk) ? ": Failed\n"
+                                                  : ": Passed\n");
+        }
+    }
+
+    Measurement meas(op);
+    while (!meas.Finished())
+    {
+        for (int v = 0; v < 2; v++)
+        {
+            if (meas.Done(tests[v]))
+            {
+                continue;
+            }
+
+            // Fresh data, so repeated convolutions cannot overflow
+            #pragma offload target(mic:micdev) if(useMIC) \
+                in(fftsz, n_ffts) nocopy(source)
+            {
+                init<T2>(source, fftsz, n_ffts);
+            }
+
+            meas.Start(tests[v]);
+            #pragma offload target(mic:micdev) if(useMIC) \
+                in(v, fftsz, n_ffts, chunk, native) nocopy(source, filter)
+            {
+                if (v == 0)
+                    convolveFused(source, filter, fftsz, n_ffts, chunk,
+                                  native);
+                else
+                    convolveUnfused(source, filter, fftsz, n_ffts, native);
+            }
+            meas.Stop(tests[v]);
+        }
+    }
+
+    const double flop_count = (double)n_ffts *
+                              (2 * 5 * fftsz * log2(fftsz) + 6 * fftsz);
+    for (int v = 0; v < 2; v++)
+    {
+        vector<double> times = meas.Samples(tests[v]);
+        for (size_t j = 0; j < times.size(); j++)
+        {
+            resultDB.AddResult(tests[v], atts, "GFLOPS",
+                    flop_count / (times[j] * 1e9));
+        }
+        meas.RecordConfidence(resultDB, tests[v], tests[v], atts);
+    }
+
+    // Cleanup FFT plans and buffers
+    #pragma offload target(mic:micdev) if(useMIC)
+    {
+        forward((T2*)NULL, 0, 0);
+    }
+    BackendRelease(op, source, sourceBytes);
+    BackendRelease(op, filter, filterBytes);
+    BackendFree(source);
+    BackendFree(filter);
 }
 
 // Useful routine for debugging 
@@ -294,3 +1101,5 @@ void maybe_dump(const char *legend, const T2 *source)
     }
 }
 */
+
+SHOC_REGISTER_BENCHMARK(FFT);
@@ -0,0 +1,668 @@
+// This example from an alpha release of the Scalable HeterOgeneous Computing
+// (SHOC) Benchmark Suite Alpha v1.1.4a-mic for Intel MIC architecture
+// Contact: Kyle Spafford <kys@ornl.gov>
+//          Rezaur Rahman <rezaur.rahman@intel.com>
+//
+// Copyright (c) 2011, UT-Battelle, LLC
+// Copyright (c) 2013, Intel Corporation
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of Oak Ridge National Laboratory, nor UT-Battelle, LLC, 
+//    nor the names of its contributors may be used to endorse or promote 
+//    products derived from this software without specific prior written 
+//    permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, 
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
+// THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef NATIVE_FFT_H
+#define NATIVE_FFT_H
+
+#include <math.h>
+#include <string.h>
+#include "omp.h"
+#include "offload.h"
+#include "HostCPU.h"
+
+// ****************************************************************************
+// File:  NativeFFT.h
+//
+// Purpose:
+//   A batched complex FFT of power-of-two sides, in one to three
+//   dimensions, that needs no FFT library.  Every 1-D line of a transform
+//   is copied into split real and imaginary buffers and goes through
+//   Stockham autosort stages of radix 8 (radix 2 or 4 for the leftover
+//   factor), which ping-pong between two buffers and leave the result in
+//   natural order without a bit-reversal pass.  Twiddle factors are
+//   computed once per plan, in double precision, and stored per stage.
+//
+//   The butterflies are written with GCC vector extensions.  A stage works
+//   on vectors along the stride between its inputs, as wide as that
+//   stride allows; the first stage, whose stride is 1, works on vectors
+//   of consecutive butterflies instead.  On the host the SSE, AVX2 and
+//   AVX-512 versions are compiled with function target attributes and
+//   picked with CPUID; on the card only the 512-bit version exists.
+//
+//   The OpenMP team deals the lines of a batch out to its threads.  When
+//   there are fewer lines than threads, the threads share every stage of
+//   each line instead.
+//
+// Creation:    October 16, 2026
+//
+// ****************************************************************************
+enum FFTISA
+{
+    FFT_SSE,
+    FFT_AVX2,
+    FFT_AVX512,
+    NUM_FFT_ISAS
+};
+
+#define FFT_MAX_STAGES 32
+
+// The butterflies are inlined into the per-ISA entry points below, so they
+// are compiled for that entry point's target
+#define SHOC_FFT_INLINE inline __attribute__((always_inline))
+
+// Widest butterflies this host can run; the card always uses 512 bits
+static FFTISA FFTHostISA()
+{
+    if (HostSupports(ISA_AVX512))
+        return FFT_AVX512;
+    if (HostSupports(ISA_AVX2))
+        return FFT_AVX2;
+    return FFT_SSE;
+}
+
+#pragma offload_attribute(push, target(mic))
+
+// A plan for lines of n points, T being float or double
+template <class T>
+struct NativeFFTPlan
+{
+    int n;
+    int isa;
+    int stages;
+    int radix[FFT_MAX_STAGES];
+
+    // cos and sin of 2 pi k p / (radix * m) for stage t at
+    // table + offset[t] + (k-1) * m + p
+    long offset[FFT_MAX_STAGES];
+    T *cosTable;
+    T *sinTable;
+};
+
+// Whether the engine handles lines of n points
+static inline bool NativeFFTSupports(int n)
+{
+    return n > 0 && (n & (n - 1)) == 0;
+}
+
+// ****************************************************************************
+// Function: NativeFFTCreate
+//
+// Purpose:
+//   Splits n into radix-8 stages, with one radix-2 or radix-4 stage last
+//   for the leftover factor, and fills the twiddle tables.  Each stage's
+//   table is padded to 64 bytes so vector loads from it are aligned.
+//
+// Arguments:
+//   n: points per line, a power of two
+//
+// Returns:  the plan, or NULL if n is not supported
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T>
+NativeFFTPlan<T> *NativeFFTCreate(int n)
+{
+    if (!NativeFFTSupports(n))
+        return NULL;
+
+    NativeFFTPlan<T> *plan = new NativeFFTPlan<T>;
+    plan->n = n;
+#ifdef __MIC__
+    plan->isa = FFT_AVX512;
+#else
+    plan->isa = FFTHostISA();
+#endif
+
+    int log2n = 0;
+    while ((1 << log2n) < n)
+        log2n++;
+    plan->stages = 0;
+    for (int i = 0; i < log2n / 3; i++)
+        plan->radix[plan->stages++] = 8;
+    if (log2n % 3)
+        plan->radix[plan->stages++] = 1 << (log2n % 3);
+
+    long entries = 0;
+    for (int t = 0, span = n; t < plan->stages; t++)
+    {
+        const int r = plan->radix[t];
+        plan->offset[t] = entries;
+        entries += ((long)(r - 1) * (span / r) + 15) / 16 * 16;
+        span /= r;
+    }
+    plan->cosTable = (T *)_mm_malloc(sizeof(T) * (entries + 16), 64);
+    plan->sinTable = (T *)_mm_malloc(sizeof(T) * (entries + 16), 64);
+
+    for (int t = 0, span = n; t < plan->stages; t++)
+    {
+        const int r = plan->radix[t];
+        const int m = span / r;
+        for (int k = 1; k < r; k++)
+        {
+            for (int p = 0; p < m; p++)
+            {
+                const double angle = 2. * M_PI * k * p / span;
+                plan->cosTable[plan->offset[t] + (k - 1) * m + p] =
+                    (T)cos(angle);
+                plan->sinTable[plan->offset[t] + (k - 1) * m + p] =
+                    (T)sin(angle);
+            }
+        }
+        span = m;
+    }
+    return plan;
+}
+
+template <class T>
+void NativeFFTDestroy(NativeFFTPlan<T> *plan)
+{
+    if (!plan)
+        return;
+    _mm_free(plan->cosTable);
+    _mm_free(plan->sinTable);
+    delete plan;
+}
+
+// Multiplies (re, im) by SIGN * i
+template <class V, int SIGN>
+static SHOC_FFT_INLINE void FFTRotate(V &re, V &im)
+{
+    const V t = re;
+    if (SIGN < 0)
+    {
+        re = im;
+        im = -t;
+    }
+    else
+    {
+        re = -im;
+        im = t;
+    }
+}
+
+// 4-point DFT in place, with exp(SIGN * 2 pi i / 4) as the root of unity
+template <class V, int SIGN>
+static SHOC_FFT_INLINE void FFTDft4(V &r0, V &i0, V &r1, V &i1, V &r2,
+                                    V &i2, V &r3, V &i3)
+{
+    const V sr = r0 + r2, si = i0 + i2;
+    const V dr = r0 - r2, di = i0 - i2;
+    const V tr = r1 + r3, ti = i1 + i3;
+    V ur = r1 - r3, ui = i1 - i3;
+    FFTRotate<V, SIGN>(ur, ui);
+    r0 = sr + tr;
+    i0 = si + ti;
+    r1 = dr + ur;
+    i1 = di + ui;
+    r2 = sr - tr;
+    i2 = si - ti;
+    r3 = dr - ur;
+    i3 = di - ui;
+}
+
+// ****************************************************************************
+// Function: FFTDft
+//
+// Purpose:
+//   R-point DFT in place on vectors of independent butterflies.  The
+//   8-point one is two 4-point DFTs of the even and odd inputs, combined
+//   with the eighth roots of unity.
+//
+// Arguments:
+//   re, im: the R inputs, overwritten by the R outputs in natural order
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T, class V, int R, int SIGN>
+static SHOC_FFT_INLINE void FFTDft(V *re, V *im)
+{
+    if (R == 2)
+    {
+        const V r0 = re[0], i0 = im[0];
+        re[0] = r0 + re[1];
+        im[0] = i0 + im[1];
+        re[1] = r0 - re[1];
+        im[1] = i0 - im[1];
+    }
+    else if (R == 4)
+    {
+        FFTDft4<V, SIGN>(re[0], im[0], re[1], im[1], re[2], im[2], re[3],
+                         im[3]);
+    }
+    else
+    {
+        V e0r = re[0], e0i = im[0], e1r = re[2], e1i = im[2];
+        V e2r = re[4], e2i = im[4], e3r = re[6], e3i = im[6];
+        V o0r = re[1], o0i = im[1], o1r = re[3], o1i = im[3];
+        V o2r = re[5], o2i = im[5], o3r = re[7], o3i = im[7];
+        FFTDft4<V, SIGN>(e0r, e0i, e1r, e1i, e2r, e2i, e3r, e3i);
+        FFTDft4<V, SIGN>(o0r, o0i, o1r, o1i, o2r, o2i, o3r, o3i);
+
+        // Odd outputs times exp(SIGN * 2 pi i k / 8)
+        const T h = (T)0.70710678118654752440;
+        const V a1r = h * (o1r - SIGN * o1i), a1i = h * (o1i + SIGN * o1r);
+        FFTRotate<V, SIGN>(o2r, o2i);
+        const V a3r = -h * (o3r + SIGN * o3i), a3i = h * (SIGN * o3r - o3i);
+
+        re[0] = e0r + o0r;
+        im[0] = e0i + o0i;
+        re[4] = e0r - o0r;
+        im[4] = e0i - o0i;
+        re[1] = e1r + a1r;
+        im[1] = e1i + a1i;
+        re[5] = e1r - a1r;
+        im[5] = e1i - a1i;
+        re[2] = e2r + o2r;
+        im[2] = e2i + o2i;
+        re[6] = e2r - o2r;
+        im[6] = e2i - o2i;
+        re[3] = e3r + a3r;
+        im[3] = e3i + a3i;
+        re[7] = e3r - a3r;
+        im[7] = e3i - a3i;
+    }
+}
+
+// Thread tid's share [begin, end) of count items
+static inline void FFTShare(long count, int tid, int nThreads, long &begin,
+                            long &end)
+{
+    begin = count * tid / nThreads;
+    end = count * (tid + 1) / nThreads;
+}
+
+// ****************************************************************************
+// Function: FFTStage
+//
+// Purpose:
+//   One Stockham stage on a span of R * m points, repeated at stride s:
+//   for every p < m and q < s, the R inputs x[q + s * (p + k * m)] go
+//   through an R-point DFT, output k is multiplied by w^(k p) with
+//   w = exp(SIGN * 2 pi i / (R * m)) and stored at y[q + s * (R * p + k)].
+//   Vectors of L butterflies run along q, which needs s to be a multiple
+//   of L, or along p when s is 1, which needs m to be a multiple of L.
+//
+// Arguments:
+//   m, s: as above
+//   xr, xi, yr, yi: split input and output buffers
+//   cosTable, sinTable: the stage's twiddle tables
+//   tid, nThreads: this thread's number and the team sharing the stage
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T, int BYTES, int R, int SIGN>
+static SHOC_FFT_INLINE void FFTStage(int m, int s, const T *xr,
+    const T *xi, T *yr, T *yi, const T *cosTable, const T *sinTable,
+    int tid, int nThreads)
+{
+    typedef T V __attribute__((vector_size(BYTES)));
+    const int L = BYTES / sizeof(T);
+    long begin, end;
+
+    if (s == 1 && L > 1)
+    {
+        FFTShare(m / L, tid, nThreads, begin, end);
+        for (long b = begin; b < end; b++)
+        {
+            const long p = b * L;
+            V re[R], im[R];
+            for (int k = 0; k < R; k++)
+            {
+                re[k] = *(const V *)(xr + p + k * m);
+                im[k] = *(const V *)(xi + p + k * m);
+            }
+            FFTDft<T, V, R, SIGN>(re, im);
+            for (int k = 1; k < R; k++)
+            {
+                const V wr = *(const V *)(cosTable + (k - 1) * m + p);
+                const V wi = SIGN * *(const V *)(sinTable + (k - 1) * m + p);
+                const V t = re[k] * wr - im[k] * wi;
+                im[k] = re[k] * wi + im[k] * wr;
+                re[k] = t;
+            }
+
+            // Output k of butterfly p + l goes to R * (p + l) + k
+            for (int l = 0; l < L; l++)
+            {
+                for (int k = 0; k < R; k++)
+                {
+                    yr[R * (p + l) + k] = re[k][l];
+                    yi[R * (p + l) + k] = im[k][l];
+                }
+            }
+        }
+        return;
+    }
+
+    const int qBlocks = s / L;
+    FFTShare((long)m * qBlocks, tid, nThreads, begin, end);
+    for (long b = begin; b < end; b++)
+    {
+        const int p = b / qBlocks;
+        const long q = (b % qBlocks) * L;
+        V re[R], im[R];
+        for (int k = 0; k < R; k++)
+        {
+            re[k] = *(const V *)(xr + q + (long)s * (p + k * m));
+            im[k] = *(const V *)(xi + q + (long)s * (p + k * m));
+        }
+        FFTDft<T, V, R, SIGN>(re, im);
+        *(V *)(yr + q + (long)s * R * p) = re[0];
+        *(V *)(yi + q + (long)s * R * p) = im[0];
+        for (int k = 1; k < R; k++)
+        {
+            const T wr = cosTable[(k - 1) * m + p];
+            const T wi = SIGN * sinTable[(k - 1) * m + p];
+            *(V *)(yr + q + (long)s * (R * p + k)) = re[k] * wr - im[k] * wi;
+            *(V *)(yi + q + (long)s * (R * p + k)) = re[k] * wi + im[k] * wr;
+        }
+    }
+}
+
+// Runs a stage with the widest vectors, up to BYTES, that fit it
+template <class T, int BYTES, int R, int SIGN>
+struct FFTStageFit
+{
+    static SHOC_FFT_INLINE void Run(int m, int s, const T *xr, const T *xi,
+        T *yr, T *yi, const T *cosTable, const T *sinTable, int tid,
+        int nThreads)
+    {
+        const int L = BYTES / sizeof(T);
+        if (s == 1 ? m % L : s % L)
+            FFTStageFit<T, BYTES / 2, R, SIGN>::Run(m, s, xr, xi, yr, yi,
+                cosTable, sinTable, tid, nThreads);
+        else
+            FFTStage<T, BYTES, R, SIGN>(m, s, xr, xi, yr, yi, cosTable,
+                                        sinTable, tid, nThreads);
+    }
+};
+
+// Scalar butterflies fit every stage
+template <int R, int SIGN>
+struct FFTStageFit<float, sizeof(float), R, SIGN>
+{
+    static SHOC_FFT_INLINE void Run(int m, int s, const float *xr,
+        const float *xi, float *yr, float *yi, const float *cosTable,
+        const float *sinTable, int tid, int nThreads)
+    {
+        FFTStage<float, sizeof(float), R, SIGN>(m, s, xr, xi, yr, yi,
+            cosTable, sinTable, tid, nThreads);
+    }
+};
+
+template <int R, int SIGN>
+struct FFTStageFit<double, sizeof(double), R, SIGN>
+{
+    static SHOC_FFT_INLINE void Run(int m, int s, const double *xr,
+        const double *xi, double *yr, double *yi, const double *cosTable,
+        const double *sinTable, int tid, int nThreads)
+    {
+        FFTStage<double, sizeof(double), R, SIGN>(m, s, xr, xi, yr, yi,
+            cosTable, sinTable, tid, nThreads);
+    }
+};
+
+// ****************************************************************************
+// Function: FFTLine
+//
+// Purpose:
+//   Transforms one line of interleaved complex points.  The line is
+//   gathered into split buffers, goes through the plan's stages and is
+//   scattered to the output, which may be the input itself.
+//
+// Arguments:
+//   plan: the plan
+//   in, out, stride: point j is in[2 * j * stride] (real) and the element
+//                    after it (imaginary), and the same in out
+//   scratch: 4 * n elements, 64-byte aligned, shared by the team
+//   tid, nThreads: this thread's number and the team sharing the line
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T, int BYTES, int SIGN>
+static SHOC_FFT_INLINE void FFTLine(const NativeFFTPlan<T> *plan,
+    const T *in, T *out, long stride, T *scratch, int tid, int nThreads)
+{
+    const int n = plan->n;
+    T *xr = scratch, *xi = scratch + n;
+    T *yr = scratch + 2 * n, *yi = scratch + 3 * n;
+    long begin, end;
+
+    FFTShare(n, tid, nThreads, begin, end);
+    for (long j = begin; j < end; j++)
+    {
+        xr[j] = in[2 * j * stride];
+        xi[j] = in[2 * j * stride + 1];
+    }
+
+    for (int t = 0, s = 1, span = n; t < plan->stages; t++)
+    {
+        if (nThreads > 1)
+        {
+            #pragma omp barrier
+        }
+        const int r = plan->radix[t];
+        const int m = span / r;
+        const T *c = plan->cosTable + plan->offset[t];
+        const T *sn = plan->sinTable + plan->offset[t];
+        if (r == 8)
+            FFTStageFit<T, BYTES, 8, SIGN>::Run(m, s, xr, xi, yr, yi, c, sn,
+                                                tid, nThreads);
+        else if (r == 4)
+            FFTStageFit<T, BYTES, 4, SIGN>::Run(m, s, xr, xi, yr, yi, c, sn,
+                                                tid, nThreads);
+        else
+            FFTStageFit<T, BYTES, 2, SIGN>::Run(m, s, xr, xi, yr, yi, c, sn,
+                                                tid, nThreads);
+        T *swap = xr;
+        xr = yr;
+        yr = swap;
+        swap = xi;
+        xi = yi;
+        yi = swap;
+        s *= r;
+        span = m;
+    }
+
+    if (nThreads > 1)
+    {
+        #pragma omp barrier
+    }
+    for (long j = begin; j < end; j++)
+    {
+        out[2 * j * stride] = xr[j];
+        out[2 * j * stride + 1] = xi[j];
+    }
+    if (nThreads > 1)
+    {
+        #pragma omp barrier
+    }
+}
+
+// Per-ISA entry points
+#ifdef __MIC__
+template <class T, int SIGN>
+static __declspec(target(MIC)) void FFTLineAVX512(
+    const NativeFFTPlan<T> *plan, const T *in, T *out, long stride,
+    T *scratch, int tid, int nThreads)
+{
+    FFTLine<T, 64, SIGN>(plan, in, out, stride, scratch, tid, nThreads);
+}
+#else
+template <class T, int SIGN>
+static void FFTLineSSE(const NativeFFTPlan<T> *plan, const T *in, T *out,
+                       long stride, T *scratch, int tid, int nThreads)
+{
+    FFTLine<T, 16, SIGN>(plan, in, out, stride, scratch, tid, nThreads);
+}
+
+template <class T, int SIGN>
+static SHOC_TARGET_AVX2 void FFTLineAVX2(const NativeFFTPlan<T> *plan,
+    const T *in, T *out, long stride, T *scratch, int tid, int nThreads)
+{
+    FFTLine<T, 32, SIGN>(plan, in, out, stride, scratch, tid, nThreads);
+}
+
+template <class T, int SIGN>
+static SHOC_TARGET_AVX512 void FFTLineAVX512(const NativeFFTPlan<T> *plan,
+    const T *in, T *out, long stride, T *scratch, int tid, int nThreads)
+{
+    FFTLine<T, 64, SIGN>(plan, in, out, stride, scratch, tid, nThreads);
+}
+#endif
+
+template <class T>
+static __declspec(target(MIC)) void FFTDispatch(const NativeFFTPlan<T> *plan,
+    int sign, const T *in, T *out, long stride, T *scratch, int tid,
+    int nThreads)
+{
+#ifdef __MIC__
+    if (sign < 0)
+        FFTLineAVX512<T, -1>(plan, in, out, stride, scratch, tid, nThreads);
+    else
+        FFTLineAVX512<T, 1>(plan, in, out, stride, scratch, tid, nThreads);
+#else
+    switch (plan->isa * 2 + (sign > 0))
+    {
+      case FFT_AVX512 * 2:
+        FFTLineAVX512<T, -1>(plan, in, out, stride, scratch, tid, nThreads);
+        break;
+      case FFT_AVX512 * 2 + 1:
+        FFTLineAVX512<T, 1>(plan, in, out, stride, scratch, tid, nThreads);
+        break;
+      case FFT_AVX2 * 2:
+        FFTLineAVX2<T, -1>(plan, in, out, stride, scratch, tid, nThreads);
+        break;
+      case FFT_AVX2 * 2 + 1:
+        FFTLineAVX2<T, 1>(plan, in, out, stride, scratch, tid, nThreads);
+        break;
+      case FFT_SSE * 2:
+        FFTLineSSE<T, -1>(plan, in, out, stride, scratch, tid, nThreads);
+        break;
+      default:
+        FFTLineSSE<T, 1>(plan, in, out, stride, scratch, tid, nThreads);
+        break;
+    }
+#endif
+}
+
+// ****************************************************************************
+// Function: NativeFFT
+//
+// Purpose:
+//   Unscaled transforms of a batch of interleaved complex arrays with n
+//   points on each of dims sides, stored back to back, one dimension after
+//   the other.  The first dimension reads the input and writes the output,
+//   the others work in the output, so in and out may be the same array.
+//   Like DftiComputeForward and DftiComputeBackward, sign -1 is the forward
+//   transform and +1 the inverse.
+//
+// Arguments:
+//   plan: plan for n points
+//   in, out: n_ffts transforms of n^dims complex points, real parts first
+//   n_ffts: transforms in the batch
+//   dims: 1, 2 or 3
+//   sign: -1 or +1
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T>
+__declspec(target(MIC)) void NativeFFT(const NativeFFTPlan<T> *plan,
+    const T *in, T *out, int n_ffts, int dims, int sign)
+{
+    const int n = plan->n;
+    long points = 1;
+    for (int d = 0; d < dims; d++)
+        points *= n;
+    const long perFFT = points / n;
+    const long lines = perFFT * n_ffts;
+
+    // With too few lines for the team, its threads share each line
+    const bool shareLines = lines < omp_get_max_threads();
+    T *shared = shareLines ? (T *)_mm_malloc(sizeof(T) * 4 * n, 64) : NULL;
+
+    // Along dimension d the points of a line are stride apart, and line l
+    // starts in transform l / perFFT, at (outer, inner) = divmod(l % perFFT,
+    // stride)
+    for (long d = 0, stride = perFFT; d < dims; d++, stride /= n)
+    {
+        const T *src = d == 0 ? in : out;
+        #pragma omp parallel
+        {
+            if (shareLines)
+            {
+                for (long l = 0; l < lines; l++)
+                {
+                    const long r = l % perFFT;
+                    const long at = 2 * ((l / perFFT) * points +
+                        (r / stride) * stride * n + r % stride);
+                    FFTDispatch<T>(plan, sign, src + at, out + at, stride,
+                        shared, omp_get_thread_num(), omp_get_num_threads());
+                }
+            }
+            else
+            {
+                T *scratch = (T *)_mm_malloc(sizeof(T) * 4 * n, 64);
+                #pragma omp for schedule(static)
+                for (long l = 0; l < lines; l++)
+                {
+                    const long r = l % perFFT;
+                    const long at = 2 * ((l / perFFT) * points +
+                        (r / stride) * stride * n + r % stride);
+                    FFTDispatch<T>(plan, sign, src + at, out + at, stride,
+                        scratch, 0, 1);
+                }
+                _mm_free(scratch);
+            }
+        }
+    }
+    _mm_free(shared);
+}
+
+#pragma offload_attribute(pop)
+
+#endif
@@ -38,10 +38,15 @@
 #include <omp.h>
 #include <math.h>
 
+// MKL is optional: without HAVE_MKL only the in-tree FFT is built
+#ifdef HAVE_MKL
 #pragma offload_attribute(push, target(mic))
 #include <mkl.h>
 #include <mkl_dfti.h>
 #pragma offload_attribute(pop)
+#endif
+
+#include "NativeFFT.h"
 
 struct cplxflt {
     float x;
@@ -61,77 +66,372 @@ template <>
 inline bool micDp<cplxflt>(void) { return false; }
 template <>
 inline bool micDp<cplxdbl>(void) { return true; }
+// Real type of the complex elements
+template <class T2> struct fftReal;
+template <> struct fftReal<cplxflt> { typedef float type; };
+template <> struct fftReal<cplxdbl> { typedef double type; };
+template <class T2>
+__declspec(target(mic))
+double forward(T2* source, const int fftsz, const int n_ffts,
+        const int dims = 1, const bool native = false);
+template <class T2>
+__declspec(target(mic))
+double inverse(T2* source, const int fftsz, const int n_ffts,
+        const int dims = 1, const bool native = false);
+template <class T2>
+__declspec(target(mic))
+double forwardOutOfPlace(const T2* in, T2* out, const int fftsz,
+        const int n_ffts, const int dims = 1, const bool native = false);
 template <class T2>
 __declspec(target(mic))
-void forward(T2* source, const int fftsz, const int n_ffts);
+double inverseOutOfPlace(const T2* in, T2* out, const int fftsz,
+        const int n_ffts, const int dims = 1, const bool native = false);
 template <class T2>
 __declspec(target(mic))
-void inverse(T2* source, const int fftsz, const int n_ffts);
+double forwardReal(const typename fftReal<T2>::type* in, T2* out,
+        const int fftsz, const int n_ffts, const int dims = 1);
+template <class T2>
+__declspec(target(mic))
+double inverseReal(const T2* in, typename fftReal<T2>::type* out,
+        const int fftsz, const int n_ffts, const int dims = 1);
 template <class T2>
 __declspec(target(mic))
 int checkDiff(T2 *source, const int half_n_cmplx);
 #pragma offload_attribute(pop)
 
-// Perform forward ffts
-template<class T2>
+// What a plan is created for; every call with the same key shares it
+struct fftPlanKey
+{
+    bool dp;
+    int fftsz;
+    int n_ffts;
+    int dims;
+    bool inverse;
+    bool inPlace;
+    bool native;
+    bool real;      // real input forward, real output inverse
+    bool serial;    // run by one thread, while others run it too
+};
+
+struct fftPlan
+{
+    fftPlanKey key;
+#ifdef HAVE_MKL
+    DFTI_DESCRIPTOR_HANDLE dfti;
+#endif
+    void *native;           // NativeFFTPlan<float> or NativeFFTPlan<double>
+    unsigned long lastUse;  // 0 for a free slot
+};
+
+// Plans live on the target until they are evicted, least recently used
+// first, or freed together
+#define FFT_PLAN_CACHE_SIZE 64
+static __declspec(target(mic)) fftPlan fftPlans[FFT_PLAN_CACHE_SIZE];
+static __declspec(target(mic)) unsigned long fftPlanClock;
+
 __declspec(target(mic))
-void forward(T2* source, const int fftsz, const int n_ffts)
+static inline bool samePlanKey(const fftPlanKey &a, const fftPlanKey &b)
 {
-    static __declspec(target(mic)) DFTI_DESCRIPTOR_HANDLE plan;
-    if (!source)
+    return a.dp == b.dp && a.fftsz == b.fftsz && a.n_ffts == b.n_ffts &&
+           a.dims == b.dims && a.inverse == b.inverse &&
+           a.inPlace == b.inPlace && a.native == b.native &&
+           a.real == b.real && a.serial == b.serial;
+}
+
+#ifdef HAVE_MKL
+// Create a descriptor for n_ffts transforms of fftsz points on a side in
+// dims dimensions, stored back to back.  The complex side of a real
+// transform keeps fftsz / 2 + 1 points of its last dimension, as complex
+// numbers, and has no padding.
+__declspec(target(mic))
+static void createPlan(DFTI_DESCRIPTOR_HANDLE *plan, const fftPlanKey &key)
+{
+    const DFTI_CONFIG_VALUE precision = key.dp ? DFTI_DOUBLE : DFTI_SINGLE;
+    const DFTI_CONFIG_VALUE domain = key.real ? DFTI_REAL : DFTI_COMPLEX;
+    MKL_LONG points = 1;
+    MKL_LONG lengths[3];
+    for (int d = 0; d < key.dims; d++)
+    {
+        lengths[d] = key.fftsz;
+        points *= key.fftsz;
+    }
+    if (key.dims == 1)
+    {
+        DftiCreateDescriptor(plan, precision, domain, 1,
+                (MKL_LONG)key.fftsz);
+    }
+    else
+    {
+        DftiCreateDescriptor(plan, precision, domain,
+                (MKL_LONG)key.dims, lengths);
+    }
+    DftiSetValue(*plan, DFTI_NUMBER_OF_TRANSFORMS, (MKL_LONG)key.n_ffts);
+    if (!key.real)
     {
-        if (fftsz <= 0)
+        DftiSetValue(*plan, DFTI_INPUT_DISTANCE, points);
+        DftiSetValue(*plan, DFTI_OUTPUT_DISTANCE, points);
+    }
+    else
+    {
+        // Row-major strides of the real and the complex side
+        MKL_LONG realStrides[4], cplxStrides[4];
+        realStrides[0] = cplxStrides[0] = 0;
+        realStrides[key.dims] = cplxStrides[key.dims] = 1;
+        for (int d = key.dims - 1; d > 0; d--)
         {
-            DftiFreeDescriptor(&plan);
-            return;
+            realStrides[d] = realStrides[d + 1] * key.fftsz;
+            cplxStrides[d] = cplxStrides[d + 1] *
+                (d == key.dims - 1 ? key.fftsz / 2 + 1 : key.fftsz);
         }
-        if (micDp<T2>())
+        const MKL_LONG cplxPoints = points / key.fftsz * (key.fftsz / 2 + 1);
+
+        DftiSetValue(*plan, DFTI_CONJUGATE_EVEN_STORAGE,
+                DFTI_COMPLEX_COMPLEX);
+        DftiSetValue(*plan, DFTI_PACKED_FORMAT, DFTI_CCE_FORMAT);
+        DftiSetValue(*plan, DFTI_INPUT_STRIDES,
+                key.inverse ? cplxStrides : realStrides);
+        DftiSetValue(*plan, DFTI_OUTPUT_STRIDES,
+                key.inverse ? realStrides : cplxStrides);
+        DftiSetValue(*plan, DFTI_INPUT_DISTANCE,
+                key.inverse ? cplxPoints : points);
+        DftiSetValue(*plan, DFTI_OUTPUT_DISTANCE,
+                key.inverse ? points : cplxPoints);
+    }
+    if (!key.inPlace)
+    {
+        DftiSetValue(*plan, DFTI_PLACEMENT, DFTI_NOT_INPLACE);
+    }
+    if (key.serial)
+    {
+        DftiSetValue(*plan, DFTI_THREAD_LIMIT, (MKL_LONG)1);
+    }
+    DftiCommitDescriptor(*plan);
+}
+#endif
+
+__declspec(target(mic))
+static void destroyPlan(fftPlan *plan)
+{
+    if (plan->key.native && plan->key.dp)
+        NativeFFTDestroy((NativeFFTPlan<double> *)plan->native);
+    else if (plan->key.native)
+        NativeFFTDestroy((NativeFFTPlan<float> *)plan->native);
+#ifdef HAVE_MKL
+    else
+        DftiFreeDescriptor(&plan->dfti);
+#endif
+    plan->lastUse = 0;
+}
+
+// ****************************************************************************
+// Function: getPlan
+//
+// Purpose:
+//   Finds the cached plan for a key, or creates it in a free slot or in
+//   place of the least recently used plan.
+//
+// Arguments:
+//   key: what the plan is for
+//   seconds: set to the time spent creating and committing the plan, 0 if
+//            it was cached
+//
+// Returns:  the plan, or NULL if the native FFT does not support the size
+//           or real transforms, or for an MKL plan in a build without MKL
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T2>
+__declspec(target(mic))
+fftPlan *getPlan(const fftPlanKey &key, double *seconds)
+{
+    typedef typename fftReal<T2>::type T;
+    *seconds = 0.;
+
+    fftPlan *slot = &fftPlans[0];
+    for (int i = 0; i < FFT_PLAN_CACHE_SIZE; i++)
+    {
+        fftPlan *plan = &fftPlans[i];
+        if (plan->lastUse && samePlanKey(plan->key, key))
         {
-            DftiCreateDescriptor(&plan, DFTI_DOUBLE, DFTI_COMPLEX, 1, 
-                    (MKL_LONG)fftsz);
+            plan->lastUse = ++fftPlanClock;
+            return plan;
         }
-        else
+        if (slot->lastUse &&
+            (!plan->lastUse || plan->lastUse < slot->lastUse))
         {
-            DftiCreateDescriptor(&plan, DFTI_SINGLE, DFTI_COMPLEX, 1, 
-                    (MKL_LONG)fftsz);
+            slot = plan;
         }
-        DftiSetValue(plan, DFTI_NUMBER_OF_TRANSFORMS, (MKL_LONG)n_ffts);
-        DftiSetValue(plan, DFTI_INPUT_DISTANCE, (MKL_LONG)fftsz);
-        DftiSetValue(plan, DFTI_OUTPUT_DISTANCE, (MKL_LONG)fftsz);
-        DftiCommitDescriptor(plan);
     }
-    DftiComputeForward(plan, source);
+    if (slot->lastUse)
+    {
+        destroyPlan(slot);
+    }
+
+    const double start = omp_get_wtime();
+    slot->key = key;
+    if (key.native)
+    {
+        slot->native = key.real ? NULL : NativeFFTCreate<T>(key.fftsz);
+        if (!slot->native)
+            return NULL;
+    }
+    else
+    {
+#ifdef HAVE_MKL
+        createPlan(&slot->dfti, key);
+#else
+        return NULL;
+#endif
+    }
+    *seconds = omp_get_wtime() - start;
+    slot->lastUse = ++fftPlanClock;
+    return slot;
 }
 
-// Perform inverse ffts
+// Runs the transforms of a plan.  It does not touch the cache, so threads
+// may run one plan at the same time.
+template<class T2>
+__declspec(target(mic))
+void runPlan(const fftPlan *plan, const void* in, void* out)
+{
+    typedef typename fftReal<T2>::type T;
+    const fftPlanKey &key = plan->key;
+    if (key.native)
+        NativeFFT<T>((const NativeFFTPlan<T> *)plan->native, (const T*)in,
+                (T*)out, key.n_ffts, key.dims, key.inverse ? 1 : -1);
+#ifdef HAVE_MKL
+    else if (key.inPlace && key.inverse)
+        DftiComputeBackward(plan->dfti, out);
+    else if (key.inPlace)
+        DftiComputeForward(plan->dfti, out);
+    else if (key.inverse)
+        DftiComputeBackward(plan->dfti, (void*)in, out);
+    else
+        DftiComputeForward(plan->dfti, (void*)in, out);
+#endif
+}
+
+// ****************************************************************************
+// Function: execute
+//
+// Purpose:
+//   Runs batched ffts with the cached plan for their size, batch,
+//   direction, layout and implementation.
+//
+// Arguments:
+//   in, out: the data, the same array in place, or NULL to only make sure
+//            the plan exists
+//   fftsz, n_ffts, dims: fftsz points on each of dims sides, n_ffts times;
+//                        an fftsz of 0 frees every cached plan instead
+//   native: use the in-tree FFT instead of MKL
+//   inverse: backward instead of forward transforms
+//   inPlace: whether in and out are the same array
+//   real: real input (forward) or output (inverse); in and out must differ
+//
+// Returns:  seconds spent creating the plan, 0 if it was cached
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
 template<class T2>
 __declspec(target(mic))
-void inverse(T2* source, const int fftsz, const int n_ffts)
+double execute(const void* in, void* out, const int fftsz, const int n_ffts,
+        const int dims, const bool native, const bool inverse,
+        const bool inPlace, const bool real)
 {
-    static __declspec(target(mic)) DFTI_DESCRIPTOR_HANDLE plan;
-    if (!source)
+    if (fftsz <= 0)
     {
-        if (fftsz <= 0)
-        {
-            DftiFreeDescriptor(&plan);
-            return;
-        }
-        if (micDp<T2>())
+        for (int i = 0; i < FFT_PLAN_CACHE_SIZE; i++)
         {
-            DftiCreateDescriptor(&plan, DFTI_DOUBLE, DFTI_COMPLEX, 1, 
-                    (MKL_LONG)fftsz);
+            if (fftPlans[i].lastUse)
+                destroyPlan(&fftPlans[i]);
         }
-        else
-        {
-            DftiCreateDescriptor(&plan, DFTI_SINGLE, DFTI_COMPLEX, 1, 
-                    (MKL_LONG)fftsz);
-        }
-        DftiSetValue(plan, DFTI_NUMBER_OF_TRANSFORMS, (MKL_LONG)n_ffts);
-        DftiSetValue(plan, DFTI_INPUT_DISTANCE, (MKL_LONG)fftsz);
-        DftiSetValue(plan, DFTI_OUTPUT_DISTANCE, (MKL_LONG)fftsz);
-        //DftiSetValue(plan, DFTI_BACKWARD_SCALE, 1.0/fftsz);
-        DftiCommitDescriptor(plan);
+        return 0.;
     }
-    DftiComputeBackward(plan, source);
+
+    const fftPlanKey key = { micDp<T2>(), fftsz, n_ffts, dims, inverse,
+                             inPlace, native, real, false };
+    double seconds;
+    fftPlan *plan = getPlan<T2>(key, &seconds);
+    if (plan && in)
+        runPlan<T2>(plan, in, out);
+    return seconds;
+}
+
+// Perform forward ffts
+template<class T2>
+__declspec(target(mic))
+double forward(T2* source, const int fftsz, const int n_ffts,
+        const int dims, const bool native)
+{
+    return execute<T2>(source, source, fftsz, n_ffts, dims, native, false,
+            true, false);
+}
+
+// Perform inverse ffts
+template<class T2>
+__declspec(target(mic))
+double inverse(T2* source, const int fftsz, const int n_ffts,
+        const int dims, const bool native)
+{
+    return execute<T2>(source, source, fftsz, n_ffts, dims, native, true,
+            true, false);
+}
+
+// Perform forward ffts from in to out, leaving in as it is
+template<class T2>
+__declspec(target(mic))
+double forwardOutOfPlace(const T2* in, T2* out, const int fftsz,
+        const int n_ffts, const int dims, const bool native)
+{
+    return execute<T2>(in, out, fftsz, n_ffts, dims, native, false, false,
+            false);
+}
+
+// Perform inverse ffts from in to out, leaving in as it is
+template<class T2>
+__declspec(target(mic))
+double inverseOutOfPlace(const T2* in, T2* out, const int fftsz,
+        const int n_ffts, const int dims, const bool native)
+{
+    return execute<T2>(in, out, fftsz, n_ffts, dims, native, true, false,
+            false);
+}
+
+// The plan for in-place complex ffts that each thread of a parallel region
+// runs on its own data with runPlan.  MKL plans are limited to one thread;
+// the native FFT runs on the calling thread alone, since nested parallel
+// regions get one thread.  Look it up before the region: the cache is not
+// thread safe.
+template<class T2>
+__declspec(target(mic))
+const fftPlan *threadPlan(const int fftsz, const int n_ffts, const int dims,
+        const bool native, const bool inverse)
+{
+    const fftPlanKey key = { micDp<T2>(), fftsz, n_ffts, dims, inverse,
+                             true, native, false, true };
+    double seconds;
+    return getPlan<T2>(key, &seconds);
+}
+
+// Perform real to complex forward ffts (MKL only)
+template<class T2>
+__declspec(target(mic))
+double forwardReal(const typename fftReal<T2>::type* in, T2* out,
+        const int fftsz, const int n_ffts, const int dims)
+{
+    return execute<T2>(in, out, fftsz, n_ffts, dims, false, false, false,
+            true);
+}
+
+// Perform complex to real inverse ffts (MKL only)
+template<class T2>
+__declspec(target(mic))
+double inverseReal(const T2* in, typename fftReal<T2>::type* out,
+        const int fftsz, const int n_ffts, const int dims)
+{
+    return execute<T2>(in, out, fftsz, n_ffts, dims, false, true, false,
+            true);
 }
 #endif
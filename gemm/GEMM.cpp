@@ -32,35 +32,78 @@
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
 // THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <string>
 
+#include <float.h>
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/time.h>
 #include <sys/types.h>
 #include <sys/sysctl.h>
+#ifdef HAVE_MKL
 #include <mkl.h>
+#endif
 #include "omp.h"
 
 #include "offload.h"
+#include "Backend.h"
+#include "HostCPU.h"
+#include "Measurement.h"
 #include "OptionParser.h"
 #include "ResultDatabase.h"
+#include "Benchmark.h"
 #include "Timer.h"
+#include "NativeGEMM.h"
 
 using namespace std;
 
+// MKL is optional: without HAVE_MKL only the in-tree GEMM is built
+#ifdef HAVE_MKL
+#define GEMM_DEFAULT_IMPL "mkl"
+#else
+#define GEMM_DEFAULT_IMPL "native"
+#endif
+
 // Forward declarations
 template <class T>
-void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op);
+static void
+RunTest(string testName, ResultDatabase &resultDB, OptionParser &op,
+        bool native);
 
 template <class T>
 inline void devGEMM(char transa, char transb, int m, int n, int k, T alpha,
         const T *A, int lda, const T *B, int ldb, T beta, T *C, int ldc);
 
+template <class T>
+inline void devGEMMBatch(char transa, char transb, int m, int n, int k,
+        T alpha, const T **A, int lda, const T **B, int ldb, T beta, T **C,
+        int ldc, int count);
+
+// One point of the shape sweep
+struct GemmShape
+{
+    int m, n, k;
+};
+
+template <class T>
+void RunShapes(string testName, ResultDatabase &resultDB, OptionParser &op,
+        bool native, const vector<GemmShape> &shapes);
+
+template <class T, class Ti>
+void RunReducedTest(string testName, ResultDatabase &resultDB,
+        OptionParser &op, const char *units, const char *precision,
+        double roundoff);
+
+template <class T>
+void RunOutOfCore(string testName, ResultDatabase &resultDB,
+        OptionParser &op, bool native);
+
 // ********************************************************
 // Function: toString
 //
@@ -111,9 +154,9 @@ void error(char *message)
 //
 // ********************************************************
 template <class T>
-void fill(T *A, const int n, const int maxi)
+void fill(T *A, const size_t n, const int maxi)
 {
-   for (int j = 0; j < n; j++)
+   for (size_t j = 0; j < n; j++)
       A[j] = T((rand() % (maxi * 2 + 1)) - maxi) / (maxi + 1.);
 }
 
@@ -132,10 +175,27 @@ void fill(T *A, const int n, const int maxi)
 // Returns:  nothing
 //
 // ****************************************************************************
-void addBenchmarkSpecOptions(OptionParser &op)
+static void addBenchmarkSpecOptions(OptionParser &op)
 {
    op.addOption("KiB", OPT_INT, "0", "data size (in Kibibytes)");
    op.addOption("N", OPT_INT, "0", "SQ Matrix Dimension");
+   op.addOption("impl", OPT_VECSTRING, GEMM_DEFAULT_IMPL,
+                "GEMM implementations to run (native, mkl)");
+   op.addOption("shapes", OPT_VECSTRING, "",
+                "MxNxK shapes to sweep instead of the square test");
+   op.addOption("batch", OPT_INT, "1",
+                "independent GEMMs per call in the shape sweep");
+   op.addOption("batch-layouts", OPT_VECSTRING, "pointer,strided",
+                "batch layouts (pointer, strided)");
+   op.addOption("reduced", OPT_VECSTRING, "",
+                "reduced-precision native GEMMs to run (bf16, fp16, int8)");
+   op.addOption("out-of-core", OPT_BOOL, "",
+                "stream tiles of matrices larger than the card's memory");
+   op.addOption("ooc-tile", OPT_INT, "0",
+                "tile dimension of the out-of-core GEMM (0: the square test "
+                "size)");
+   op.addOption("ooc-tiles", OPT_INT, "4",
+                "tiles per matrix dimension of the out-of-core GEMM");
 }
 
 // ****************************************************************************
@@ -154,6 +214,7 @@ void addBenchmarkSpecOptions(OptionParser &op)
 //
 // ****************************************************************************
 
+#ifdef HAVE_MKL
 // The following two methods are just a templatized call to GEMM.
 template<>
 inline __declspec(target(MIC)) void devGEMM<double>(char transa, char transb,
@@ -183,34 +244,198 @@ inline __declspec(target(MIC)) void devGEMM<float>(char transa, char transb,
 
 }
 
-void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
+// The same for a batch of GEMMs of one shape, as a single MKL group
+template<>
+inline __declspec(target(MIC)) void devGEMMBatch<double>(char transa,
+        char transb, int m, int n, int k, double alpha, const double **A,
+        int lda, const double **B, int ldb, double beta, double **C, int ldc,
+        int count)
 {
-    cout << "Running single precision test" << endl;
-    RunTest<float>("SGEMM", resultDB, op);
+    CBLAS_TRANSPOSE   transposeA= (transa=='N'?CblasNoTrans:CblasTrans);
+    CBLAS_TRANSPOSE   transposeB = (transb=='N'?CblasNoTrans:CblasTrans);
+    MKL_INT mm = m, nn = n, kk = k, la = lda, lb = ldb, lc = ldc;
+    MKL_INT groupSize = count;
 
-    cout << "Running double precision test" << endl;
-    RunTest<double>("DGEMM", resultDB, op);
+    cblas_dgemm_batch(CblasRowMajor, &transposeA, &transposeB, &mm, &nn, &kk,
+        &alpha, A, &la, B, &lb, &beta, C, &lc, 1, &groupSize);
 }
 
-// Macro for fixing leading dimension
-#define FIX_LD(x) (((x) * sizeof(T)) % 1024 == 0 ? (x) + 128 : (x))
+template<>
+inline __declspec(target(MIC)) void devGEMMBatch<float>(char transa,
+        char transb, int m, int n, int k, float alpha, const float **A,
+        int lda, const float **B, int ldb, float beta, float **C, int ldc,
+        int count)
+{
+    CBLAS_TRANSPOSE   transposeA= (transa=='N'?CblasNoTrans:CblasTrans);
+    CBLAS_TRANSPOSE   transposeB = (transb=='N'?CblasNoTrans:CblasTrans);
+    MKL_INT mm = m, nn = n, kk = k, la = lda, lb = ldb, lc = ldc;
+    MKL_INT groupSize = count;
 
+    cblas_sgemm_batch(CblasRowMajor, &transposeA, &transposeB, &mm, &nn, &kk,
+        &alpha, A, &la, B, &lb, &beta, C, &lc, 1, &groupSize);
+}
+#else
+// Without MKL the "mkl" implementation is refused in RunBenchmark; these
+// run the native GEMM so the shared test code still builds
 template <class T>
-void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
+inline __declspec(target(MIC)) void devGEMM(char transa, char transb, int m,
+        int n, int k, T alpha, const T *A, int lda, const T *B, int ldb,
+        T beta, T *C, int ldc)
 {
-    const int micdev = op.getOptionInt("target");
+    NativeGEMM<T>(GEMM_SSE, transa, transb, m, n, k, alpha, A, lda, B, ldb,
+            beta, C, ldc);
+}
 
-    // Repeat the test multiple times
-    int passes = op.getOptionInt("passes");
+template <class T>
+inline __declspec(target(MIC)) void devGEMMBatch(char transa, char transb,
+        int m, int n, int k, T alpha, const T **A, int lda, const T **B,
+        int ldb, T beta, T **C, int ldc, int count)
+{
+    NativeGEMMBatch<T>(GEMM_SSE, transa, transb, m, n, k, alpha, A, lda, B,
+            ldb, beta, C, ldc, count);
+}
+#endif
 
-    // Dimension of the matrix
-    int N;
+static void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
+{
+    vector<string> impls = op.getOptionVecString("impl");
+    for (size_t i = 0; i < impls.size(); i++)
+    {
+        if (impls[i] != "native" && impls[i] != "mkl")
+        {
+            cerr << "Error: unknown GEMM implementation \"" << impls[i]
+                 << "\"\n";
+            return;
+        }
+#ifndef HAVE_MKL
+        if (impls[i] == "mkl")
+        {
+            cerr << "Error: this build has no MKL (build with MKL=1), "
+                 << "use --impl native\n";
+            return;
+        }
+#endif
+    }
+
+    vector<string> reduced = op.getOptionVecString("reduced");
+    for (size_t i = 0; i < reduced.size(); i++)
+    {
+        if (reduced[i] != "bf16" && reduced[i] != "fp16" &&
+            reduced[i] != "int8")
+        {
+            cerr << "Error: unknown reduced precision \"" << reduced[i]
+                 << "\"\n";
+            return;
+        }
+    }
+
+    // Shape sweep: explicit shapes, or small cubes for a batch
+    vector<string> shapeNames = op.getOptionVecString("shapes");
+    if (shapeNames.empty() && op.getOptionInt("batch") > 1)
+    {
+        const char *cubes[] = { "8x8x8", "16x16x16", "32x32x32",
+                                "64x64x64", "128x128x128" };
+        shapeNames.assign(cubes, cubes + 5);
+    }
+    vector<GemmShape> shapes;
+    for (size_t i = 0; i < shapeNames.size(); i++)
+    {
+        GemmShape shape;
+        char extra;
+        if (sscanf(shapeNames[i].c_str(), "%dx%dx%d%c", &shape.m, &shape.n,
+                   &shape.k, &extra) != 3 ||
+            shape.m <= 0 || shape.n <= 0 || shape.k <= 0)
+        {
+            cerr << "Error: bad GEMM shape \"" << shapeNames[i]
+                 << "\", expected MxNxK\n";
+            return;
+        }
+        shapes.push_back(shape);
+    }
 
-    // Parse command line options
-    // There are basically three options here
-    // "-s [1-4]" pick a predefined size
-    // "--N [number]" use a number x number square matrix
-    // "--KiB [number]" use a large square matrix
+    for (size_t i = 0; i < impls.size(); i++)
+    {
+        // MKL keeps the original test names
+        const bool native = impls[i] == "native";
+        const string suffix = native ? "_Native" : "";
+
+        if (!shapes.empty())
+        {
+            cout << "Running " << impls[i] << " single precision shapes"
+                 << endl;
+            RunShapes<float>("SGEMM" + suffix, resultDB, op, native, shapes);
+
+            cout << "Running " << impls[i] << " double precision shapes"
+                 << endl;
+            RunShapes<double>("DGEMM" + suffix, resultDB, op, native, shapes);
+            continue;
+        }
+
+        if (op.getOptionBool("out-of-core"))
+        {
+            cout << "Running " << impls[i] << " single precision out-of-core"
+                 << " test" << endl;
+            RunOutOfCore<float>("SGEMM" + suffix, resultDB, op, native);
+
+            cout << "Running " << impls[i] << " double precision out-of-core"
+                 << " test" << endl;
+            RunOutOfCore<double>("DGEMM" + suffix, resultDB, op, native);
+            continue;
+        }
+
+        cout << "Running " << impls[i] << " single precision test" << endl;
+        RunTest<float>("SGEMM" + suffix, resultDB, op, native);
+
+        cout << "Running " << impls[i] << " double precision test" << endl;
+        RunTest<double>("DGEMM" + suffix, resultDB, op, native);
+    }
+
+    // Inputs in bf16, fp16 or int8, always on the native GEMM
+    for (size_t i = 0; i < reduced.size(); i++)
+    {
+        cout << "Running " << reduced[i] << " test" << endl;
+        if (reduced[i] == "bf16")
+        {
+            RunReducedTest<float, bf16>("BF16GEMM", resultDB, op, "GFlops",
+                    "SP", FLT_EPSILON / 2);
+        }
+        else if (reduced[i] == "fp16")
+        {
+            RunReducedTest<float, fp16>("FP16GEMM", resultDB, op, "GFlops",
+                    "SP", FLT_EPSILON / 2);
+        }
+        else
+        {
+            RunReducedTest<int, signed char>("INT8GEMM", resultDB, op, "GOps",
+                    NULL, 0.);
+        }
+    }
+}
+
+// Macro for fixing leading dimension
+#define FIX_LD(x) (((x) * sizeof(T)) % 1024 == 0 ? (x) + 128 : (x))
+
+// ****************************************************************************
+// Function: SquareDim
+//
+// Purpose:
+//   Dimension of the square test for elements of type T.  There are
+//   basically three options here: "-s [1-4]" picks a predefined size,
+//   "--N [number]" a number x number matrix and "--KiB [number]" a large
+//   matrix.
+//
+// Arguments:
+//   op: the options parser / parameter database
+//
+// Returns:  the matrix dimension, before cutting to the block size
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T>
+int SquareDim(OptionParser &op)
+{
+    int N;
     if ((op.getOptionInt("KiB") == 0) && (op.getOptionInt("N") == 0))
     {
         int probSizes[4] = { 1, 4, 8, 16 };
@@ -226,7 +451,22 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
     {
         N = op.getOptionInt("KiB") * 1024 / sizeof(T);
     }
+    return N;
+}
 
+template <class T>
+static void
+RunTest(string testName, ResultDatabase &resultDB, OptionParser &op,
+        bool native)
+{
+    const int micdev = op.getOptionInt("target");
+    const bool useMIC = UseOffload(op);
+
+    // Micro-kernel of the native GEMM on the host; the card has only one
+    const int isa = GemmHostISA();
+
+    // Dimension of the matrix
+    int N = SquareDim<T>(op);
 
     int LDA = FIX_LD(N);
 
@@ -240,13 +480,16 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
 
     // Allocate memory for the matrices
     const int alignment = 2 * 1024 * 1024;
-    A = (T *)_mm_malloc(matrix_bytes, alignment);
-    B = (T *)_mm_malloc(matrix_bytes, alignment);
-    C = (T *)_mm_malloc(matrix_bytes, alignment);
+    A = (T *)BackendAlloc(matrix_bytes, alignment);
+    B = (T *)BackendAlloc(matrix_bytes, alignment);
+    C = (T *)BackendAlloc(matrix_bytes, alignment);
 
     if(!A || !B || !C)
     {
         cerr << "memory allocation failed" << endl;
+        BackendFree(A);
+        BackendFree(B);
+        BackendFree(C);
         return;
     }
 
@@ -256,41 +499,37 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
     fill<T>(C, LDA * N, 31);
 
     // Allocate memory on the card and keep it around
-    #pragma offload target(MIC:micdev) \
-        in(A:length(matrix_elements)  free_if(0) ) \
-        in(B:length(matrix_elements)  free_if(0) ) \
-        in(C:length(matrix_elements)  free_if(0) ) \
-        out(C:length(matrix_elements) free_if(0) )
-    {
-    }
+    BackendCreate(op, A, matrix_bytes);
+    BackendCreate(op, B, matrix_bytes);
+    BackendCreate(op, C, matrix_bytes);
+    BackendCopyIn(op, C, matrix_bytes);
 
     // Timing variables
     double start_time, transfer_time;
 
     // Start the timer for the PCIe transfer
-    // curr_second is a gettimeofday() timer
     start_time = curr_second();
 
-    #pragma offload target(MIC:micdev) \
-        in(A:length(matrix_elements)  alloc_if(0) free_if(0)) \
-        in(B:length(matrix_elements)  alloc_if(0) free_if(0)) \
-        out(C:length(matrix_elements) alloc_if(0) free_if(0))
-    {
-    }
+    BackendCopyIn(op, A, matrix_bytes);
+    BackendCopyIn(op, B, matrix_bytes);
+    BackendCopyOut(op, C, matrix_bytes);
 
     transfer_time = curr_second() - start_time;
 
-    // Begin main test loop
-    for (; passes > 0; --passes)
+    // Matrices are cut down to a multiple of the block size
+    const int nb = 128;
+    const int idim = N / nb;
+    const int dim = idim * nb;
+
+    // Begin main test loop, repeated --passes times or until --rel-ci
+    Measurement meas(op);
+    while (!meas.Finished())
     {
         for (int i = 0; i < 2; i++)
         {
             // Set up all the variables for the GEMM call
             const char transa = 'N';
             const char transb = i ? 'T' : 'N';
-            const int nb = 128;
-            const int idim = N / nb;
-            int dim = idim * nb;
             const int m = dim;
             const int n = dim;
             const int k = dim;
@@ -298,30 +537,42 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
             const int ldb = FIX_LD(dim);
             const int ldc = FIX_LD(dim);
 
+            const string region = testName + "-" + transb;
+            if (meas.Done(region))
+            {
+                continue;
+            }
 
-            #pragma offload target(MIC:micdev) \
-                in(A:length(matrix_elements)  alloc_if(0) free_if(0))  \
-                in(B:length(matrix_elements)  alloc_if(0) free_if(0))  \
-                in(C:length(matrix_elements)  alloc_if(0) free_if(0))  \
-                out(C:length(matrix_elements) alloc_if(0) free_if(0))
+            BackendCopyIn(op, A, matrix_bytes);
+            BackendCopyIn(op, B, matrix_bytes);
+            BackendCopyIn(op, C, matrix_bytes);
+            #pragma offload target(MIC:micdev) if(useMIC) \
+                nocopy(A) nocopy(B) nocopy(C)
             {
                 const T alpha = 1;
                 const T beta = -1;
 
                 // Warm up, the reason of this # pragma loop is to load
                 // necessary libraries.
-                devGEMM<T>(transa, transb, m, n, k, alpha, A, lda, B, ldb,
-                        beta, C, ldc);
+                if (native)
+                {
+                    NativeGEMM<T>(isa, transa, transb, m, n, k, alpha, A, lda,
+                            B, ldb, beta, C, ldc);
+                }
+                else
+                {
+                    devGEMM<T>(transa, transb, m, n, k, alpha, A, lda, B, ldb,
+                            beta, C, ldc);
+                }
             }
+            BackendCopyOut(op, C, matrix_bytes);
 
             // Time it takes for the actual gemm call
-            double blas_time;
-            double startTime=curr_second();
-
             const T alpha = 1;
             const T beta = 0;
 
-            #pragma offload target(MIC:micdev) \
+            meas.Start(region);
+            #pragma offload target(MIC:micdev) if(useMIC) \
                             nocopy(A)          \
                             nocopy(B)          \
                             nocopy(C)
@@ -329,17 +580,35 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
                 // Do 4 iterations
                 for (int ii = 0; ii < 4; ++ii)
                 {
-                   devGEMM<T>(transa, transb, m, n, k, alpha, A, lda, B, ldb,
-                           beta, C, ldc);
+                   if (native)
+                   {
+                       NativeGEMM<T>(isa, transa, transb, m, n, k, alpha, A,
+                               lda, B, ldb, beta, C, ldc);
+                   }
+                   else
+                   {
+                       devGEMM<T>(transa, transb, m, n, k, alpha, A, lda, B,
+                               ldb, beta, C, ldc);
+                   }
                 }
             }
+            meas.Stop(region);
+        }
+    }
 
-            blas_time = (curr_second()-startTime)/4.0;
+    for (int i = 0; i < 2; i++)
+    {
+        const char transb = i ? 'T' : 'N';
+        const string region = testName + "-" + transb;
+        vector<double> times = meas.Samples(region);
+        for (int j = 0; j < times.size(); j++)
+        {
+            double blas_time = times[j] / 4.0;
 
             // Calculate GFLOPS
-            double blas_gflops = 2. * m * n * k / blas_time / 1e9;
-            double pcie_gflops = 2. * m * n * k / (blas_time + transfer_time)
-                / 1e9;
+            double blas_gflops = 2. * dim * dim * dim / blas_time / 1e9;
+            double pcie_gflops = 2. * dim * dim * dim /
+                (blas_time + transfer_time) / 1e9;
             resultDB.AddResult(testName+"-"+transb, toString(dim), "GFlops",
                     blas_gflops);
             resultDB.AddResult(testName+"-"+transb+"_PCIe", toString(dim),
@@ -347,19 +616,914 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
             resultDB.AddResult(testName+"-"+transb+"_Parity", toString(dim),
                     "N", transfer_time / blas_time);
         }
+        meas.RecordConfidence(resultDB, region, region, toString(dim));
+
+        // Compulsory traffic: read A and B, write C once
+        resultDB.SetWork(region, toString(dim), 2. * dim * dim * dim,
+                         3. * dim * dim * sizeof(T),
+                         sizeof(T) == sizeof(double) ? "DP" : "SP");
     }
 
     // Clean Up MIC storage
-    #pragma offload target(MIC:micdev) \
-        in(A:length(matrix_elements)  alloc_if(0)) \
-        in(B:length(matrix_elements)  alloc_if(0)) \
-        in(C:length(matrix_elements)  alloc_if(0)) \
-        out(C:length(matrix_elements) alloc_if(0))
+    BackendRelease(op, A, matrix_bytes);
+    BackendRelease(op, B, matrix_bytes);
+    BackendRelease(op, C, matrix_bytes);
+
+    // Clean up Host storage
+    BackendFree(A);
+    BackendFree(B);
+    BackendFree(C);
+}
+
+// ****************************************************************************
+// Function: ShapeCalls
+//
+// Purpose:
+//   Runs one point of the shape sweep reps times on the target: a single
+//   GEMM, or a batch of them.  Pointer batches address the matrices through
+//   arrays built from slot, which scatters them over the buffers; strided
+//   batches keep them back to back in call order.
+//
+// Arguments:
+//   native, isa: the in-tree GEMM and its micro-kernel, or MKL
+//   strided: use the strided batch call (MKL has no strided batch call, so
+//            it gets pointers to the consecutive matrices)
+//   m, n, k: the shape
+//   A, B, C, lda, ldb, ldc: buffers holding count matrices each
+//   strideA, strideB, strideC: elements between consecutive slots
+//   slot: buffer slot of each GEMM of the batch
+//   count: GEMMs in the batch (1: a plain GEMM call)
+//   reps: repetitions
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T>
+__declspec(target(MIC)) void ShapeCalls(bool native, int isa, bool strided,
+        int m, int n, int k, const T *A, int lda, long strideA, const T *B,
+        int ldb, long strideB, T *C, int ldc, long strideC, const int *slot,
+        int count, int reps)
+{
+    const T alpha = 1;
+    const T beta = 0;
+
+    if (count == 1)
     {
+        for (int r = 0; r < reps; r++)
+        {
+            if (native)
+                NativeGEMM<T>(isa, 'N', 'N', m, n, k, alpha, A, lda, B, ldb,
+                        beta, C, ldc);
+            else
+                devGEMM<T>('N', 'N', m, n, k, alpha, A, lda, B, ldb, beta,
+                        C, ldc);
+        }
+        return;
     }
 
-    // Clean up Host storage
-    _mm_free(A);
-    _mm_free(B);
-    _mm_free(C);
+    if (native && strided)
+    {
+        for (int r = 0; r < reps; r++)
+        {
+            NativeGEMMStridedBatch<T>(isa, 'N', 'N', m, n, k, alpha,
+                    A, lda, strideA, B, ldb, strideB, beta, C, ldc, strideC,
+                    count);
+        }
+        return;
+    }
+
+    const T **pA = new const T*[count];
+    const T **pB = new const T*[count];
+    T **pC = new T*[count];
+    for (int i = 0; i < count; i++)
+    {
+        pA[i] = A + slot[i] * strideA;
+        pB[i] = B + slot[i] * strideB;
+        pC[i] = C + slot[i] * strideC;
+    }
+    for (int r = 0; r < reps; r++)
+    {
+        if (native)
+            NativeGEMMBatch<T>(isa, 'N', 'N', m, n, k, alpha, pA, lda, pB,
+                    ldb, beta, pC, ldc, count);
+        else
+            devGEMMBatch<T>('N', 'N', m, n, k, alpha, pA, lda, pB, ldb,
+                    beta, pC, ldc, count);
+    }
+    delete[] pA;
+    delete[] pB;
+    delete[] pC;
+}
+
+// ****************************************************************************
+// Function: RunShapes
+//
+// Purpose:
+//   The shape sweep: GFLOPS of C = A * B for every MxNxK shape, either as
+//   one GEMM or, with --batch, as a batch of independent GEMMs in each of
+//   the --batch-layouts.  Every point is repeated until it has done about
+//   2 GFLOP, so small shapes are timed over many calls.
+//
+// Arguments:
+//   testName: SGEMM or DGEMM, with the implementation suffix
+//   resultDB: the benchmark stores its results in this ResultDatabase
+//   op: the options parser / parameter database
+//   native: run the in-tree GEMM instead of MKL
+//   shapes: the shapes to run
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T>
+void RunShapes(string testName, ResultDatabase &resultDB, OptionParser &op,
+        bool native, const vector<GemmShape> &shapes)
+{
+    const int micdev = op.getOptionInt("target");
+    const bool useMIC = UseOffload(op);
+    const int isa = GemmHostISA();
+    const int batch = max(1, (int)op.getOptionInt("batch"));
+
+    vector<string> layouts;
+    if (batch == 1)
+    {
+        layouts.push_back("single");
+    }
+    else
+    {
+        layouts = op.getOptionVecString("batch-layouts");
+        for (size_t i = 0; i < layouts.size(); i++)
+        {
+            if (layouts[i] != "pointer" && layouts[i] != "strided")
+            {
+                cerr << "Error: unknown batch layout \"" << layouts[i]
+                     << "\"\n";
+                return;
+            }
+        }
+    }
+
+    __declspec(target(MIC)) static T *A;
+    __declspec(target(MIC)) static T *B;
+    __declspec(target(MIC)) static T *C;
+    __declspec(target(MIC)) static int *slot;
+
+    for (size_t s = 0; s < shapes.size(); s++)
+    {
+        const int m = shapes[s].m;
+        const int n = shapes[s].n;
+        const int k = shapes[s].k;
+        const int lda = FIX_LD(k);
+        const int ldb = FIX_LD(n);
+        const int ldc = FIX_LD(n);
+        const long strideA = (long)m * lda;
+        const long strideB = (long)k * ldb;
+        const long strideC = (long)m * ldc;
+        const long elemsA = strideA * batch;
+        const long elemsB = strideB * batch;
+        const long elemsC = strideC * batch;
+
+        const double flops = 2. * m * n * k * batch;
+        const int reps = (int)min(10000., max(1., 2e9 / flops));
+
+        A = (T *)BackendAlloc(elemsA * sizeof(T), 64);
+        B = (T *)BackendAlloc(elemsB * sizeof(T), 64);
+        C = (T *)BackendAlloc(elemsC * sizeof(T), 64);
+        slot = (int *)BackendAlloc(batch * sizeof(int), 64);
+        if (!A || !B || !C || !slot)
+        {
+            cerr << "memory allocation failed" << endl;
+            BackendFree(A);
+            BackendFree(B);
+            BackendFree(C);
+            BackendFree(slot);
+            return;
+        }
+        fill<T>(A, elemsA, 31);
+        fill<T>(B, elemsB, 31);
+
+        for (size_t l = 0; l < layouts.size(); l++)
+        {
+            const bool strided = layouts[l] != "pointer";
+
+            // Pointer batches visit the slots in random order
+            for (int i = 0; i < batch; i++)
+            {
+                slot[i] = i;
+            }
+            if (!strided)
+            {
+                for (int i = batch - 1; i > 0; i--)
+                {
+                    swap(slot[i], slot[rand() % (i + 1)]);
+                }
+            }
+
+            BackendCreate(op, A, elemsA * sizeof(T));
+            BackendCreate(op, B, elemsB * sizeof(T));
+            BackendCreate(op, C, elemsC * sizeof(T));
+            BackendCreate(op, slot, batch * sizeof(int));
+            BackendCopyIn(op, A, elemsA * sizeof(T));
+            BackendCopyIn(op, B, elemsB * sizeof(T));
+            BackendCopyIn(op, slot, batch * sizeof(int));
+
+            #pragma offload target(MIC:micdev) if(useMIC) \
+                nocopy(A) nocopy(B) nocopy(C) nocopy(slot)
+            {
+                // Warm up
+                ShapeCalls<T>(native, isa, strided, m, n, k, A, lda, strideA,
+                        B, ldb, strideB, C, ldc, strideC, slot, batch, 1);
+            }
+
+            string test = testName;
+            char atts[64];
+            if (batch == 1)
+            {
+                test += "_Shape";
+                sprintf(atts, "%dx%dx%d", m, n, k);
+            }
+            else
+            {
+                test += strided ? "_BatchStrided" : "_BatchPointer";
+                sprintf(atts, "%dx%dx%d Batch:%d", m, n, k, batch);
+            }
+            const string region = test + " " + atts;
+
+            Measurement meas(op);
+            while (!meas.Finished())
+            {
+                if (meas.Done(region))
+                {
+                    continue;
+                }
+                meas.Start(region);
+                #pragma offload target(MIC:micdev) if(useMIC) \
+                    nocopy(A) nocopy(B) nocopy(C) nocopy(slot)
+                {
+                    ShapeCalls<T>(native, isa, strided, m, n, k, A, lda,
+                            strideA, B, ldb, strideB, C, ldc, strideC, slot,
+                            batch, reps);
+                }
+                meas.Stop(region);
+            }
+
+            vector<double> times = meas.Samples(region);
+            for (size_t j = 0; j < times.size(); j++)
+            {
+                resultDB.AddResult(test, atts, "GFlops",
+                        flops * reps / times[j] / 1e9);
+            }
+            meas.RecordConfidence(resultDB, region, test, atts);
+            resultDB.SetWork(test, atts, flops,
+                    ((double)m * k + (double)k * n + (double)m * n) * batch *
+                    sizeof(T),
+                    sizeof(T) == sizeof(double) ? "DP" : "SP");
+
+            // Free the card copies
+            BackendRelease(op, A, elemsA * sizeof(T));
+            BackendRelease(op, B, elemsB * sizeof(T));
+            BackendRelease(op, C, elemsC * sizeof(T));
+            BackendRelease(op, slot, batch * sizeof(int));
+        }
+
+        BackendFree(A);
+        BackendFree(B);
+        BackendFree(C);
+        BackendFree(slot);
+    }
 }
+
+// Rounds a reference value into the storage type of a reduced-precision
+// input
+inline void ToInput(double x, bf16 &y)        { y = FloatToBF16((float)x); }
+inline void ToInput(double x, fp16 &y)        { y = FloatToFP16((float)x); }
+inline void ToInput(double x, signed char &y) { y = (signed char)x; }
+
+// ****************************************************************************
+// Function: RunReducedTest
+//
+// Purpose:
+//   Square C = A * B with A and B stored as Ti and C accumulated as T, on
+//   the native GEMM: bf16 or fp16 into float, or int8 into int32.  After
+//   timing, a sample of rows of C is checked against a double precision
+//   product of the same (rounded) inputs.  The error of each element is
+//   taken relative to the sum of the magnitudes of its products, which
+//   float accumulation keeps below dim times the unit roundoff; integer
+//   accumulation must be exact.
+//
+// Arguments:
+//   testName: result name, such as BF16GEMM
+//   resultDB: the benchmark stores its results in this ResultDatabase
+//   op: the options parser / parameter database
+//   units: GFlops or GOps
+//   precision: ceiling of the roofline report, or NULL for none
+//   roundoff: unit roundoff of T, 0 for integers
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T, class Ti>
+void RunReducedTest(string testName, ResultDatabase &resultDB,
+        OptionParser &op, const char *units, const char *precision,
+        double roundoff)
+{
+    const int micdev = op.getOptionInt("target");
+    const bool useMIC = UseOffload(op);
+    const int isa = GemmHostISA();
+
+    // Same sizes as SGEMM, cut down to a multiple of the block size
+    const int dim = SquareDim<T>(op) / 128 * 128;
+    const int ld = FIX_LD(dim);
+    const size_t elems = (size_t)ld * dim;
+
+    __declspec(target(MIC)) static Ti *A;
+    __declspec(target(MIC)) static Ti *B;
+    __declspec(target(MIC)) static T *C;
+
+    A = (Ti *)BackendAlloc(elems * sizeof(Ti), 64);
+    B = (Ti *)BackendAlloc(elems * sizeof(Ti), 64);
+    C = (T *)BackendAlloc(elems * sizeof(T), 64);
+    if (!A || !B || !C)
+    {
+        cerr << "memory allocation failed" << endl;
+        BackendFree(A);
+        BackendFree(B);
+        BackendFree(C);
+        return;
+    }
+
+    // Integers in [-127, 127], or fractions in (-1, 1) that need rounding
+    for (size_t i = 0; i < elems; i++)
+    {
+        if (roundoff == 0.)
+        {
+            ToInput((double)(rand() % 255 - 127), A[i]);
+            ToInput((double)(rand() % 255 - 127), B[i]);
+        }
+        else
+        {
+            ToInput((rand() % 2001 - 1000) / 1001., A[i]);
+            ToInput((rand() % 2001 - 1000) / 1001., B[i]);
+        }
+    }
+
+    BackendCreate(op, A, elems * sizeof(Ti));
+    BackendCreate(op, B, elems * sizeof(Ti));
+    BackendCreate(op, C, elems * sizeof(T));
+    BackendCopyIn(op, A, elems * sizeof(Ti));
+    BackendCopyIn(op, B, elems * sizeof(Ti));
+
+    #pragma offload target(MIC:micdev) if(useMIC) \
+        nocopy(A) nocopy(B) nocopy(C)
+    {
+        // Warm up
+        NativeGEMM<T, Ti>(isa, 'N', 'N', dim, dim, dim, (T)1, A, ld, B, ld,
+                (T)0, C, ld);
+    }
+
+    const string test = testName + "-N";
+    const string atts = toString(dim);
+    Measurement meas(op);
+    while (!meas.Finished())
+    {
+        if (meas.Done(test))
+        {
+            continue;
+        }
+        meas.Start(test);
+        #pragma offload target(MIC:micdev) if(useMIC) \
+            nocopy(A) nocopy(B) nocopy(C)
+        {
+            // Do 4 iterations
+            for (int ii = 0; ii < 4; ++ii)
+            {
+                NativeGEMM<T, Ti>(isa, 'N', 'N', dim, dim, dim, (T)1, A, ld,
+                        B, ld, (T)0, C, ld);
+            }
+        }
+        meas.Stop(test);
+    }
+
+    BackendCopyOut(op, C, elems * sizeof(T));
+    BackendRelease(op, A, elems * sizeof(Ti));
+    BackendRelease(op, B, elems * sizeof(Ti));
+    BackendRelease(op, C, elems * sizeof(T));
+
+    vector<double> times = meas.Samples(test);
+    for (size_t j = 0; j < times.size(); j++)
+    {
+        resultDB.AddResult(test, atts, units,
+                2. * dim * dim * dim / (times[j] / 4.0) / 1e9);
+    }
+    meas.RecordConfidence(resultDB, test, test, atts);
+    if (precision)
+    {
+        resultDB.SetWork(test, atts, 2. * dim * dim * dim,
+                2. * dim * dim * sizeof(Ti) + (double)dim * dim * sizeof(T),
+                precision);
+    }
+
+    // Check 16 rows spread over C against the double precision product
+    double maxError = 0.;
+    for (int r = 0; r < 16; r++)
+    {
+        const int i = (int)((long)r * (dim - 1) / 15);
+        for (int j = 0; j < dim; j++)
+        {
+            double exact = 0., magnitude = 0.;
+            for (int p = 0; p < dim; p++)
+            {
+                const double prod = (double)GemmWiden(A[(size_t)i * ld + p]) *
+                                    (double)GemmWiden(B[(size_t)p * ld + j]);
+                exact += prod;
+                magnitude += fabs(prod);
+            }
+            const double error = fabs((double)C[(size_t)i * ld + j] - exact);
+            maxError = max(maxError,
+                           magnitude > 0. ? error / magnitude : error);
+        }
+    }
+    resultDB.AddResult(test + "_MaxRelError", atts, "rel", maxError);
+    if (maxError > dim * roundoff)
+    {
+        cerr << "Error: " << test << " failed the accuracy check (relative "
+             << "error " << maxError << ", bound " << dim * roundoff << ")"
+             << endl;
+    }
+
+    BackendFree(A);
+    BackendFree(B);
+    BackendFree(C);
+}
+
+// ****************************************************************************
+// Function: TileGEMM
+//
+// Purpose:
+//   One step of the out-of-core GEMM on the target: C += A * B (or C = A * B
+//   for the first step of a tile) on contiguous tile x tile blocks.
+//
+// Arguments:
+//   native, isa: the in-tree GEMM and its micro-kernel, or MKL
+//   tile: tile dimension
+//   A, B, C: the tiles
+//   first: whether this is the first step of the C tile
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T>
+__declspec(target(MIC)) void TileGEMM(bool native, int isa, int tile,
+        const T *A, const T *B, T *C, bool first)
+{
+    const T alpha = 1;
+    const T beta = first ? 0 : 1;
+    if (native)
+        NativeGEMM<T>(isa, 'N', 'N', tile, tile, tile, alpha, A, tile, B,
+                tile, beta, C, tile);
+    else
+        devGEMM<T>('N', 'N', tile, tile, tile, alpha, A, tile, B, tile, beta,
+                C, tile);
+}
+
+// ****************************************************************************
+// Function: SendStep
+//
+// Purpose:
+//   Sends the A and B tiles of one step of the out-of-core GEMM into the
+//   card slot of that step's parity.  Step s computes C tile s / nt with
+//   k-panel s % nt.
+//
+// Arguments:
+//   step: the step
+//   nt: tiles per matrix dimension
+//   tileElems: elements per tile
+//   A, B: host matrices, tile by tile
+//   dA, dB: two-slot tile buffers on the card
+//   micdev, useMIC: target card, or the host
+//   tag: signal the transfer completes with, or NULL to wait for it
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T>
+void SendStep(int step, int nt, size_t tileElems, T *A, T *B, T *dA, T *dB,
+        int micdev, bool useMIC, char *tag)
+{
+    const int c = step / nt;
+    const int p = step % nt;
+    const size_t aOff = ((size_t)(c / nt) * nt + p) * tileElems;
+    const size_t bOff = ((size_t)p * nt + c % nt) * tileElems;
+    const size_t slot = (step & 1) * tileElems;
+
+    if (!useMIC)
+    {
+        memcpy(dA + slot, A + aOff, tileElems * sizeof(T));
+        memcpy(dB + slot, B + bOff, tileElems * sizeof(T));
+    }
+    else if (tag)
+    {
+        #pragma offload_transfer target(MIC:micdev) \
+            in(A[aOff:tileElems] : into(dA[slot:tileElems]) alloc_if(0) \
+               free_if(0)) \
+            in(B[bOff:tileElems] : into(dB[slot:tileElems]) alloc_if(0) \
+               free_if(0)) \
+            signal(tag)
+    }
+    else
+    {
+        #pragma offload_transfer target(MIC:micdev) \
+            in(A[aOff:tileElems] : into(dA[slot:tileElems]) alloc_if(0) \
+               free_if(0)) \
+            in(B[bOff:tileElems] : into(dB[slot:tileElems]) alloc_if(0) \
+               free_if(0))
+    }
+}
+
+// Host stand-in for the card in the out-of-core GEMM: tile slots the
+// OpenMP team multiplies in, filled and drained by a copy thread the way
+// the DMA engines serve the card
+template <class T>
+struct HostTilePipeline
+{
+    T     *A, *B, *C;
+    T     *dA, *dB, *dC;
+    int    nt;
+    int    tile;
+    size_t tileElems;
+    int    steps;
+    bool   native;
+    int    isa;
+    pthread_barrier_t step;
+};
+
+template <class T>
+static void HostTileCompute(HostTilePipeline<T> *p, int s)
+{
+    const size_t abSlot = (s & 1) * p->tileElems;
+    const size_t cSlot = ((s / p->nt) & 1) * p->tileElems;
+    TileGEMM<T>(p->native, p->isa, p->tile, p->dA + abSlot, p->dB + abSlot,
+            p->dC + cSlot, s % p->nt == 0);
+}
+
+// Sends C tile c back to its place in C
+template <class T>
+static void HostTileStore(HostTilePipeline<T> *p, int c)
+{
+    memcpy(p->C + (size_t)c * p->tileElems,
+           p->dC + (c & 1) * p->tileElems, p->tileElems * sizeof(T));
+}
+
+// Round r loads step r into slot r&1 and stores the C tile step r-2
+// finished, while the team computes step r-1 in the other slot
+template <class T>
+static void *HostTileCopier(void *arg)
+{
+    HostTilePipeline<T> *p = (HostTilePipeline<T> *)arg;
+    for (int r = 0; r < p->steps + 2; r++)
+    {
+        if (r < p->steps)
+            SendStep<T>(r, p->nt, p->tileElems, p->A, p->B, p->dA, p->dB,
+                    0, false, NULL);
+        if (r >= 2 && (r - 2) % p->nt == p->nt - 1)
+            HostTileStore(p, (r - 2) / p->nt);
+        pthread_barrier_wait(&p->step);
+    }
+    return NULL;
+}
+
+template <class T>
+static void HostOutOfCorePipelined(HostTilePipeline<T> *p)
+{
+    pthread_t copier;
+    pthread_barrier_init(&p->step, NULL, 2);
+    pthread_create(&copier, NULL, HostTileCopier<T>, p);
+    for (int r = 0; r < p->steps + 2; r++)
+    {
+        if (r >= 1 && r <= p->steps)
+            HostTileCompute(p, r - 1);
+        pthread_barrier_wait(&p->step);
+    }
+    pthread_join(copier, NULL);
+    pthread_barrier_destroy(&p->step);
+}
+
+template <class T>
+static void HostOutOfCoreSerial(HostTilePipeline<T> *p)
+{
+    for (int s = 0; s < p->steps; s++)
+    {
+        SendStep<T>(s, p->nt, p->tileElems, p->A, p->B, p->dA, p->dB, 0,
+                false, NULL);
+        HostTileCompute(p, s);
+        if (s % p->nt == p->nt - 1)
+            HostTileStore(p, s / p->nt);
+    }
+}
+
+// ****************************************************************************
+// Function: CheckOutOfCore
+//
+// Purpose:
+//   Spot checks 16 elements of an out-of-core product against a double
+//   precision dot product.
+//
+// Arguments:
+//   test: the test the product came from
+//   A, B, C: host matrices, tile by tile
+//   nt: tiles per matrix dimension
+//   tile: tile dimension
+//
+// Returns:  false, after printing the first wrong element, if one is off
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T>
+bool CheckOutOfCore(const string &test, const T *A, const T *B, const T *C,
+        int nt, int tile)
+{
+    const int dim = nt * tile;
+    const size_t tileElems = (size_t)tile * tile;
+    const double roundoff = sizeof(T) == sizeof(float) ? FLT_EPSILON / 2
+                                                       : DBL_EPSILON / 2;
+    for (int e = 0; e < 16; e++)
+    {
+        const int i = (int)((long)e * 7919 % dim);
+        const int j = (int)((long)e * 104729 % dim);
+        double exact = 0., magnitude = 0.;
+        for (int k = 0; k < dim; k++)
+        {
+            const double prod =
+                A[((size_t)(i / tile) * nt + k / tile) * tileElems +
+                  (size_t)(i % tile) * tile + k % tile] *
+                (double)B[((size_t)(k / tile) * nt + j / tile) * tileElems +
+                          (size_t)(k % tile) * tile + j % tile];
+            exact += prod;
+            magnitude += fabs(prod);
+        }
+        const double got = C[((size_t)(i / tile) * nt + j / tile) *
+                             tileElems + (size_t)(i % tile) * tile +
+                             j % tile];
+        if (fabs(got - exact) > dim * roundoff * magnitude)
+        {
+            cerr << "Error: " << test << " C(" << i << "," << j
+                 << ") is " << got << ", expected " << exact << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// ****************************************************************************
+// Function: RunOutOfCore
+//
+// Purpose:
+//   GEMM on matrices that stay in host memory, stored tile by tile, and
+//   pass through the card a tile at a time.  Every C tile is the sum over
+//   the k-panel of A tile times B tile products.  The pipelined version
+//   keeps two slots for the A and B tiles: while the card works on one
+//   pair, the next pair is sent into the other slot.  C tiles also have two
+//   slots, so a finished tile comes back while the card starts the next
+//   one.  Only six tiles ever live on the card.  The serial version moves
+//   the same tiles without overlap.  On the host backend a copy thread
+//   moves the tiles between the matrices and the slots while the OpenMP
+//   team multiplies.  Both report GFLOPS over the whole run, transfers
+//   included, and the first run of each is spot checked.
+//
+// Arguments:
+//   testName: SGEMM or DGEMM, with the implementation suffix
+//   resultDB: the benchmark stores its results in this ResultDatabase
+//   op: the options parser / parameter database
+//   native: run the in-tree GEMM instead of MKL
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T>
+void RunOutOfCore(string testName, ResultDatabase &resultDB,
+        OptionParser &op, bool native)
+{
+    const int micdev = op.getOptionInt("target");
+    const bool useMIC = UseOffload(op);
+    const int isa = GemmHostISA();
+
+    // By default the tile is the square test's matrix
+    int tile = op.getOptionInt("ooc-tile");
+    if (tile <= 0)
+    {
+        tile = max(128, SquareDim<T>(op) / 128 * 128);
+    }
+    const int nt = max(1, (int)op.getOptionInt("ooc-tiles"));
+    const int dim = nt * tile;
+    const size_t tileElems = (size_t)tile * tile;
+    const size_t elems = tileElems * nt * nt;
+
+    // Host matrices, tile (i, j) at ((i * nt) + j) * tileElems
+    T *A = (T *)BackendAlloc(elems * sizeof(T), 2 * 1024 * 1024);
+    T *B = (T *)BackendAlloc(elems * sizeof(T), 2 * 1024 * 1024);
+    T *C = (T *)BackendAlloc(elems * sizeof(T), 2 * 1024 * 1024);
+
+    // Two slots per operand; on the card these are the only copies
+    __declspec(target(MIC)) static T *dA;
+    __declspec(target(MIC)) static T *dB;
+    __declspec(target(MIC)) static T *dC;
+    const size_t slotBytes = 2 * tileElems * sizeof(T);
+    dA = (T *)BackendAlloc(slotBytes, 64);
+    dB = (T *)BackendAlloc(slotBytes, 64);
+    dC = (T *)BackendAlloc(slotBytes, 64);
+
+    if (!A || !B || !C || !dA || !dB || !dC)
+    {
+        cerr << "memory allocation failed" << endl;
+        BackendFree(A);
+        BackendFree(B);
+        BackendFree(C);
+        BackendFree(dA);
+        BackendFree(dB);
+        BackendFree(dC);
+        return;
+    }
+    fill<T>(A, elems, 31);
+    fill<T>(B, elems, 31);
+
+    BackendCreate(op, dA, slotBytes);
+    BackendCreate(op, dB, slotBytes);
+    BackendCreate(op, dC, slotBytes);
+
+    // Completion tags of the transfers into each A/B slot and out of each
+    // C slot
+    static char abTag[2], cTag[2];
+
+    char atts[64];
+    sprintf(atts, "%d Tile:%d", dim, tile);
+    const string tests[2] = { testName + "_OutOfCore",
+                              testName + "_OutOfCoreSerial" };
+    const int steps = nt * nt * nt;
+
+    HostTilePipeline<T> host;
+    host.A = A;
+    host.B = B;
+    host.C = C;
+    host.dA = dA;
+    host.dB = dB;
+    host.dC = dC;
+    host.nt = nt;
+    host.tile = tile;
+    host.tileElems = tileElems;
+    host.steps = steps;
+    host.native = native;
+    host.isa = isa;
+
+    // The first run of each variant starts from a cleared C and is checked
+    bool checked[2] = { false, false };
+
+    Measurement meas(op);
+    while (!meas.Finished())
+    {
+        for (int v = 0; v < 2; v++)
+        {
+            const bool overlap = v == 0;
+            if (meas.Done(tests[v]))
+            {
+                continue;
+            }
+            if (!checked[v])
+            {
+                memset(C, 0, elems * sizeof(T));
+            }
+            meas.Start(tests[v]);
+
+            if (!useMIC)
+            {
+                // A copy thread stands in for the card's DMA engines
+                if (overlap)
+                    HostOutOfCorePipelined<T>(&host);
+                else
+                    HostOutOfCoreSerial<T>(&host);
+            }
+            else
+            {
+                bool cPending[2] = { false, false };
+                for (int s = 0; s < steps; s++)
+                {
+                    // Serially every step sends its own tiles; pipelined, the
+                    // first step does, then each sends the next step's
+                    if (!overlap || s == 0)
+                    {
+                        SendStep<T>(s, nt, tileElems, A, B, dA, dB, micdev,
+                                useMIC, overlap ? &abTag[s & 1] : NULL);
+                    }
+                    if (overlap && s + 1 < steps)
+                    {
+                        SendStep<T>(s + 1, nt, tileElems, A, B, dA, dB, micdev,
+                                useMIC, &abTag[(s + 1) & 1]);
+                    }
+
+                    const int c = s / nt;
+                    const int p = s % nt;
+                    const int ab = s & 1;
+                    const int cs = c & 1;
+                    const size_t abSlot = ab * tileElems;
+                    const size_t cSlot = cs * tileElems;
+
+                    // The C slot is free once its previous tile is back
+                    if (p == 0 && cPending[cs])
+                    {
+                        #pragma offload_wait target(MIC:micdev) wait(&cTag[cs])
+                        cPending[cs] = false;
+                    }
+
+                    if (overlap)
+                    {
+                        #pragma offload target(MIC:micdev) wait(&abTag[ab]) \
+                            nocopy(dA, dB, dC)
+                        {
+                            TileGEMM<T>(native, isa, tile, dA + abSlot,
+                                    dB + abSlot, dC + cSlot, p == 0);
+                        }
+                    }
+                    else
+                    {
+                        #pragma offload target(MIC:micdev) nocopy(dA, dB, dC)
+                        {
+                            TileGEMM<T>(native, isa, tile, dA + abSlot,
+                                    dB + abSlot, dC + cSlot, p == 0);
+                        }
+                    }
+
+                    // A finished C tile goes back to its place in C
+                    if (p == nt - 1)
+                    {
+                        const size_t cOff = (size_t)c * tileElems;
+                        if (overlap)
+                        {
+                            #pragma offload_transfer target(MIC:micdev) \
+                                out(dC[cSlot:tileElems] : \
+                                    into(C[cOff:tileElems]) alloc_if(0) \
+                                    free_if(0)) \
+                                signal(&cTag[cs])
+                            cPending[cs] = true;
+                        }
+                        else
+                        {
+                            #pragma offload_transfer target(MIC:micdev) \
+                                out(dC[cSlot:tileElems] : \
+                                    into(C[cOff:tileElems]) alloc_if(0) \
+                                    free_if(0))
+                        }
+                    }
+                }
+                for (int cs = 0; cs < 2; cs++)
+                {
+                    if (cPending[cs])
+                    {
+                        #pragma offload_wait target(MIC:micdev) wait(&cTag[cs])
+                    }
+                }
+            }
+            meas.Stop(tests[v]);
+
+            if (!checked[v])
+            {
+                CheckOutOfCore<T>(tests[v], A, B, C, nt, tile);
+                checked[v] = true;
+            }
+        }
+    }
+
+    for (int v = 0; v < 2; v++)
+    {
+        vector<double> times = meas.Samples(tests[v]);
+        for (size_t j = 0; j < times.size(); j++)
+        {
+            resultDB.AddResult(tests[v], atts, "GFlops",
+                    2. * dim * dim * dim / times[j] / 1e9);
+        }
+        meas.RecordConfidence(resultDB, tests[v], tests[v], atts);
+    }
+
+    BackendRelease(op, dA, slotBytes);
+    BackendRelease(op, dB, slotBytes);
+    BackendRelease(op, dC, slotBytes);
+
+    BackendFree(A);
+    BackendFree(B);
+    BackendFree(C);
+    BackendFree(dA);
+    BackendFree(dB);
+    BackendFree(dC);
+}
+
+SHOC_REGISTER_BENCHMARK(GEMM);
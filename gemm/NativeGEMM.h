@@ -0,0 +1,566 @@
+// This example from an alpha release of the Scalable HeterOgeneous Computing
+// (SHOC) Benchmark Suite Alpha v1.1.4a-mic for Intel MIC architecture
+// Contact: Kyle Spafford <kys@ornl.gov>
+//          Rezaur Rahman <rezaur.rahman@intel.com>
+//
+// Copyright (c) 2011, UT-Battelle, LLC
+// Copyright (c) 2013, Intel Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of Oak Ridge National Laboratory, nor UT-Battelle, LLC,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this software without specific prior written
+//    permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef NATIVE_GEMM_H
+#define NATIVE_GEMM_H
+
+#include <string.h>
+#include "omp.h"
+#include "offload.h"
+#include "HostCPU.h"
+#include "ReducedPrecision.h"
+
+// ****************************************************************************
+// File:  NativeGEMM.h
+//
+// Purpose:
+//   A row-major GEMM, C = alpha * op(A) * op(B) + beta * C, that needs no
+//   BLAS library.  It follows the BLIS structure: op(B) is packed KC rows
+//   at a time into panels NR columns wide and op(A) into panels MR rows
+//   high, so the micro-kernel streams both from contiguous, aligned memory
+//   and keeps an MR x NR block of C in vector registers for KC rank-1
+//   updates.  The OpenMP team splits C into tiles of MC rows by NT columns
+//   for the micro-kernel loops; batches of small GEMMs are instead split
+//   matrix by matrix.
+//
+//   The micro-kernel is written with GCC vector extensions and specialized
+//   for each register width.  On the host the SSE, AVX2 and AVX-512
+//   versions are compiled with function target attributes and picked with
+//   CPUID; on the card only the 512-bit version exists.
+//
+//   The inputs may be stored in a narrower type than the one the kernel
+//   computes in (bf16 or fp16 for float, int8 for int32).  Packing widens
+//   them, so the same micro-kernels accumulate in full precision.
+//
+// Creation:    October 16, 2026
+//
+// ****************************************************************************
+enum GemmISA
+{
+    GEMM_SSE,
+    GEMM_AVX2,
+    GEMM_AVX512,
+    NUM_GEMM_ISAS
+};
+
+static const char *gemmISANames[NUM_GEMM_ISAS] = { "sse", "avx2", "avx512" };
+
+// Cache blocking, in elements: a KC x NT slice of packed B and an MC x KC
+// block of packed A are what one tile touches, sized for the L2 cache of
+// either the card or a host core.  MC is a multiple of every MR below.
+#define GEMM_KC 256
+#define GEMM_MC 96
+#define GEMM_NC 4096
+#define GEMM_NT 384
+#define GEMM_MAX_MR 8
+
+// The micro-kernel is inlined into the per-ISA entry points below, so it
+// is compiled for that entry point's target
+#define SHOC_GEMM_INLINE inline __attribute__((always_inline))
+
+// Widest micro-kernel this host can run; the card always uses 512 bits
+static GemmISA GemmHostISA()
+{
+    if (HostSupports(ISA_AVX512))
+        return GEMM_AVX512;
+    if (HostSupports(ISA_AVX2))
+        return GEMM_AVX2;
+    return GEMM_SSE;
+}
+
+#pragma offload_attribute(push, target(mic))
+
+// Widens a stored input element to the type the micro-kernel computes in
+static inline float  GemmWiden(float x)       { return x; }
+static inline double GemmWiden(double x)      { return x; }
+static inline float  GemmWiden(bf16 x)        { return BF16ToFloat(x); }
+static inline float  GemmWiden(fp16 x)        { return FP16ToFloat(x); }
+static inline int    GemmWiden(signed char x) { return x; }
+
+// ****************************************************************************
+// Function: GemmPackA
+//
+// Purpose:
+//   Copies rows [i0, i0+MR) and columns [p0, p0+kc) of op(A) into one
+//   panel, column by column, widened to T and padding rows past m with
+//   zeros.
+//
+// Arguments:
+//   A, rsA, csA: op(A)(i, p) is A[i*rsA + p*csA]
+//   m: rows of op(A)
+//   i0, p0: top left corner of the panel
+//   kc: columns in the panel
+//   panel: MR * kc elements
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T, class Ti, int MR>
+static SHOC_GEMM_INLINE void GemmPackA(const Ti *A, long rsA, long csA, int m,
+                                       int i0, int p0, int kc, T *panel)
+{
+    const int rows = m - i0 < MR ? m - i0 : MR;
+    for (int p = 0; p < kc; p++)
+    {
+        const Ti *src = A + (long)i0 * rsA + (long)(p0 + p) * csA;
+        for (int i = 0; i < rows; i++)
+            panel[p * MR + i] = GemmWiden(src[i * rsA]);
+        for (int i = rows; i < MR; i++)
+            panel[p * MR + i] = 0;
+    }
+}
+
+// Same for NR columns of op(B), row by row, padding columns past n
+template <class T, class Ti, int NR>
+static SHOC_GEMM_INLINE void GemmPackB(const Ti *B, long rsB, long csB, int n,
+                                       int j0, int p0, int kc, T *panel)
+{
+    const int cols = n - j0 < NR ? n - j0 : NR;
+    for (int p = 0; p < kc; p++)
+    {
+        const Ti *src = B + (long)(p0 + p) * rsB + (long)j0 * csB;
+        for (int j = 0; j < cols; j++)
+            panel[p * NR + j] = GemmWiden(src[j * csB]);
+        for (int j = cols; j < NR; j++)
+            panel[p * NR + j] = 0;
+    }
+}
+
+// ****************************************************************************
+// Function: GemmMicroKernel
+//
+// Purpose:
+//   Accumulates an MR x NR block of op(A) * op(B) over kc packed columns in
+//   registers (MR rows of two vectors), then merges it into C.  The partial
+//   blocks at the right and bottom edges go through a buffer so that only
+//   their mr x nr valid elements are written.
+//
+// Arguments:
+//   kc: length of the dot products
+//   a, b: the packed A and B panels
+//   C, ldc: top left element of the block and row stride of C
+//   alpha, beta: C = alpha * AB + beta * C; C is not read if beta is 0
+//   mr, nr: valid rows and columns of the block
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T, class V, int MR>
+static SHOC_GEMM_INLINE void GemmMicroKernel(int kc, const T *a, const T *b,
+    T *C, long ldc, T alpha, T beta, int mr, int nr)
+{
+    const int L = sizeof(V) / sizeof(T);
+    const int NR = 2 * L;
+
+    // Two named vectors per row: arrays indexed by vector would be kept
+    // on the stack
+    V acc0[MR], acc1[MR];
+    for (int i = 0; i < MR; i++)
+    {
+        acc0[i] = (V){};
+        acc1[i] = (V){};
+    }
+
+    for (int p = 0; p < kc; p++)
+    {
+        const V b0 = *(const V *)(b + p * NR);
+        const V b1 = *(const V *)(b + p * NR + L);
+        for (int i = 0; i < MR; i++)
+        {
+            const T ai = a[p * MR + i];
+            acc0[i] += ai * b0;
+            acc1[i] += ai * b1;
+        }
+    }
+
+    if (mr == MR && nr == NR)
+    {
+        for (int i = 0; i < MR; i++)
+        {
+            T *c = C + i * ldc;
+            V c0 = alpha * acc0[i];
+            V c1 = alpha * acc1[i];
+            if (beta != (T)0)
+            {
+                V old0, old1;
+                memcpy(&old0, c, sizeof(V));
+                memcpy(&old1, c + L, sizeof(V));
+                c0 += beta * old0;
+                c1 += beta * old1;
+            }
+            memcpy(c, &c0, sizeof(V));
+            memcpy(c + L, &c1, sizeof(V));
+        }
+    }
+    else
+    {
+        T buf[MR * NR] __attribute__((aligned(64)));
+        for (int i = 0; i < MR; i++)
+        {
+            *(V *)(buf + i * NR) = acc0[i];
+            *(V *)(buf + i * NR + L) = acc1[i];
+        }
+        for (int i = 0; i < mr; i++)
+        {
+            for (int j = 0; j < nr; j++)
+            {
+                T *c = C + i * ldc + j;
+                *c = alpha * buf[i * NR + j] +
+                     (beta != (T)0 ? beta * *c : (T)0);
+            }
+        }
+    }
+}
+
+// One GEMM call's arguments, in cblas_?gemm order; A and B are stored as Ti
+template <class T, class Ti>
+struct GemmProblem
+{
+    char transa, transb;
+    int m, n, k;
+    T alpha;
+    const Ti *A;
+    int lda;
+    const Ti *B;
+    int ldb;
+    T beta;
+    T *C;
+    int ldc;
+};
+
+// ****************************************************************************
+// Function: GemmBlocked
+//
+// Purpose:
+//   Called by every thread of a team: loops over NC-column blocks of C and
+//   KC-deep slices of the product, packs the slice of op(A) and op(B)
+//   cooperatively, then shares the MC x NT tiles of the block out to the
+//   threads.  Each tile walks its NR-wide B panels against every MR-high A
+//   panel of its rows.  Work is split by thread number rather than with
+//   OpenMP worksharing, so one thread can also run a whole GEMM on its own
+//   inside a larger parallel region.
+//
+// Arguments:
+//   p: the GEMM
+//   Ap, Bp: packing buffers shared by the team, for m rows rounded up to
+//   MR times KC, and KC times NC columns rounded up to NR
+//   tid, nThreads: this thread's number and the team size
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T, class Ti, class V, int MR>
+static SHOC_GEMM_INLINE void GemmBlocked(const GemmProblem<T, Ti> &p, T *Ap,
+                                         T *Bp, int tid, int nThreads)
+{
+    const int NR = 2 * (int)(sizeof(V) / sizeof(T));
+    const int m = p.m, n = p.n, k = p.k;
+
+    if (k <= 0)
+    {
+        // Nothing to accumulate, only the scaling of C
+        for (int i = tid; i < m; i += nThreads)
+            for (int j = 0; j < n; j++)
+                p.C[(long)i * p.ldc + j] = p.beta == (T)0 ? (T)0 :
+                                           p.beta * p.C[(long)i * p.ldc + j];
+        return;
+    }
+
+    // Row-major: op(X)(r, c) = X[r*rs + c*cs]
+    const long rsA = p.transa == 'N' ? p.lda : 1;
+    const long csA = p.transa == 'N' ? 1 : p.lda;
+    const long rsB = p.transb == 'N' ? p.ldb : 1;
+    const long csB = p.transb == 'N' ? 1 : p.ldb;
+
+    const int mPanels = (m + MR - 1) / MR;
+    const int mTiles = (m + GEMM_MC - 1) / GEMM_MC;
+
+    for (int jc = 0; jc < n; jc += GEMM_NC)
+    {
+        const int nc = n - jc < GEMM_NC ? n - jc : GEMM_NC;
+        const int nPanels = (nc + NR - 1) / NR;
+        const int nTiles = (nc + GEMM_NT - 1) / GEMM_NT;
+
+        for (int pc = 0; pc < k; pc += GEMM_KC)
+        {
+            const int kc = k - pc < GEMM_KC ? k - pc : GEMM_KC;
+
+            // Only the first slice scales the old C
+            const T betaSlice = pc == 0 ? p.beta : (T)1;
+
+            for (int ip = tid; ip < mPanels; ip += nThreads)
+            {
+                GemmPackA<T, Ti, MR>(p.A, rsA, csA, m, ip * MR, pc, kc,
+                                     Ap + (long)ip * MR * kc);
+            }
+            for (int jp = tid; jp < nPanels; jp += nThreads)
+            {
+                GemmPackB<T, Ti, NR>(p.B + (long)jc * csB, rsB, csB, nc,
+                                     jp * NR, pc, kc,
+                                     Bp + (long)jp * NR * kc);
+            }
+            if (nThreads > 1)
+            {
+                #pragma omp barrier
+            }
+
+            for (int t = tid; t < mTiles * nTiles; t += nThreads)
+            {
+                const int it = t / nTiles, jt = t % nTiles;
+                const int iEnd = (it + 1) * GEMM_MC < m ?
+                                 (it + 1) * GEMM_MC : m;
+                const int jEnd = (jt + 1) * GEMM_NT < nc ?
+                                 (jt + 1) * GEMM_NT : nc;
+                for (int jr = jt * GEMM_NT; jr < jEnd; jr += NR)
+                {
+                    const T *b = Bp + (long)(jr / NR) * NR * kc;
+                    for (int ir = it * GEMM_MC; ir < iEnd; ir += MR)
+                    {
+                        GemmMicroKernel<T, V, MR>(kc,
+                            Ap + (long)(ir / MR) * MR * kc, b,
+                            p.C + (long)ir * p.ldc + jc + jr, p.ldc,
+                            p.alpha, betaSlice,
+                            m - ir < MR ? m - ir : MR,
+                            jEnd - jr < NR ? jEnd - jr : NR);
+                    }
+                }
+            }
+
+            // The buffers are repacked for the next slice
+            if (nThreads > 1)
+            {
+                #pragma omp barrier
+            }
+        }
+    }
+}
+
+// Per-ISA entry points; NR is two vectors, MR fills most of the registers
+#ifdef __MIC__
+template <class T, class Ti>
+static __declspec(target(MIC)) void GemmAVX512(const GemmProblem<T, Ti> &p,
+    T *Ap, T *Bp, int tid, int nThreads)
+{
+    typedef T V __attribute__((vector_size(64)));
+    GemmBlocked<T, Ti, V, 8>(p, Ap, Bp, tid, nThreads);
+}
+#else
+template <class T, class Ti>
+static void GemmSSE(const GemmProblem<T, Ti> &p, T *Ap, T *Bp, int tid,
+                    int nThreads)
+{
+    typedef T V __attribute__((vector_size(16)));
+    GemmBlocked<T, Ti, V, 4>(p, Ap, Bp, tid, nThreads);
+}
+
+template <class T, class Ti>
+static SHOC_TARGET_AVX2 void GemmAVX2(const GemmProblem<T, Ti> &p, T *Ap,
+                                      T *Bp, int tid, int nThreads)
+{
+    typedef T V __attribute__((vector_size(32)));
+    GemmBlocked<T, Ti, V, 6>(p, Ap, Bp, tid, nThreads);
+}
+
+template <class T, class Ti>
+static SHOC_TARGET_AVX512 void GemmAVX512(const GemmProblem<T, Ti> &p, T *Ap,
+                                          T *Bp, int tid, int nThreads)
+{
+    typedef T V __attribute__((vector_size(64)));
+    GemmBlocked<T, Ti, V, 8>(p, Ap, Bp, tid, nThreads);
+}
+#endif
+
+template <class T, class Ti>
+static __declspec(target(MIC)) void GemmDispatch(int isa,
+    const GemmProblem<T, Ti> &p, T *Ap, T *Bp, int tid, int nThreads)
+{
+#ifdef __MIC__
+    GemmAVX512<T, Ti>(p, Ap, Bp, tid, nThreads);
+#else
+    switch (isa)
+    {
+      case GEMM_AVX512:
+        GemmAVX512<T, Ti>(p, Ap, Bp, tid, nThreads);
+        break;
+      case GEMM_AVX2:
+        GemmAVX2<T, Ti>(p, Ap, Bp, tid, nThreads);
+        break;
+      default:
+        GemmSSE<T, Ti>(p, Ap, Bp, tid, nThreads);
+        break;
+    }
+#endif
+}
+
+// Packing buffer sizes for an m x n result
+static __declspec(target(MIC)) long GemmPackedASize(int m)
+{
+    return (long)(m + GEMM_MAX_MR) * GEMM_KC;
+}
+
+static __declspec(target(MIC)) long GemmPackedBSize(int n)
+{
+    return (long)GEMM_KC * ((n < GEMM_NC ? n : GEMM_NC) + 64);
+}
+
+// ****************************************************************************
+// Function: NativeGEMM
+//
+// Purpose:
+//   Row-major GEMM with the same arguments as cblas_?gemm, run by all
+//   threads of a new OpenMP team.  A and B may be stored in a narrower
+//   type Ti (bf16, fp16 or int8) than C and the computation (float, or int
+//   for int8).
+//
+// Arguments:
+//   isa: micro-kernel to use on the host (ignored on the card), which must
+//        be supported; see GemmHostISA
+//   transa, transb: 'N' or 'T'
+//   m, n, k, alpha, A, lda, B, ldb, beta, C, ldc: as cblas_?gemm
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T, class Ti>
+__declspec(target(MIC)) void NativeGEMM(int isa, char transa, char transb,
+    int m, int n, int k, T alpha, const Ti *A, int lda, const Ti *B, int ldb,
+    T beta, T *C, int ldc)
+{
+    if (m <= 0 || n <= 0)
+        return;
+
+    const GemmProblem<T, Ti> p = { transa, transb, m, n, k, alpha, A, lda,
+                               B, ldb, beta, C, ldc };
+    T *Ap = (T *)_mm_malloc(sizeof(T) * GemmPackedASize(m), 64);
+    T *Bp = (T *)_mm_malloc(sizeof(T) * GemmPackedBSize(n), 64);
+
+    #pragma omp parallel
+    {
+        GemmDispatch<T, Ti>(isa, p, Ap, Bp, omp_get_thread_num(),
+                        omp_get_num_threads());
+    }
+
+    _mm_free(Ap);
+    _mm_free(Bp);
+}
+
+// ****************************************************************************
+// Function: NativeGEMMBatch
+//
+// Purpose:
+//   count independent GEMMs of the same shape, like one group of
+//   cblas_?gemm_batch.  The matrices are dealt out to the threads of a new
+//   OpenMP team and each thread runs its GEMMs alone with its own packing
+//   buffers, which suits batches of many small matrices.
+//
+// Arguments:
+//   isa: micro-kernel to use on the host, as for NativeGEMM
+//   transa, transb, m, n, k, alpha, lda, ldb, beta, ldc: as cblas_?gemm,
+//        shared by every GEMM of the batch
+//   A, B, C: count pointers each
+//   count: number of GEMMs
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T>
+__declspec(target(MIC)) void NativeGEMMBatch(int isa, char transa,
+    char transb, int m, int n, int k, T alpha, const T *const *A, int lda,
+    const T *const *B, int ldb, T beta, T *const *C, int ldc, int count)
+{
+    if (m <= 0 || n <= 0)
+        return;
+
+    #pragma omp parallel
+    {
+        T *Ap = (T *)_mm_malloc(sizeof(T) * GemmPackedASize(m), 64);
+        T *Bp = (T *)_mm_malloc(sizeof(T) * GemmPackedBSize(n), 64);
+
+        #pragma omp for schedule(static)
+        for (int i = 0; i < count; i++)
+        {
+            const GemmProblem<T, T> p = { transa, transb, m, n, k, alpha, A[i],
+                                       lda, B[i], ldb, beta, C[i], ldc };
+            GemmDispatch<T, T>(isa, p, Ap, Bp, 0, 1);
+        }
+
+        _mm_free(Ap);
+        _mm_free(Bp);
+    }
+}
+
+
+// Same for a strided batch: GEMM i uses A + i*strideA, B + i*strideB and
+// C + i*strideC
+template <class T>
+__declspec(target(MIC)) void NativeGEMMStridedBatch(int isa, char transa,
+    char transb, int m, int n, int k, T alpha, const T *A, int lda,
+    long strideA, const T *B, int ldb, long strideB, T beta, T *C, int ldc,
+    long strideC, int count)
+{
+    if (m <= 0 || n <= 0)
+        return;
+
+    #pragma omp parallel
+    {
+        T *Ap = (T *)_mm_malloc(sizeof(T) * GemmPackedASize(m), 64);
+        T *Bp = (T *)_mm_malloc(sizeof(T) * GemmPackedBSize(n), 64);
+
+        #pragma omp for schedule(static)
+        for (int i = 0; i < count; i++)
+        {
+            const GemmProblem<T, T> p = { transa, transb, m, n, k, alpha,
+                                       A + i * strideA, lda, B + i * strideB,
+                                       ldb, beta, C + i * strideC, ldc };
+            GemmDispatch<T, T>(isa, p, Ap, Bp, 0, 1);
+        }
+
+        _mm_free(Ap);
+        _mm_free(Bp);
+    }
+}
+
+#pragma offload_attribute(pop)
+
+#endif
@@ -0,0 +1,180 @@
+// This example from an alpha release of the Scalable HeterOgeneous Computing
+// (SHOC) Benchmark Suite Alpha v1.1.4a-mic for Intel MIC architecture
+// Contact: Kyle Spafford <kys@ornl.gov>
+//          Rezaur Rahman <rezaur.rahman@intel.com>
+//
+// Copyright (c) 2011, UT-Battelle, LLC
+// Copyright (c) 2013, Intel Corporation
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of Oak Ridge National Laboratory, nor UT-Battelle, LLC,
+//    nor the names of its contributors may be used to endorse or promote
+//    products derived from this software without specific prior written
+//    permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY,
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef REDUCED_PRECISION_H
+#define REDUCED_PRECISION_H
+
+#include <string.h>
+#include "offload.h"
+
+// ****************************************************************************
+// File:  ReducedPrecision.h
+//
+// Purpose:
+//   Storage types for the reduced-precision GEMM inputs and their
+//   conversions to and from float.  bfloat16 is the upper half of a float
+//   (8-bit exponent, 7-bit mantissa); IEEE half precision has a 5-bit
+//   exponent and a 10-bit mantissa.  Neither has arithmetic on the card or
+//   in the compilers this suite supports, so values are only stored in these
+//   formats and widened to float before use.  Narrowing rounds to nearest
+//   even.
+//
+// Creation:    October 16, 2026
+//
+// ****************************************************************************
+
+#pragma offload_attribute(push, target(mic))
+
+struct bf16
+{
+    unsigned short bits;
+};
+
+struct fp16
+{
+    unsigned short bits;
+};
+
+static inline float BF16ToFloat(bf16 x)
+{
+    unsigned int u = (unsigned int)x.bits << 16;
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+static inline bf16 FloatToBF16(float f)
+{
+    unsigned int u;
+    memcpy(&u, &f, sizeof(u));
+    bf16 x;
+    if ((u & 0x7fffffff) > 0x7f800000)
+    {
+        // Keep NaNs quiet; rounding could turn them into infinities
+        x.bits = (unsigned short)((u >> 16) | 0x40);
+        return x;
+    }
+    u += 0x7fff + ((u >> 16) & 1);
+    x.bits = (unsigned short)(u >> 16);
+    return x;
+}
+
+static inline float FP16ToFloat(fp16 x)
+{
+    const unsigned int sign = (unsigned int)(x.bits & 0x8000) << 16;
+    const unsigned int exp = (x.bits >> 10) & 0x1f;
+    unsigned int man = x.bits & 0x3ff;
+    unsigned int u;
+
+    if (exp == 0x1f)
+    {
+        // Infinity or NaN
+        u = sign | 0x7f800000 | (man << 13);
+    }
+    else if (exp != 0)
+    {
+        u = sign | ((exp + 112) << 23) | (man << 13);
+    }
+    else if (man == 0)
+    {
+        u = sign;
+    }
+    else
+    {
+        // Subnormal: man * 2^-24, normalized for the float format
+        unsigned int e = 113;
+        while (!(man & 0x400))
+        {
+            man <<= 1;
+            e--;
+        }
+        u = sign | (e << 23) | ((man & 0x3ff) << 13);
+    }
+
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+static inline fp16 FloatToFP16(float f)
+{
+    unsigned int u;
+    memcpy(&u, &f, sizeof(u));
+    const unsigned int sign = (u >> 16) & 0x8000;
+    const unsigned int a = u & 0x7fffffff;
+    fp16 x;
+
+    if (a >= 0x7f800000)
+    {
+        // Infinity stays infinity, NaN stays a quiet NaN
+        x.bits = (unsigned short)(sign | 0x7c00 |
+                                  (a > 0x7f800000 ? 0x200 : 0));
+    }
+    else if (a >= 0x477ff000)
+    {
+        // 65520 and above round to infinity
+        x.bits = (unsigned short)(sign | 0x7c00);
+    }
+    else if (a < 0x33000000)
+    {
+        // Below half the smallest subnormal
+        x.bits = (unsigned short)sign;
+    }
+    else if (a < 0x38800000)
+    {
+        // Subnormal result: the 24-bit mantissa shifted to units of 2^-24
+        const unsigned int man = (a & 0x7fffff) | 0x800000;
+        const int shift = 126 - (int)(a >> 23);
+        unsigned int h = man >> shift;
+        const unsigned int rem = man & ((1u << shift) - 1);
+        const unsigned int half = 1u << (shift - 1);
+        if (rem > half || (rem == half && (h & 1)))
+            h++;
+        x.bits = (unsigned short)(sign | h);
+    }
+    else
+    {
+        // Rebias the exponent; a carry out of the mantissa bumps it
+        unsigned int h = (a >> 13) - (112 << 10);
+        const unsigned int rem = a & 0x1fff;
+        if (rem > 0x1000 || (rem == 0x1000 && (h & 1)))
+            h++;
+        x.bits = (unsigned short)(sign | h);
+    }
+    return x;
+}
+
+#pragma offload_attribute(pop)
+
+#endif
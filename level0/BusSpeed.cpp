@@ -0,0 +1,427 @@
+// This example from an alpha release of the Scalable HeterOgeneous Computing
+// (SHOC) Benchmark Suite Alpha v1.1.4a-mic for Intel MIC architecture
+// Contact: Kyle Spafford <kys@ornl.gov>
+//          Rezaur Rahman <rezaur.rahman@intel.com>
+//
+// Copyright (c) 2011, UT-Battelle, LLC
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of Oak Ridge National Laboratory, nor UT-Battelle, LLC, 
+//    nor the names of its contributors may be used to endorse or promote 
+//    products derived from this software without specific prior written 
+//    permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, 
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
+// THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "omp.h"
+
+#include "Backend.h"
+#include "HostCPU.h"
+#include "Measurement.h"
+#include "OptionParser.h"
+#include "ResultDatabase.h"
+#include "Benchmark.h"
+#include "Timer.h"
+
+// ****************************************************************************
+// File:  BusSpeed.cpp
+//
+// Purpose:
+//   Transfer bandwidth between host memory and the device in one benchmark:
+//   host to device, device to host and both at once, from page-locked
+//   ("pinned") or ordinary ("pageable") host buffers, split over one or
+//   more concurrent streams.
+//
+//   With the offload backend the transfers are offload_transfer clauses to
+//   buffers kept on the card.  Without a card the "device" is a shared
+//   memory mapping, the kind of buffer another process would map, whose
+//   pages are placed on the last socket while the transfers are issued from
+//   the first, so on multi-socket hosts the results characterize the
+//   socket interconnect.
+//
+// Creation:    October 16, 2026
+//
+// ****************************************************************************
+
+enum Direction
+{
+    HOST_TO_DEVICE,
+    DEVICE_TO_HOST,
+    BIDIRECTIONAL
+};
+
+// Host buffer alignment: 2 MB lets the pinned buffers use huge pages
+#define ALIGN (2*1024*1024)
+
+// ****************************************************************************
+// Function: addBenchmarkSpecOptions
+//
+// Purpose:
+//   Add benchmark specific command line argument parsing.
+//
+// Arguments:
+//   op: the options parser / parameter database
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+static void addBenchmarkSpecOptions(OptionParser &op)
+{
+    op.addOption("directions", OPT_VECSTRING, "h2d,d2h,bidir",
+                 "transfer directions: h2d, d2h and/or bidir");
+    op.addOption("host-memory", OPT_VECSTRING, "pinned,pageable",
+                 "host buffer kinds: pinned and/or pageable");
+    op.addOption("streams", OPT_VECINT, "1,2,4",
+                 "numbers of concurrent streams per direction");
+}
+
+// Device side of the host backend: a shared memory mapping
+static float *MapDeviceBuffer(size_t bytes)
+{
+    char name[64];
+    sprintf(name, "/shoc-busspeed-%d", (int)getpid());
+    int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    shm_unlink(name);
+
+    void *ptr = NULL;
+    if (ftruncate(fd, bytes) == 0)
+    {
+        ptr = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    return (ptr == MAP_FAILED) ? NULL : (float *)ptr;
+}
+
+// ****************************************************************************
+// Function: TransferSlice
+//
+// Purpose:
+//   Moves count floats at offset between a host buffer and its device
+//   counterpart.
+//
+// Arguments:
+//   dir:     HOST_TO_DEVICE or DEVICE_TO_HOST
+//   host:    the host buffer
+//   dev:     the device buffer (host backend only)
+//   offset:  first element
+//   count:   number of elements
+//   useMIC:  whether the device is the card
+//   micdev:  the card
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+static void TransferSlice(Direction dir, float *host, float *dev,
+                          size_t offset, size_t count, bool useMIC,
+                          int micdev)
+{
+    if (useMIC)
+    {
+        if (dir == HOST_TO_DEVICE)
+        {
+            #pragma offload_transfer target(mic:micdev) \
+            in(host[offset:count] : alloc_if(0) free_if(0))
+        }
+        else
+        {
+            #pragma offload_transfer target(mic:micdev) \
+            out(host[offset:count] : alloc_if(0) free_if(0))
+        }
+    }
+    else if (dir == HOST_TO_DEVICE)
+    {
+        memcpy(dev + offset, host + offset, count * sizeof(float));
+    }
+    else
+    {
+        memcpy(host + offset, dev + offset, count * sizeof(float));
+    }
+}
+
+// One measured configuration
+struct TransferTest
+{
+    string    name;
+    Direction dir;
+    bool      pinned;
+    int       streams;
+};
+
+static void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
+{
+    const bool verbose = op.getOptionBool("verbose");
+    const int micdev = op.getOptionInt("target");
+    const bool useMIC = UseOffload(op);
+
+    // Sizes are in kb
+    const int nSizes  = 17;
+    int sizes[nSizes] = {1,2,4,8,16,32,64,128,256,512,1024,2048,4096,8192,16384,
+        32768, 65536};
+    const size_t numMaxFloats = 1024 * (size_t)(sizes[nSizes-1]) / 4;
+    const size_t maxBytes = numMaxFloats * sizeof(float);
+
+    // Parse the configurations
+    vector<TransferTest> tests;
+    vector<string> dirs = op.getOptionVecString("directions");
+    vector<string> kinds = op.getOptionVecString("host-memory");
+    vector<long long> streams = op.getOptionVecInt("streams");
+    for (int d = 0; d < dirs.size(); d++)
+    for (int k = 0; k < kinds.size(); k++)
+    for (int s = 0; s < streams.size(); s++)
+    {
+        TransferTest test;
+        if (dirs[d] == "h2d")
+        {
+            test.dir = HOST_TO_DEVICE;
+            test.name = "H2DSpeed";
+        }
+        else if (dirs[d] == "d2h")
+        {
+            test.dir = DEVICE_TO_HOST;
+            test.name = "D2HSpeed";
+        }
+        else if (dirs[d] == "bidir")
+        {
+            test.dir = BIDIRECTIONAL;
+            test.name = "BidirSpeed";
+        }
+        else
+        {
+            cerr << "Error: unknown direction \"" << dirs[d] << "\"" << endl;
+            return;
+        }
+        if (kinds[k] != "pinned" && kinds[k] != "pageable")
+        {
+            cerr << "Error: unknown host memory \"" << kinds[k] << "\""
+                 << endl;
+            return;
+        }
+        if (streams[s] < 1)
+        {
+            cerr << "Error: stream counts must be positive" << endl;
+            return;
+        }
+        test.pinned = (kinds[k] == "pinned");
+        test.streams = (int)streams[s];
+        test.name += "_" + kinds[k];
+        if (test.streams > 1)
+        {
+            char suffix[32];
+            sprintf(suffix, "_x%d", test.streams);
+            test.name += suffix;
+        }
+        tests.push_back(test);
+    }
+
+    // Host buffers: [0] pageable, [1] pinned; one pair per direction so
+    // bidirectional transfers do not share memory
+    float *hostIn[2], *hostOut[2];
+    for (int p = 0; p < 2; p++)
+    {
+        hostIn[p]  = (float *)_mm_malloc(maxBytes, p ? ALIGN : 4096);
+        hostOut[p] = (float *)_mm_malloc(maxBytes, p ? ALIGN : 4096);
+        if (hostIn[p] == NULL || hostOut[p] == NULL)
+        {
+            cerr << "Couldn't allocate CPU memory\n";
+            cerr << "Test Failed\n";
+            return;
+        }
+        for (size_t i = 0; i < numMaxFloats; i++)
+        {
+            hostIn[p][i] = hostOut[p][i] = i % 77;
+        }
+    }
+    if (mlock(hostIn[1], maxBytes) != 0 || mlock(hostOut[1], maxBytes) != 0)
+    {
+        cerr << "Warning: unable to lock the pinned buffers in memory "
+             << "(see ulimit -l), they will be pageable" << endl;
+    }
+
+    // Device buffers
+    float *devIn = NULL, *devOut = NULL;
+    vector<vector<int> > sockets = HostSockets();
+    if (useMIC)
+    {
+        for (int p = 0; p < 2; p++)
+        {
+            float *in = hostIn[p], *out = hostOut[p];
+            #pragma offload_transfer target(mic:micdev) \
+            nocopy(in : length(numMaxFloats) alloc_if(1) free_if(0)) \
+            nocopy(out : length(numMaxFloats) alloc_if(1) free_if(0))
+        }
+    }
+    else
+    {
+        devIn = MapDeviceBuffer(maxBytes);
+        devOut = MapDeviceBuffer(maxBytes);
+        if (devIn == NULL || devOut == NULL)
+        {
+            cerr << "Couldn't map the shared memory device buffers\n";
+            cerr << "Test Failed\n";
+            return;
+        }
+
+        // First touch from the last socket
+        PinOpenMPThreads(sockets.back());
+        #pragma omp parallel for schedule(static)
+        for (size_t i = 0; i < numMaxFloats; i++)
+        {
+            devIn[i] = devOut[i] = 0.0f;
+        }
+    }
+
+    // With --rel-ci, small sizes keep repeating after large ones converged
+    Measurement meas(op);
+
+    for (int pass = 0; !meas.Finished(); pass++)
+    {
+        for (int t = 0; t < tests.size(); t++)
+        {
+            const TransferTest &test = tests[t];
+            const int nDirs = (test.dir == BIDIRECTIONAL) ? 2 : 1;
+            const int nThreads = test.streams * nDirs;
+
+            // Issue host backend transfers from the first socket
+            if (!useMIC)
+            {
+                vector<int> cpus;
+                for (int i = 0; i < nThreads; i++)
+                {
+                    cpus.push_back(sockets[0][i % sockets[0].size()]);
+                }
+                PinOpenMPThreads(cpus);
+            }
+
+            // Step through sizes forward on even passes and backward on odd
+            for (int i = 0; i < nSizes; i++)
+            {
+                int sizeIndex = (pass % 2 == 0) ? i : (nSizes - 1) - i;
+                char sizeStr[256];
+                sprintf(sizeStr, "% 6dkB", sizes[sizeIndex]);
+                const string region = test.name + sizeStr;
+                if (meas.Done(region))
+                {
+                    continue;
+                }
+
+                const size_t count = 1024 * (size_t)sizes[sizeIndex] / 4;
+                meas.Start(region);
+                #pragma omp parallel num_threads(nThreads) if(nThreads > 1)
+                {
+                    const int thread = omp_get_thread_num();
+                    Direction dir = test.dir;
+                    if (dir == BIDIRECTIONAL)
+                    {
+                        dir = (thread % 2) ? DEVICE_TO_HOST : HOST_TO_DEVICE;
+                    }
+                    const int stream = thread / nDirs;
+                    const size_t begin = count * stream / test.streams;
+                    const size_t end = count * (stream + 1) / test.streams;
+                    if (end > begin)
+                    {
+                        float *host = (dir == HOST_TO_DEVICE)
+                            ? hostIn[test.pinned] : hostOut[test.pinned];
+                        float *dev = (dir == HOST_TO_DEVICE) ? devIn : devOut;
+                        TransferSlice(dir, host, dev, begin, end - begin,
+                                      useMIC, micdev);
+                    }
+                }
+                double t = meas.Stop(region);
+
+                if (verbose)
+                {
+                    cerr << test.name << " size " << sizes[sizeIndex]
+                         << "k took " << t << " sec\n";
+                }
+            }
+        }
+    }
+    if (!useMIC)
+    {
+        UnpinOpenMPThreads();
+    }
+
+    // Convert the kept samples to GB/sec
+    for (int t = 0; t < tests.size(); t++)
+    {
+        const int nDirs = (tests[t].dir == BIDIRECTIONAL) ? 2 : 1;
+        for (int i = 0; i < nSizes; i++)
+        {
+            char sizeStr[256];
+            sprintf(sizeStr, "% 6dkB", sizes[i]);
+            const string region = tests[t].name + sizeStr;
+            vector<double> times = meas.Samples(region);
+            for (int j = 0; j < times.size(); j++)
+            {
+                if (times[j] <= 0.0)
+                {
+                    continue;
+                }
+                double speed = (double(sizes[i]) * 1024 * nDirs /
+                        (1000. * 1000. * 1000.)) / times[j];
+                resultDB.AddResult(tests[t].name, sizeStr, "GB/s", speed);
+            }
+            meas.RecordConfidence(resultDB, region, tests[t].name, sizeStr);
+        }
+    }
+
+    // Cleanup
+    if (useMIC)
+    {
+        for (int p = 0; p < 2; p++)
+        {
+            float *in = hostIn[p], *out = hostOut[p];
+            #pragma offload_transfer target(mic:micdev) \
+            nocopy(in : length(numMaxFloats) alloc_if(0) free_if(1)) \
+            nocopy(out : length(numMaxFloats) alloc_if(0) free_if(1))
+        }
+    }
+    else
+    {
+        munmap(devIn, maxBytes);
+        munmap(devOut, maxBytes);
+    }
+    munlock(hostIn[1], maxBytes);
+    munlock(hostOut[1], maxBytes);
+    for (int p = 0; p < 2; p++)
+    {
+        _mm_free(hostIn[p]);
+        _mm_free(hostOut[p]);
+    }
+}
+
+SHOC_REGISTER_BENCHMARK(BusSpeed);
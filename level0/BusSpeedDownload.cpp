@@ -33,8 +33,15 @@
 // THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <omp.h>
+#include "Backend.h"
+#include "Measurement.h"
 #include "OptionParser.h"
 #include "ResultDatabase.h"
+#include "Benchmark.h"
 #include "Timer.h"
 
 // ****************************************************************************
@@ -54,9 +61,187 @@
 // Modifications:
 //
 // ****************************************************************************
-void addBenchmarkSpecOptions(OptionParser &op)
+static void addBenchmarkSpecOptions(OptionParser &op)
 {
-    // No specific options for this benchmark.
+    op.addOption("latency", OPT_BOOL, "",
+        "report per-transfer latency percentiles of small transfers");
+    op.addOption("latency-iterations", OPT_INT, "10000",
+        "timed transfers per size in latency mode");
+}
+
+// Macro for memory alignment
+#define ALIGN (2*1024*1024)
+
+static __declspec(target(MIC)) float *hostMem=NULL;
+
+// ****************************************************************************
+// Function: RecordLatency
+//
+// Purpose:
+//   Adds the p50/p90/p99/max of one set of latency samples to the results
+//   and, in verbose mode, prints a histogram with power-of-two buckets.
+//
+// Arguments:
+//   resultDB: the results database
+//   test: test name, suffixed with the percentile
+//   atts: result attributes
+//   samples: per-operation latencies in seconds
+//   verbose: print the histogram
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+static void RecordLatency(ResultDatabase &resultDB, const string &test,
+                          const string &atts, vector<double> &samples,
+                          bool verbose)
+{
+    sort(samples.begin(), samples.end());
+    resultDB.AddResult(test + "_p50", atts, "us",
+                       ResultDatabase::Percentile(samples, 50.) * 1.e6);
+    resultDB.AddResult(test + "_p90", atts, "us",
+                       ResultDatabase::Percentile(samples, 90.) * 1.e6);
+    resultDB.AddResult(test + "_p99", atts, "us",
+                       ResultDatabase::Percentile(samples, 99.) * 1.e6);
+    resultDB.AddResult(test + "_max", atts, "us", samples.back() * 1.e6);
+
+    if (verbose)
+    {
+        // Bucket b holds latencies in [2^(b-1), 2^b) us
+        const int nBuckets = 24;
+        int counts[nBuckets] = {0};
+        for (size_t i = 0; i < samples.size(); i++)
+        {
+            int b = 0;
+            for (double us = samples[i] * 1.e6; us >= 1. && b < nBuckets-1;
+                 us /= 2.)
+            {
+                b++;
+            }
+            counts[b]++;
+        }
+        cerr << test << " " << atts << " latency histogram:\n";
+        for (int b = 0; b < nBuckets; b++)
+        {
+            if (counts[b] > 0)
+            {
+                cerr << "  < " << (1 << b) << " us: " << counts[b] << "\n";
+            }
+        }
+    }
+}
+
+// ****************************************************************************
+// Function: RunLatency
+//
+// Purpose:
+//   Times thousands of individual 0 B - 4 kB host-to-card transfers and
+//   empty kernel launches, exposing the fixed per-offload overhead that the
+//   bandwidth sweep averages away.  On the host backend a transfer is a
+//   memcpy into a separate buffer and a launch starts the OpenMP team the
+//   host kernels run on.
+//
+// Arguments:
+//   op: the options parser / parameter database
+//   resultDB: the results database
+//   micdev: the card to offload to
+//   useMIC: offload, or time the host stand-ins
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+static void RunLatency(OptionParser &op, ResultDatabase &resultDB,
+                       int micdev, bool useMIC)
+{
+    const bool verbose = op.getOptionBool("verbose");
+    const int iterations = op.getOptionInt("latency-iterations");
+    if (iterations < 1)
+    {
+        cerr << "Error: --latency-iterations must be positive\n";
+        return;
+    }
+
+    // Untimed operations before each set, to leave first-use costs out
+    const int nWarmup = 100;
+    const double overhead = TimerOverhead();
+
+    // Transfer sizes are in bytes
+    const int nBytes = 5;
+    int bytes[nBytes] = {0, 8, 64, 512, 4096};
+
+    // Destination of the host backend's transfers
+    float *devMem = NULL;
+    if (!useMIC)
+    {
+        devMem = (float *)_mm_malloc(bytes[nBytes-1], ALIGN);
+        if (devMem == NULL)
+        {
+            cerr << "Couldn't allocate CPU memory\n";
+            return;
+        }
+        memset(devMem, 0, bytes[nBytes-1]);
+    }
+    const int nThreads = BackendThreads(op);
+    static volatile int launches = 0;
+
+    vector<double> samples(iterations);
+    for (int i = 0; i < nBytes; i++)
+    {
+        const int count = bytes[i] / sizeof(float);
+        for (int it = -nWarmup; it < iterations; it++)
+        {
+            double start = curr_second();
+            if (useMIC)
+            {
+                #pragma offload_transfer target(mic:micdev) \
+                in(hostMem:length(count) alloc_if(0) free_if(0))
+            }
+            else
+            {
+                memcpy(devMem, hostMem, count * sizeof(float));
+            }
+            double t = curr_second() - start;
+            if (it >= 0)
+            {
+                samples[it] = max(t - overhead, TimerResolution());
+            }
+        }
+
+        char sizeStr[256];
+        sprintf(sizeStr, "% 5dB", bytes[i]);
+        RecordLatency(resultDB, "DownloadLatency", sizeStr, samples, verbose);
+    }
+
+    for (int it = -nWarmup; it < iterations; it++)
+    {
+        double start = curr_second();
+        if (useMIC)
+        {
+            #pragma offload target(mic:micdev)
+            {
+            }
+        }
+        else
+        {
+            // An empty region may be compiled away; one store keeps it
+            #pragma omp parallel num_threads(nThreads)
+            {
+                if (omp_get_thread_num() == 0)
+                    launches++;
+            }
+        }
+        double t = curr_second() - start;
+        if (it >= 0)
+        {
+            samples[it] = max(t - overhead, TimerResolution());
+        }
+    }
+    RecordLatency(resultDB, "LaunchLatency", "empty", samples, verbose);
+
+    _mm_free(devMem);
 }
 
 // ****************************************************************************
@@ -79,12 +264,7 @@ void addBenchmarkSpecOptions(OptionParser &op)
 // Kyle Spafford -- Updated to preliminary version for MIC 
 // ****************************************************************************
 
-// Macro for memory alignment
-#define ALIGN (2*1024*1024)
-
-__declspec(target(MIC)) float *hostMem=NULL;
-
-void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
+static void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
 {
     const bool verbose = op.getOptionBool("verbose");
 
@@ -109,58 +289,89 @@ void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
         hostMem[i] = i % 77;
     }
 
-    const unsigned int passes = op.getOptionInt("passes");    
     int micdev = op.getOptionInt("target");
+    const bool useMIC = UseOffload(op);
 
     // Allocate memory on the card
-    #pragma offload target(mic:micdev) \
+    #pragma offload target(mic:micdev) if(useMIC) \
     in(hostMem:length(numMaxFloats) free_if(0) align(ALIGN) ) 
     {
     }
 
-    // Three passes, forward and backward both
-    for (int pass = 0; pass < passes; pass++)
+    // Latency mode replaces the bandwidth sweep
+    if (op.getOptionBool("latency"))
     {
-        // Step through sizes forward on even passes and backward on odd
-        for (int i = 0; i < nSizes; i++)
+        RunLatency(op, resultDB, micdev, useMIC);
+    }
+    else
+    {
+        // With --rel-ci, small sizes keep repeating after large ones converged
+        Measurement meas(op);
+
+        // Passes alternate forward and backward through the sizes
+        for (int pass = 0; !meas.Finished(); pass++)
         {
-            int sizeIndex;
-            if ((pass % 2) == 0)
-            {
-                sizeIndex = i;
-            }
-            else
+            // Step through sizes forward on even passes and backward on odd
+            for (int i = 0; i < nSizes; i++)
             {
-                sizeIndex = (nSizes - 1) - i;
-            }
-            int nbytes = sizes[sizeIndex] * 1024;
-            double start = curr_second();
-            
-            // Actual transferring data from host to card
-            #pragma offload target(mic:micdev) \
-            in(hostMem:length((1024*sizes[sizeIndex]/4)) free_if(0) \
-                                                        alloc_if(0) )
-            {
-            }
+                int sizeIndex;
+                if ((pass % 2) == 0)
+                {
+                    sizeIndex = i;
+                }
+                else
+                {
+                    sizeIndex = (nSizes - 1) - i;
+                }
+                char sizeStr[256];
+                sprintf(sizeStr, "% 6dkB", sizes[sizeIndex]);
+                if (meas.Done(sizeStr))
+                {
+                    continue;
+                }
 
-            double t = curr_second()-start;
+                // Actual transferring data from host to card
+                meas.Start(sizeStr);
+                #pragma offload target(mic:micdev) if(useMIC) \
+                in(hostMem:length((1024*sizes[sizeIndex]/4)) free_if(0) \
+                                                            alloc_if(0) )
+                {
+                }
+                double t = meas.Stop(sizeStr);
 
-            // Convert to GB/sec
-            if (verbose)
-            {
-                cerr << "Size " << sizes[sizeIndex] << "k took " << t <<
-                    " sec\n";
+                if (verbose)
+                {
+                    cerr << "Size " << sizes[sizeIndex] << "k took " << t <<
+                        " sec\n";
+                }
             }
-            double speed = (double(sizes[sizeIndex] * 1024) / 
-                    (1000. * 1000. * 1000.)) / t;
+        }
+
+        // Convert the kept samples to GB/sec
+        for (int i = 0; i < nSizes; i++)
+        {
             char sizeStr[256];
-            sprintf(sizeStr, "% 6dkB", sizes[sizeIndex]);
-            resultDB.AddResult("DownloadSpeed", sizeStr, "GB/s", speed);
-            resultDB.AddResult("DownloadTime", sizeStr, "ms", t*1000);
+            sprintf(sizeStr, "% 6dkB", sizes[i]);
+            vector<double> times = meas.Samples(sizeStr);
+            for (int j = 0; j < times.size(); j++)
+            {
+                double t = times[j];
+                if (t <= 0.0)
+                {
+                    continue;
+                }
+                double speed = (double(sizes[i]) * 1024 /
+                        (1000. * 1000. * 1000.)) / t;
+                resultDB.AddResult("DownloadSpeed", sizeStr, "GB/s", speed);
+                resultDB.AddResult("DownloadTime", sizeStr, "ms", t*1000);
+            }
+            meas.RecordConfidence(resultDB, sizeStr, "DownloadSpeed", sizeStr);
+            meas.RecordConfidence(resultDB, sizeStr, "DownloadTime", sizeStr);
         }
     }
+
     // Free memory allocated on the mic
-    #pragma offload target(mic:micdev) \
+    #pragma offload target(mic:micdev) if(useMIC) \
     in(hostMem:length(numMaxFloats) alloc_if(0)  )
     {
     }
@@ -168,3 +379,5 @@ void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
     // Cleanup
     _mm_free(hostMem);
 }
+
+SHOC_REGISTER_BENCHMARK(BusSpeedDownload);
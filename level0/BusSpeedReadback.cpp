@@ -33,8 +33,11 @@
 // THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdio.h>
+#include "Backend.h"
+#include "Measurement.h"
 #include "OptionParser.h"
 #include "ResultDatabase.h"
+#include "Benchmark.h"
 #include "Timer.h"
 
 // ****************************************************************************
@@ -54,7 +57,7 @@
 // Modifications:
 //
 // ****************************************************************************
-void addBenchmarkSpecOptions(OptionParser &op)
+static void addBenchmarkSpecOptions(OptionParser &op)
 {
     // No specific options for this benchmark.
 }
@@ -80,11 +83,11 @@ void addBenchmarkSpecOptions(OptionParser &op)
 // 12/12/12 - Kyle Spafford -- Updated to preliminary version for MIC 
 //
 // ****************************************************************************
-__declspec(target(MIC)) float *hostMem=NULL;
+static __declspec(target(MIC)) float *hostMem=NULL;
 
 #define ALIGN  (4096)
 
-void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
+static void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
 {
     const bool verbose = op.getOptionBool("verbose");
 
@@ -110,17 +113,20 @@ void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
         hostMem[i] = i % 77;
     }
 
-    const unsigned int passes = op.getOptionInt("passes");
     int micdev = op.getOptionInt("target");
+    const bool useMIC = UseOffload(op);
 
     // Allocate memory on the card
-    #pragma offload target(mic:micdev) \
+    #pragma offload target(mic:micdev) if(useMIC) \
     nocopy(hostMem:length(numMaxFloats) alloc_if(1) free_if(0) align(ALIGN) ) 
     {
     }
 
-    // Three passes, forward and backward both
-    for (int pass = 0; pass < passes; pass++)
+    // With --rel-ci, small sizes keep repeating after large ones converged
+    Measurement meas(op);
+
+    // Passes alternate forward and backward through the sizes
+    for (int pass = 0; !meas.Finished(); pass++)
     {
         // Step through sizes forward on even passes and backward on odd
         for (int i = 0; i < nSizes; i++)
@@ -134,35 +140,54 @@ void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
             {
                 sizeIndex = (nSizes - 1) - i;
             }
+            char sizeStr[256];
+            sprintf(sizeStr, "% 6dkB", sizes[sizeIndex]);
+            if (meas.Done(sizeStr))
+            {
+                continue;
+            }
 
-            int nbytes = sizes[sizeIndex] * 1024;
-
-            //  D->H test
-            double start = curr_second();
-
-            #pragma offload target(mic:micdev) \
-            out(hostMem:length((1024*sizes[sizeIndex]/4)) \
-            free_if(0) alloc_if(0)  )
+            // D->H test
+            meas.Start(sizeStr);
+            #pragma offload target(mic:micdev) if(useMIC) \
+            out(hostMem:length((1024*sizes[sizeIndex]/4)) free_if(0) \
+                                                        alloc_if(0) )
             {
             }
-            double t = curr_second()-start;
+            double t = meas.Stop(sizeStr);
 
             if (verbose)
             {
                 cerr << "Size " << sizes[sizeIndex] << "k took " << t <<
                     " sec\n";
             }
+        }
+    }
 
-            double speed = (double(sizes[sizeIndex]) * 1024 / 
+    // Convert the kept samples to GB/sec
+    for (int i = 0; i < nSizes; i++)
+    {
+        char sizeStr[256];
+        sprintf(sizeStr, "% 6dkB", sizes[i]);
+        vector<double> times = meas.Samples(sizeStr);
+        for (int j = 0; j < times.size(); j++)
+        {
+            double t = times[j];
+            if (t <= 0.0)
+            {
+                continue;
+            }
+            double speed = (double(sizes[i]) * 1024 /
                     (1000. * 1000. * 1000.)) / t;
-            char sizeStr[256];
-            sprintf(sizeStr, "% 6dkB", sizes[sizeIndex]);
             resultDB.AddResult("ReadbackSpeed", sizeStr, "GB/sec", speed);
             resultDB.AddResult("ReadbackTime", sizeStr, "ms", t*1000);
         }
+        meas.RecordConfidence(resultDB, sizeStr, "ReadbackSpeed", sizeStr);
+        meas.RecordConfidence(resultDB, sizeStr, "ReadbackTime", sizeStr);
     }
+
     // Free memory allocated on the mic
-    #pragma offload target(mic:micdev) \
+    #pragma offload target(mic:micdev) if(useMIC) \
     in(hostMem:length(numMaxFloats) alloc_if(0)  )
     {
     }
@@ -170,3 +195,5 @@ void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
     // Cleanup
     _mm_free(hostMem);
 }
+
+SHOC_REGISTER_BENCHMARK(BusSpeedReadback);
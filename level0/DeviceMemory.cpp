@@ -32,58 +32,39 @@
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
 // THE POSSIBILITY OF SUCH DAMAGE.
 
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <vector>
 #include <stdio.h>
 #include "omp.h"
 #include "Timer.h"
+#include "Measurement.h"
 #include "ResultDatabase.h"
+#include "Backend.h"
+#include "HostCPU.h"
 #include "OptionParser.h"
+#include "Benchmark.h"
 
-#define MIC_THREADS 228
-// For heterogeneous features include "offload.h"
-#include "offload.h"
-// #ifdef __MIC__ ||__MIC2__
-#if defined(__MIC__) || defined(__MIC2__)
-#include <immintrin.h>
-#endif
-
-// Memory Benchmarks Sizes
-#define VECSIZE_SP 480000
-#define REPS_SP 1000
-
-float __declspec(target(mic)) testICC_read(const int reps, const int eversion);
-float __declspec(target(mic)) testICC_write(const int reps, 
-        const int eversion, 
-        const float value);
-
-float __declspec(target(mic)) testIntrinsics_read(const int reps, 
-        const int eversion);
-float __declspec(target(mic)) testIntrinsics_write(const int reps, 
-        const int eversion, 
-        const float value);
-
-// L2 & L1 Benchmarks Sizes
-#define VECSIZE_SP_L2 4864
-#define REPS_SP_L2 1000000
-#define VECSIZE_SP_L1 1024
-#define REPS_SP_L1 1000000
-
-float __declspec(target(mic)) testICC_read_caches(const int reps, 
-        const int eversion, 
-        const int worksize);
-float __declspec(target(mic)) testICC_write_caches(const int reps, 
-        const int eversion, 
-        const float value, 
-        const int worksize);
-
-float __declspec(target(mic)) testIntrinsics_read_caches(const int reps, 
-        const int eversion, 
-        const int worksize);
-float __declspec(target(mic)) testIntrinsics_write_caches(const int reps, 
-        const int eversion, 
-        const float value, 
-        const int worksize);
+// Access patterns of the sweep engine
+enum SweepPattern
+{
+    SWEEP_READ,     // sum of every element
+    SWEEP_WRITE,    // store to every element
+    SWEEP_RMW,      // add to every element in place
+    SWEEP_STRIDED,  // sum of every stride-th element
+    SWEEP_GATHER,   // sum through a random index permutation
+    NUM_SWEEP_PATTERNS
+};
+
+static const char *sweepPatternNames[NUM_SWEEP_PATTERNS] =
+    { "read", "write", "rmw", "strided", "gather" };
+static const char *sweepTestNames[NUM_SWEEP_PATTERNS] =
+    { "READ", "WRITE", "RMW", "STRIDED", "GATHER" };
+
+// Bytes each sweep point streams, so small footprints repeat enough to
+// dwarf the timer and fork/join costs
+#define SWEEP_BYTES (256LL*1024*1024)
 
 // ****************************************************************************
 // Function: addBenchmarkSpecOptions
@@ -100,723 +81,469 @@ float __declspec(target(mic)) testIntrinsics_write_caches(const int reps,
 // Creation: July 23, 2010
 //
 // Modifications:
+// October 16, 2026 - Options of the working set sweep.
 // ****************************************************************************
-void addBenchmarkSpecOptions(OptionParser &op)
+static void addBenchmarkSpecOptions(OptionParser &op)
 {
-    // No specific options for this benchmark.
+    op.addOption("min-footprint", OPT_INT, "16",
+        "smallest total working set of the sweep, in kB");
+    op.addOption("max-footprint", OPT_INT, "512",
+        "largest total working set of the sweep, in MB");
+    op.addOption("threads", OPT_INT, "0",
+        "threads sharing the working set (0: all backend threads)");
+    op.addOption("patterns", OPT_VECSTRING, "read,write,rmw,strided,gather",
+        "access patterns: read, write, rmw, strided, gather");
+    op.addOption("access-stride", OPT_INT, "16",
+        "elements between the accesses of the strided pattern");
+    op.addOption("scaling", OPT_BOOL, "",
+        "sweep pinned thread counts at the largest footprint (host only)");
 }
 
 // ****************************************************************************
-// Function: runBenchmark
+// Function: SweepPatternBytes
 //
 // Purpose:
+//   Bytes one pass of a pattern over n elements moves, as counted for its
+//   bandwidth: stores and loads of read-modify-write count separately, and
+//   gather counts its index array.  Strided counts only the elements it
+//   reads, so its bandwidth is the useful fraction of the lines fetched.
 //
 // Arguments:
-//  resultDB: the benchmark stores its results in this ResultDatabase
-//  op: the options parser / parameter database
+//   pattern: the access pattern
+//   n: elements per thread
+//   stride: element stride of the strided pattern
 //
-// Returns:  nothing
+// Returns:  bytes per thread per pass
 //
-// Programmer: Alexander Heinecke
-// Creation: July 23, 2010
-//
-// Modifications:
-// Dec. 12, 2012 - Kyle Spafford - Updates and SHOC coding style conformance.
+// Creation: October 16, 2026
 //
 // ****************************************************************************
-void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
+static double SweepPatternBytes(int pattern, long n, long stride)
 {
-    const bool verbose = op.getOptionBool("verbose");
-    const unsigned int passes = op.getOptionInt("passes");
-
-    __declspec(target(mic)) static int eversion = 1;
-
-    double t = 0.0f;
-    double startTime;
-    unsigned int w;
-    __declspec(target(mic)) static unsigned int reps;
-    double nbytes;
-    float res = 0.0;
-    float input = 1.0;
-
-    int numThreads = MIC_THREADS;
-    double dThreads = static_cast<double>(numThreads);
-
-    for (int p = 0; p < passes; p++)
+    switch (pattern)
     {
-        // Test Memory
-        w = VECSIZE_SP;
-        reps = REPS_SP;
-
-        // Test Read - ICC Code
-        startTime = curr_second();
-        #pragma offload target (mic)
-        res = testICC_read(reps, eversion);
-        t = curr_second()-startTime;
-
-        // Add result
-        nbytes = ((double)w)*((double)reps)*((double)sizeof(float))*dThreads;
-        resultDB.AddResult("READ_MEM", "", "GB/s",
-                (((double)nbytes) / (t*1.e9)));
-
-// Remove intrinsic versions
-#if 0
-        // Test Read - Intrinsics Code
-        startTime = curr_second();
-        #pragma offload target (mic)
-        res = testIntrinsics_read(reps, eversion);
-        t = curr_second()-startTime;
-
-        // Add result
-        nbytes = ((double)w)*((double)reps)*((double)sizeof(float))*dThreads;
-  resultDB.AddResult("INT_R_MEM", "", "GB/s",
-                (((double)nbytes) / (t*1.e9)));
-#endif
-        // Test Write - ICC Code
-        startTime = curr_second();
-        #pragma offload target (mic)
-        res = testICC_write(reps, eversion, input);
-        t = curr_second()-startTime;
-
-        // Add Result
-        nbytes = ((double)w)*((double)reps)*((double)sizeof(float))*dThreads;
-        resultDB.AddResult("WRITE_MEM", "", "GB/s",
-                (((double)nbytes) / (t*1.e9)));
-//Remove intrinsics version
-#if 0
-        // Test Write - Intrinsics Code
-        startTime = curr_second();
-        #pragma offload target (mic)
-        res = testIntrinsics_write(reps, eversion, input);
-        t = curr_second()-startTime;
-
-        // Add result
-        nbytes = ((double)w)*((double)reps)*((double)sizeof(float))*dThreads;
-        resultDB.AddResult("INT_W_MEM", "", "GB/s",
-                (((double)nbytes) / (t*1.e9)));
-#endif
-// commnented out all the cache measurements as the code is buggy
-#if 0
-        // Begin L1 Tests
-        w = VECSIZE_SP_L1;
-        reps = REPS_SP_L1;
-
-        // Test Read L1 - ICC Code
-        startTime = curr_second();
-        #pragma offload target (mic)
-        res = testICC_read_caches(reps, eversion, w);
-        t =curr_second()-startTime; 
-
-        // Add result
-        nbytes = ((double)w)*((double)reps)*((double)sizeof(float))*4.0;
-        resultDB.AddResult("ICC_R_L1", "", "GB/s",
-                (((double)nbytes) / (t*1.e9)));
-
-        // Test Read L1 - Intrinsics Code
-        startTime = curr_second();
-        #pragma offload target (mic)
-        res = testIntrinsics_read_caches(reps, eversion, w);
-        t = curr_second()-startTime;
-
-        // Add result
-        nbytes = ((double)w)*((double)reps)*((double)sizeof(float))*4.0;
-        resultDB.AddResult("INT_R_L1", "", "GB/s",
-                (((double)nbytes) / (t*1.e9)));
-
-        // Test Write L1 - ICC Code
-        startTime = curr_second();
-        #pragma offload target (mic)
-        res = testICC_write_caches(reps, eversion, input, w);
-        t = curr_second()-startTime;
-
-        // Add result
-        nbytes = ((double)w)*((double)reps)*((double)sizeof(float))*4.0;
-        resultDB.AddResult("ICC_W_L1", "", "GB/s",
-                (((double)nbytes) / (t*1.e9)));
-
-        // Test Write L1 - Intrinsics Code
-        startTime= curr_second();
-        #pragma offload target (mic)
-        res = testIntrinsics_write_caches(reps, eversion, input, w);
-        t = curr_second()-startTime;
-
-        // Add result
-        nbytes = ((double)w)*((double)reps)*((double)sizeof(float))*4.0;
-        resultDB.AddResult("INT_W_L1", "", "GB/s",
-                (((double)nbytes) / (t*1.e9)));
-
-        // Begin L2 Tests
-        w = VECSIZE_SP_L2;
-        reps = REPS_SP_L2;
-
-        // Test Read L2 - ICC Code
-        startTime = curr_second();
-        #pragma offload target (mic)
-        res = testICC_read_caches(reps, eversion, w);
-        t = curr_second()-startTime; 
-
-        // Add result
-        nbytes = ((double)w)*((double)reps)*((double)sizeof(float))*4.0;
-        resultDB.AddResult("ICC_R_L2", "", "GB/s",
-                (((double)nbytes) / (t*1.e9)));
-
-        // Test Read L2 - Intrinsics Code
-        startTime = curr_second();
-        #pragma offload target (mic)
-        res = testIntrinsics_read_caches(reps, eversion, w);
-        t = curr_second()-startTime; 
-
-        // Add result
-        nbytes = ((double)w)*((double)reps)*((double)sizeof(float))*4.0;
-        resultDB.AddResult("INT_R_L2", "", "GB/s",
-                (((double)nbytes) / (t*1.e9)));
-
-        // Test Write L2 - ICC Code
-        startTime = curr_second();
-        #pragma offload target (mic)
-        res = testICC_write_caches(reps, eversion, input, w);
-        t = curr_second()-startTime;
-
-        // Add result
-        nbytes = ((double)w)*((double)reps)*((double)sizeof(float))*4.0;
-        resultDB.AddResult("ICC_W_L2", "", "GB/s",
-                (((double)nbytes) / (t*1.e9)));
-
-        // Test Write L2 - Intrinsics Code
-        startTime = curr_second();
-        #pragma offload target (mic)
-        res = testIntrinsics_write_caches(reps, eversion, input, w);
-        t = curr_second()-startTime;
-
-        // Add result
-        nbytes = ((double)w)*((double)reps)*((double)sizeof(float))*4.0;
-        resultDB.AddResult("INT_W_L2", "", "GB/s",
-                (((double)nbytes) / (t*1.e9)));
-#endif
+      case SWEEP_RMW:
+        return 2.0 * n * sizeof(float);
+      case SWEEP_STRIDED:
+        return (double)((n + stride - 1) / stride) * sizeof(float);
+      case SWEEP_GATHER:
+        return (double)n * (sizeof(float) + sizeof(int));
+      default:
+        return (double)n * sizeof(float);
     }
 }
 
-float __declspec(target(mic)) testICC_read(const int reps, const int eversion)
+// ****************************************************************************
+// Function: SweepPoint
+//
+// Purpose:
+//   Times one point of the working set sweep.  Each of the threads owns n
+//   elements, which it first touches itself, and then repeats the access
+//   pattern over them reps times.  The threads start together after a
+//   barrier and the time runs until the last of them is done.
+//
+// Arguments:
+//   pattern: the access pattern
+//   n: elements per thread, a multiple of 16
+//   threads: number of threads
+//   stride: element stride of the strided pattern
+//   reps: passes over the working set
+//
+// Returns:  seconds for all reps, or a negative value if allocation failed
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+__declspec(target(mic)) static double
+SweepPoint(int pattern, long n, int threads, long stride, long reps)
 {
-// #ifdef __MIC__ || __MIC2__
-#if defined(__MIC__) || defined(__MIC2__)
+    static volatile float sink;
 
-    size_t numElements;
-
-    if (eversion == 1)
-    {
-        numElements = VECSIZE_SP*MIC_THREADS;
-    }
-    else if (eversion == 2)
+    float *a = (float *)_mm_malloc(sizeof(float) * n * threads, 64);
+    int *idx = NULL;
+    if (pattern == SWEEP_GATHER)
     {
-        numElements = VECSIZE_SP*108;
+        idx = (int *)_mm_malloc(sizeof(int) * n * threads, 64);
     }
-    else
+    if (a == NULL || (pattern == SWEEP_GATHER && idx == NULL))
     {
-        numElements = VECSIZE_SP*92;
+        _mm_free(a);
+        _mm_free(idx);
+        return -1.0;
     }
 
-    float* a = (float*)_mm_malloc(sizeof(float)*numElements, 64);
-    __declspec(aligned(64))float res = 0.0;
-    #pragma ivdep
-    #pragma omp parallel for shared(a)
-    for (int q = 0; q < numElements; q++)
+    double start = 0.0, t = 0.0;
+    float res = 0.0f;
+    #pragma omp parallel num_threads(threads) reduction(+:res)
     {
-        a[q] = 1.0;
-    }
-
-    #pragma omp parallel shared(res)
-    {
-        __declspec(aligned(64))float b = 0.0;
-        int offset = VECSIZE_SP * omp_get_thread_num();
-
-        for (int m = 0; m < reps; m++)
+        const int tid = omp_get_thread_num();
+        float *b = a + (size_t)n * tid;
+        for (long q = 0; q < n; q++)
         {
-            #pragma vector aligned
-            #pragma ivdep
-            for (int q = offset; q < offset+VECSIZE_SP; q++)
-            {
-                b += a[q];
-            }
-            b += 1.0;
+            b[q] = 1.0f;
         }
-        #pragma omp critical
+        if (pattern == SWEEP_GATHER)
         {
-            res += b;
+            // Random permutation of the thread's own elements
+            int *ib = idx + (size_t)n * tid;
+            for (long q = 0; q < n; q++)
+            {
+                ib[q] = (int)q;
+            }
+            unsigned int x = 2463534242u + tid;
+            for (long q = n - 1; q > 0; q--)
+            {
+                x ^= x << 13;
+                x ^= x >> 17;
+                x ^= x << 5;
+                long j = x % (q + 1);
+                int tmp = ib[q];
+                ib[q] = ib[j];
+                ib[j] = tmp;
+            }
         }
-    }
-    _mm_free(a);
-    return res;
-#else
-    return 0.0;
-#endif
-}
-
-float __declspec(target(mic)) testIntrinsics_read(const int reps, 
-        const int eversion)
-{
-// #ifdef __MIC__ || __MIC2__
-#if defined(__MIC__) || defined(__MIC2__)
 
-    size_t numElements;
+        #pragma omp barrier
+        #pragma omp master
+        start = curr_second();
+        #pragma omp barrier
 
-    if (eversion == 1)
-    {
-        numElements = VECSIZE_SP*MIC_THREADS;
-    }
-    else if (eversion == 2)
-    {
-        numElements = VECSIZE_SP*108;
-    }
-    else
-    {
-        numElements = VECSIZE_SP*92;
-    }
-
-    float* a = (float*)_mm_malloc(sizeof(float)*numElements, 64);
-    __declspec(aligned(64))float res = 0.0;
-
-    #pragma vector aligned
-    #pragma ivdep
-    #pragma omp parallel for shared(a)
-    for (int q = 0; q < numElements; q++)
-    {
-        a[q] = 1.0;
-    }
-
-    #pragma omp parallel shared(res)
-    {
-        int offset = VECSIZE_SP * omp_get_thread_num();
-        __m512 b_0;
-        __m512 b_1;
-        __m512 b_2;
-        __m512 b_3;
-        __m512 b_4;
-        __m512 b_5;
-        __m512 b_6;
-        __m512 b_7;
-
-        for (int m = 0; m < reps; m++)
+        float sum = 0.0f;
+        float value = (float)tid;
+        for (long m = 0; m < reps; m++)
         {
-            b_0 = _mm512_setzero();
-            b_1 = _mm512_setzero();
-            b_2 = _mm512_setzero();
-            b_3 = _mm512_setzero();
-            b_4 = _mm512_setzero();
-            b_5 = _mm512_setzero();
-            b_6 = _mm512_setzero();
-            b_7 = _mm512_setzero();
-
-            #pragma vector aligned
-            #pragma ivdep
-            for (int q = offset; q < offset+VECSIZE_SP; q+=128)
+            switch (pattern)
             {
-                _mm_prefetch((const char *)&(a[q+128]), _MM_HINT_T0);
-                _mm_prefetch((const char *)&(a[q+144]), _MM_HINT_T0);
-                _mm_prefetch((const char *)&(a[q+160]), _MM_HINT_T0);
-                _mm_prefetch((const char *)&(a[q+176]), _MM_HINT_T0);
-                _mm_prefetch((const char *)&(a[q+192]), _MM_HINT_T0);
-                _mm_prefetch((const char *)&(a[q+208]), _MM_HINT_T0);
-                _mm_prefetch((const char *)&(a[q+224]), _MM_HINT_T0);
-                _mm_prefetch((const char *)&(a[q+240]), _MM_HINT_T0);
-
-                // For KNF, cheaply emulated to KNC
-                __m512 a_0 = _mm512_load_ps(&(a[q]));
-                __m512 a_1 = _mm512_load_ps(&(a[q+16]));
-                __m512 a_2 = _mm512_load_ps(&(a[q+32]));
-                __m512 a_3 = _mm512_load_ps(&(a[q+48]));
-                __m512 a_4 = _mm512_load_ps(&(a[q+64]));
-                __m512 a_5 = _mm512_load_ps(&(a[q+80]));
-                __m512 a_6 = _mm512_load_ps(&(a[q+96]));
-                __m512 a_7 = _mm512_load_ps(&(a[q+112]));
-
-                b_0 = _mm512_add_ps(b_0, a_0);
-                b_1 = _mm512_add_ps(b_1, a_1);
-                b_2 = _mm512_add_ps(b_2, a_2);
-                b_3 = _mm512_add_ps(b_3, a_3);
-                b_4 = _mm512_add_ps(b_4, a_4);
-                b_5 = _mm512_add_ps(b_5, a_5);
-                b_6 = _mm512_add_ps(b_6, a_6);
-                b_7 = _mm512_add_ps(b_7, a_7);
+              case SWEEP_READ:
+              {
+                  // One partial sum per lane, so the adds vectorize without
+                  // reassociating a single float sum
+                  float part[16] = {0.0f};
+                  for (long q = 0; q < n; q += 16)
+                  {
+                      #pragma vector aligned
+                      for (int j = 0; j < 16; j++)
+                      {
+                          part[j] += b[q + j];
+                      }
+                  }
+                  for (int j = 0; j < 16; j++)
+                  {
+                      sum += part[j];
+                  }
+                  break;
+              }
+              case SWEEP_WRITE:
+                #pragma vector aligned
+                #pragma ivdep
+                for (long q = 0; q < n; q++)
+                {
+                    b[q] = value;
+                }
+                break;
+              case SWEEP_RMW:
+                #pragma vector aligned
+                #pragma ivdep
+                for (long q = 0; q < n; q++)
+                {
+                    b[q] += value;
+                }
+                break;
+              case SWEEP_STRIDED:
+                for (long q = 0; q < n; q += stride)
+                {
+                    sum += b[q];
+                }
+                break;
+              case SWEEP_GATHER:
+              {
+                  const int *ib = idx + (size_t)n * tid;
+                  #pragma ivdep
+                  for (long q = 0; q < n; q++)
+                  {
+                      sum += b[ib[q]];
+                  }
+                  break;
+              }
             }
-            b_0 = _mm512_add_ps(b_0, b_1);
-            b_2 = _mm512_add_ps(b_2, b_3);
-            b_4 = _mm512_add_ps(b_4, b_5);
-            b_6 = _mm512_add_ps(b_6, b_7);
-            b_0 = _mm512_add_ps(b_0, b_2);
-            b_4 = _mm512_add_ps(b_4, b_6);
-            b_0 = _mm512_add_ps(b_0, b_4);
+            value += 1.0f;
         }
 
-        #pragma omp critical
-        {
-            res += _mm512_reduce_add_ps(b_0);
-        }
+        #pragma omp barrier
+        #pragma omp master
+        t = curr_second() - start;
+
+        // Keep the stores and sums observable
+        res += sum + b[0] + b[n - 1];
     }
+    sink = res;
+
     _mm_free(a);
-    return res;
-#else
-    return 0.0;
-#endif
+    _mm_free(idx);
+    return t;
 }
 
-float __declspec(target(mic)) testICC_write(const int reps, 
-        const int eversion, const float value)
+// ****************************************************************************
+// Function: RunScaling
+//
+// Purpose:
+//   Runs each pattern over the largest footprint with teams of pinned
+//   threads that grow core by core through the first socket, then across
+//   sockets, then onto the SMT siblings.  Reports GB/s per team size and the
+//   scaling efficiency against one thread, where memory bandwidth
+//   saturation shows up as a falling efficiency.
+//
+// Arguments:
+//   resultDB: the results database
+//   patterns: the access patterns
+//   footprint: total working set in bytes
+//   stride: element stride of the strided pattern
+//   passes: samples per point
+//   verbose: print each point
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+static void RunScaling(ResultDatabase &resultDB, const vector<int> &patterns,
+                       long long footprint, long stride, int passes,
+                       bool verbose)
 {
-// #ifdef __MIC__ || __MIC2__
-#if defined(__MIC__) || defined(__MIC2__)
-
-    size_t numElements;
+    vector<int> cpus, teamSizes;
+    HostScalingSweep(cpus, teamSizes);
 
-    if (eversion == 1)
-    {
-        numElements = VECSIZE_SP*MIC_THREADS;
-    }
-    else if (eversion == 2)
-    {
-        numElements = VECSIZE_SP*108;
-    }
-    else
+    for (size_t p = 0; p < patterns.size(); p++)
     {
-        numElements = VECSIZE_SP*92;
-    }
-
-    float* a = (float*)_mm_malloc(sizeof(float)*numElements, 64);
-    __declspec(aligned(64))float res = 0.0;
+        const int pattern = patterns[p];
+        const string test = sweepTestNames[pattern];
+        vector<vector<double> > bw(teamSizes.size());
 
-    #pragma vector aligned
-    #pragma ivdep
-    for (int q = 0; q < numElements; q++)
-    {
-        a[q] = 1.0;
-    }
+        for (size_t i = 0; i < teamSizes.size(); i++)
+        {
+            const int threads = teamSizes[i];
+            const long n = (long)(footprint / sizeof(float) / threads) &
+                           ~15L;
+            if (n == 0 || !PinOpenMPThreads(vector<int>(cpus.begin(),
+                                              cpus.begin() + threads)))
+            {
+                continue;
+            }
+            const double bytes = SweepPatternBytes(pattern, n, stride) *
+                                 threads;
+            const long reps = max(1L, (long)(SWEEP_BYTES / bytes));
 
-    #pragma omp parallel shared(res)
-    {
-        int offset = VECSIZE_SP * omp_get_thread_num();
-        __declspec(aligned(64))float writeData = value + 
-            static_cast<float>(omp_get_thread_num());
+            char attStr[256];
+            sprintf(attStr, "Threads:%03d", threads);
+            for (int pass = 0; pass < passes; pass++)
+            {
+                double t = SweepPoint(pattern, n, threads, stride, reps);
+                if (t < 0.0)
+                {
+                    cerr << "Error: could not allocate the working set\n";
+                    UnpinOpenMPThreads();
+                    return;
+                }
+                bw[i].push_back(bytes * reps / (t * 1.e9));
+                resultDB.AddResult(test + "_Scaling", attStr, "GB/s",
+                                   bw[i].back());
+            }
+            if (verbose)
+            {
+                cerr << test << " " << attStr << ": " << bw[i].back()
+                     << " GB/s\n";
+            }
+        }
+        UnpinOpenMPThreads();
 
-        for (int m = 0; m < reps; m++)
+        // Efficiency of each team against the same pass of one thread
+        for (size_t i = 0; i < teamSizes.size(); i++)
         {
-            #pragma vector aligned
-            #pragma ivdep
-            for (int q = offset; q < offset+VECSIZE_SP; q++)
+            char attStr[256];
+            sprintf(attStr, "Threads:%03d", teamSizes[i]);
+            for (size_t pass = 0; pass < bw[i].size() &&
+                                  pass < bw[0].size(); pass++)
             {
-                a[q] += writeData;
+                resultDB.AddResult(test + "_ScalingEfficiency", attStr, "%",
+                    100.0 * bw[i][pass] / (teamSizes[i] * bw[0][pass]));
             }
-            writeData += 1.0;
         }
     }
-
-    // Sum something in a, avoid compiler optimizations
-    res = a[0] + a[numElements-1];
-    _mm_free(a);
-    return res;
-#else
-    return 0.0;
-#endif
 }
 
-float __declspec(target(mic)) testIntrinsics_write(const int reps, 
-        const int eversion, const float value)
+// ****************************************************************************
+// Function: runBenchmark
+//
+// Purpose:
+//   Sweeps the total working set from --min-footprint to --max-footprint
+//   in steps of 1.5x and 2x for each access pattern, and reports GB/s per
+//   point.  Bandwidth drops where the per-thread share outgrows each cache
+//   level, so the cliffs show the cache sizes of the target.
+//
+// Arguments:
+//  resultDB: the benchmark stores its results in this ResultDatabase
+//  op: the options parser / parameter database
+//
+// Returns:  nothing
+//
+// Programmer: Alexander Heinecke
+// Creation: July 23, 2010
+//
+// Modifications:
+// Dec. 12, 2012 - Kyle Spafford - Updates and SHOC coding style conformance.
+// October 16, 2026 - Parameterized working set sweep replaces the fixed
+//   L1, L2 and memory cases.
+//
+// ****************************************************************************
+static void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
 {
-// #ifdef __MIC__ ||  __MIC2__
-#if defined(__MIC__) || defined(__MIC2__)
-
-    size_t numElements;
-
-    if (eversion == 1)
-    {
-        numElements = VECSIZE_SP*MIC_THREADS;
-    }
-    else if (eversion == 2)
+    const bool verbose = op.getOptionBool("verbose");
+    const bool useMIC = UseOffload(op);
+    const int micdev = op.getOptionInt("target");
+
+    const long long minFootprint =
+        (long long)op.getOptionInt("min-footprint") * 1024;
+    const long long maxFootprint =
+        (long long)op.getOptionInt("max-footprint") * 1024 * 1024;
+    const long stride = op.getOptionInt("access-stride");
+    int threads = op.getOptionInt("threads");
+    if (threads <= 0)
     {
-        numElements = VECSIZE_SP*108;
+        threads = BackendThreads(op);
     }
-    else
+    if (stride < 1 || minFootprint <= 0 || minFootprint > maxFootprint)
     {
-        numElements = VECSIZE_SP*92;
+        cerr << "Error: invalid footprint range or access stride\n";
+        return;
     }
 
-    float* a = (float*)_mm_malloc(sizeof(float)*numElements, 64);
-    __declspec(aligned(64))float res = 0.0;
-
-    #pragma omp parallel shared(res)
+    vector<int> patterns;
+    vector<string> names = op.getOptionVecString("patterns");
+    for (size_t i = 0; i < names.size(); i++)
     {
-        int offset = VECSIZE_SP * omp_get_thread_num();
-        __declspec(aligned(64))float writeData = value + 
-            static_cast<float>(omp_get_thread_num());
-
-        __m512 toWrite = _mm512_load_ps(&(writeData));
-        __m512 one = _mm512_set_1to16_ps(1.0);
-
-        for (int m = 0; m < reps; m++)
+        int p = 0;
+        while (p < NUM_SWEEP_PATTERNS && names[i] != sweepPatternNames[p])
         {
-            #pragma vector aligned
-            #pragma ivdep
-            for (int q = offset; q < offset+VECSIZE_SP; q+=128)
-            {
-                // Only KNF according to spreadsheet
-                _mm_prefetch((const char *)&(a[q+128]), _MM_HINT_ENTA);
-                _mm_prefetch((const char *)&(a[q+144]), _MM_HINT_ENTA);
-                _mm_prefetch((const char *)&(a[q+160]), _MM_HINT_ENTA);
-                _mm_prefetch((const char *)&(a[q+176]), _MM_HINT_ENTA);
-                _mm_prefetch((const char *)&(a[q+192]), _MM_HINT_ENTA);
-                _mm_prefetch((const char *)&(a[q+208]), _MM_HINT_ENTA);
-                _mm_prefetch((const char *)&(a[q+224]), _MM_HINT_ENTA);
-                _mm_prefetch((const char *)&(a[q+240]), _MM_HINT_ENTA);
-
-                __m512 a_0 = toWrite;
-                __m512 a_1 = toWrite;
-                __m512 a_2 = toWrite;
-                __m512 a_3 = toWrite;
-                __m512 a_4 = toWrite;
-                __m512 a_5 = toWrite;
-                __m512 a_6 = toWrite;
-                __m512 a_7 = toWrite;
-
-                // For KNF, cheaply converted to KNC
-                _mm512_store_ps(&(a[q]), a_0);
-                _mm512_store_ps(&(a[q+16]), a_1);
-                _mm512_store_ps(&(a[q+32]), a_2);
-                _mm512_store_ps(&(a[q+48]), a_3);
-                _mm512_store_ps(&(a[q+64]), a_4);
-                _mm512_store_ps(&(a[q+80]), a_5);
-                _mm512_store_ps(&(a[q+96]), a_6);
-                _mm512_store_ps(&(a[q+112]), a_7);
-            }
-            toWrite = _mm512_add_ps(toWrite, one);
+            p++;
         }
+        if (p == NUM_SWEEP_PATTERNS)
+        {
+            cerr << "Error: unknown access pattern \"" << names[i] << "\"\n";
+            return;
+        }
+        patterns.push_back(p);
     }
 
-    // Sum something in a to avoid compiler optimizations
-    res = a[0] + a[numElements-1];
-    _mm_free(a);
-    return res;
-#else
-    return 0.0;
-#endif
-}
-
-float __declspec(target(mic)) testICC_read_caches(const int reps, 
-        const int eversion, const int worksize)
-{
-// #ifdef __MIC__ ||  __MIC2__
-#if defined(__MIC__) || defined(__MIC2__)
-
-    size_t numElements;
-    numElements = worksize*4;
-
-    float* a = (float*)_mm_malloc(sizeof(float)*numElements, 64);
-    __declspec(aligned(64))float res = 0.0;
-
-    #pragma vector aligned
-    #pragma ivdep
-    for (int q = 0; q < numElements; q++)
-    {
-        a[q] = 1.0;
-    }
-
-    #pragma omp parallel num_threads(4) shared(res)
+    // Footprints of min, 1.5*min, 2*min, 3*min, ... up to max, each split
+    // evenly over the threads in whole cache lines
+    vector<long long> footprints;
+    for (long long f = minFootprint; f <= maxFootprint; f *= 2)
     {
-        __declspec(aligned(64))float b = 0.0;
-        int offset = worksize * omp_get_thread_num();
-
-        for (int m = 0; m < reps; m++)
+        footprints.push_back(f);
+        if (f + f / 2 <= maxFootprint)
         {
-            #pragma vector aligned
-            #pragma ivdep
-            for (int q = offset; q < offset+worksize; q++)
-            {
-                b += a[q];
-            }
-            b += 1.0;
+            footprints.push_back(f + f / 2);
         }
+    }
 
-        #pragma omp critical
+    if (op.getOptionBool("scaling"))
+    {
+        if (useMIC)
         {
-            res += b;
+            cerr << "Error: --scaling needs the host backend\n";
+            return;
         }
+        RunScaling(resultDB, patterns, maxFootprint, stride,
+                   op.getOptionInt("passes"), verbose);
+        return;
     }
-    _mm_free(a);
-    return res;
-#else
-    return 0.0;
-#endif
-}
-
-float __declspec(target(mic)) testICC_write_caches(const int reps, 
-        const int eversion, const float value, const int worksize)
-{
-// #ifdef __MIC__ ||  __MIC2__
-#if defined(__MIC__) || defined(__MIC2__)
-    size_t numElements;
-    numElements = worksize*4;
 
-    float* a = (float*)_mm_malloc(sizeof(float)*numElements, 64);
-    __declspec(aligned(64))float res = 0.0;
+    // With --rel-ci, noisy points keep repeating after the rest converged
+    Measurement meas(op);
 
-    #pragma omp parallel num_threads(4) shared(res)
+    for (int pass = 0; !meas.Finished(); pass++)
     {
-        int offset = worksize * omp_get_thread_num();
-        __declspec(aligned(64))float writeData = value + 
-            static_cast<float>(omp_get_thread_num());
-
-        for (int m = 0; m < reps; m++)
+        for (size_t p = 0; p < patterns.size(); p++)
         {
-            #pragma vector aligned
-            #pragma ivdep
-            for (int q = offset; q < offset+worksize; q++)
+            for (size_t i = 0; i < footprints.size(); i++)
             {
-                a[q] += writeData;
+                const int pattern = patterns[p];
+                const long n = (long)(footprints[i] / sizeof(float) /
+                                      threads) & ~15L;
+                if (n == 0)
+                {
+                    continue;
+                }
+                char sizeStr[256];
+                sprintf(sizeStr, "% 8lldkB", footprints[i] / 1024);
+                string region = string(sweepTestNames[pattern]) + sizeStr;
+                if (meas.Done(region))
+                {
+                    continue;
+                }
+
+                const double bytes =
+                    SweepPatternBytes(pattern, n, stride) * threads;
+                const long reps = max(1L, (long)(SWEEP_BYTES / bytes));
+
+                double t;
+                #pragma offload target(mic:micdev) if(useMIC)
+                t = SweepPoint(pattern, n, threads, stride, reps);
+                if (t < 0.0)
+                {
+                    cerr << "Error: could not allocate a " << sizeStr
+                         << " working set\n";
+                    return;
+                }
+                // Samples are seconds per pass over the working set
+                meas.Add(region, t / reps);
+
+                if (verbose)
+                {
+                    cerr << region << ": " << bytes * reps / (t * 1.e9)
+                         << " GB/s\n";
+                }
             }
-            writeData += 1.0;
         }
     }
 
-    // Sum something in a, avoid compiler optimizations
-    res = a[0] + a[numElements-1];
-    _mm_free(a);
-    return res;
-#else
-    return 0.0;
-#endif
-}
-
-float __declspec(target(mic)) testIntrinsics_read_caches(const int reps, 
-        const int eversion, const int worksize)
-{
-// #ifdef __MIC__ || __MIC2__
-#if defined(__MIC__) || defined(__MIC2__)
-
-    size_t numElements;
-    numElements = worksize*4;
-
-    float* a = (float*)_mm_malloc(sizeof(float)*numElements, 64);
-    __declspec(aligned(64))float res = 0.0;
-
-    #pragma vector aligned
-    #pragma ivdep
-    for (int q = 0; q < numElements; q++)
+    for (size_t p = 0; p < patterns.size(); p++)
     {
-        a[q] = 1.0;
-    }
-
-    #pragma omp parallel num_threads(4) shared(res)
-    {
-        int offset = worksize * omp_get_thread_num();
-
-        __m512 b_0 = _mm512_setzero();//KNF, cheaply emulated to KNC
-        __m512 b_1 = _mm512_setzero();
-        __m512 b_2 = _mm512_setzero();
-        __m512 b_3 = _mm512_setzero();
-        __m512 b_4 = _mm512_setzero();
-        __m512 b_5 = _mm512_setzero();
-        __m512 b_6 = _mm512_setzero();
-        __m512 b_7 = _mm512_setzero();
-
-        for (int m = 0; m < reps; m++)
+        const int pattern = patterns[p];
+        const char *test = sweepTestNames[pattern];
+        for (size_t i = 0; i < footprints.size(); i++)
         {
-            #pragma vector aligned
-            #pragma ivdep
-            for (int q = offset; q < offset+worksize; q+=128)
+            const long n = (long)(footprints[i] / sizeof(float) /
+                                  threads) & ~15L;
+            if (n == 0)
+            {
+                continue;
+            }
+            char sizeStr[256];
+            sprintf(sizeStr, "% 8lldkB", footprints[i] / 1024);
+            string region = string(test) + sizeStr;
+            const double bytes = SweepPatternBytes(pattern, n, stride) *
+                                 threads;
+
+            vector<double> times = meas.Samples(region);
+            for (size_t j = 0; j < times.size(); j++)
             {
-                // KNF, emulated on KNC
-                __m512 a_0 = _mm512_load_ps(&(a[q]));
-                __m512 a_1 = _mm512_load_ps(&(a[q+16]));
-                __m512 a_2 = _mm512_load_ps(&(a[q+32]));
-                __m512 a_3 = _mm512_load_ps(&(a[q+48]));
-                __m512 a_4 = _mm512_load_ps(&(a[q+64]));
-                __m512 a_5 = _mm512_load_ps(&(a[q+80]));
-                __m512 a_6 = _mm512_load_ps(&(a[q+96]));
-                __m512 a_7 = _mm512_load_ps(&(a[q+112]));
-
-                // Works for both KNF and KNC
-                b_0 = _mm512_add_ps(b_0, a_0);
-                b_1 = _mm512_add_ps(b_1, a_1);
-                b_2 = _mm512_add_ps(b_2, a_2);
-                b_3 = _mm512_add_ps(b_3, a_3);
-                b_4 = _mm512_add_ps(b_4, a_4);
-                b_5 = _mm512_add_ps(b_5, a_5);
-                b_6 = _mm512_add_ps(b_6, a_6);
-                b_7 = _mm512_add_ps(b_7, a_7);
+                resultDB.AddResult(test, sizeStr, "GB/s",
+                                   bytes / (times[j] * 1.e9));
             }
-            // Works for both KNF and KNC
-            b_0 = _mm512_add_ps(b_0, b_1);
-            b_2 = _mm512_add_ps(b_2, b_3);
-            b_4 = _mm512_add_ps(b_4, b_5);
-            b_6 = _mm512_add_ps(b_6, b_7);
-            b_0 = _mm512_add_ps(b_0, b_2);
-            b_4 = _mm512_add_ps(b_4, b_6);
-            b_0 = _mm512_add_ps(b_0, b_4);
+            meas.RecordConfidence(resultDB, region, test, sizeStr);
         }
 
-        #pragma omp critical
+        // Main memory bandwidth, at the largest footprint, is the memory
+        // ceiling of the roofline report
+        if ((pattern == SWEEP_READ || pattern == SWEEP_WRITE) &&
+            !footprints.empty())
         {
-            res += _mm512_reduce_add_ps(b_0);// Common for both KNF and KNC
+            char sizeStr[256];
+            sprintf(sizeStr, "% 8lldkB", footprints.back() / 1024);
+            resultDB.SetCeiling(test, sizeStr, "BW");
         }
     }
-    _mm_free(a);
-    return res;
-#else
-    return 0.0;
-#endif
 }
 
-float __declspec(target(mic)) testIntrinsics_write_caches(const int reps, 
-        const int eversion, const float value, const int worksize)
-{
-// #ifdef __MIC__ || __MIC2__
-#if defined(__MIC__) || defined(__MIC2__)
-
-    size_t numElements;
-    numElements = worksize*4;
-    float* a = (float*)_mm_malloc(sizeof(float)*numElements, 64);
-    __declspec(aligned(64))float res = 0.0;
-
-    #pragma omp parallel num_threads(4) shared(res)
-    {
-        int offset = worksize * omp_get_thread_num();
-        __declspec(aligned(64))float writeData = value + 
-            static_cast<float>(omp_get_thread_num());
-
-        __m512 toWrite = _mm512_load_ps(&(writeData));
-        __m512 one = _mm512_set_1to16_ps(1.0);
-
-        for (int m = 0; m < reps; m++)
-        {
-            #pragma vector aligned
-            #pragma ivdep
-            for (int q = offset; q < offset+worksize; q+=128)
-            {
-                __m512 a_0 = toWrite;
-                __m512 a_1 = toWrite;
-                __m512 a_2 = toWrite;
-                __m512 a_3 = toWrite;
-                __m512 a_4 = toWrite;
-                __m512 a_5 = toWrite;
-                __m512 a_6 = toWrite;
-                __m512 a_7 = toWrite;
-
-                // For KNF, cheaply converted on KNC
-                _mm512_store_ps(&(a[q]), a_0);
-                _mm512_store_ps(&(a[q+16]), a_1);
-                _mm512_store_ps(&(a[q+32]), a_2);
-                _mm512_store_ps(&(a[q+48]), a_3);
-                _mm512_store_ps(&(a[q+64]), a_4);
-                _mm512_store_ps(&(a[q+80]), a_5);
-                _mm512_store_ps(&(a[q+96]), a_6);
-                _mm512_store_ps(&(a[q+112]), a_7);
-            }
-            toWrite = _mm512_add_ps(toWrite, one); // Common for KNF and KNC
-        }
-    }
-    // Sum something in a to avoid compiler optimizations
-    res = a[0] + a[numElements-1];
-    _mm_free(a);
-    return res;
-#else
-    return 0.0;
-#endif
-}
+SHOC_REGISTER_BENCHMARK(DeviceMemory);
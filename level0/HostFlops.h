@@ -0,0 +1,469 @@
+// This example from an alpha release of the Scalable HeterOgeneous Computing
+// (SHOC) Benchmark Suite Alpha v1.1.4a-mic for Intel MIC architecture
+// Contact: Kyle Spafford <kys@ornl.gov>
+//          Rezaur Rahman <rezaur.rahman@intel.com>
+//
+// Copyright (c) 2011, UT-Battelle, LLC
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of Oak Ridge National Laboratory, nor UT-Battelle, LLC, 
+//    nor the names of its contributors may be used to endorse or promote 
+//    products derived from this software without specific prior written 
+//    permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, 
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
+// THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef HOST_FLOPS_H
+#define HOST_FLOPS_H
+
+#include "omp.h"
+#include "HostCPU.h"
+#include "MaxFlops.h"
+
+// ****************************************************************************
+// File:  HostFlops.h
+//
+// Purpose:
+//   The MaxFlops operation mixes (Add1..Add8, Mul1..Mul8, MAdd1..MAdd8,
+//   MulMAdd1..MulMAdd8) for the host, built from the same MOP macros as the
+//   card kernels.  Every mix is specialized at compile time for each
+//   instruction set: plain scalar code, and SSE, AVX2 and AVX-512 vectors
+//   (GCC vector extensions, so the operators in the macros apply lane-wise).
+//   The AVX2 and AVX-512 versions are compiled with function target
+//   attributes and may only run after HostSupports confirms the ISA; SSE2
+//   is part of x86-64 and always runs.
+//
+// Creation:    October 16, 2026
+//
+// ****************************************************************************
+enum FlopsISA
+{
+    FLOPS_SCALAR,
+    FLOPS_SSE,
+    FLOPS_AVX2,
+    FLOPS_AVX512,
+    NUM_FLOPS_ISAS
+};
+
+static const char *flopsISANames[NUM_FLOPS_ISAS] =
+    { "scalar", "sse", "avx2", "avx512" };
+
+// Vector register width in bytes (0: one element)
+static const int flopsISABytes[NUM_FLOPS_ISAS] = { 0, 16, 32, 64 };
+
+// Whether the compiler may contract a multiply and add into one FMA
+static const bool flopsISAFMA[NUM_FLOPS_ISAS] = { false, false, true, true };
+
+enum FlopsKernel
+{
+    FLOPS_ADD1, FLOPS_ADD2, FLOPS_ADD4, FLOPS_ADD8,
+    FLOPS_MUL1, FLOPS_MUL2, FLOPS_MUL4, FLOPS_MUL8,
+    FLOPS_MADD1, FLOPS_MADD2, FLOPS_MADD4, FLOPS_MADD8,
+    FLOPS_MULMADD1, FLOPS_MULMADD2, FLOPS_MULMADD4, FLOPS_MULMADD8,
+    NUM_FLOPS_KERNELS
+};
+
+static const char *flopsKernelNames[NUM_FLOPS_KERNELS] =
+    { "Add1", "Add2", "Add4", "Add8",
+      "Mul1", "Mul2", "Mul4", "Mul8",
+      "MAdd1", "MAdd2", "MAdd4", "MAdd8",
+      "MulMAdd1", "MulMAdd2", "MulMAdd4", "MulMAdd8" };
+
+// Floating point operations per element and iteration, counted from the
+// macro expansions below
+static const int flopsKernelFlops[NUM_FLOPS_KERNELS] =
+    { 240, 240, 240, 240,
+      400, 400, 400, 400,
+      480, 480, 480, 480,
+      480, 480, 480, 480 };
+
+// Constant operands of each kernel family, as in the card version
+static const double flopsKernelV1[NUM_FLOPS_KERNELS] =
+    { 10.0, 10.0, 10.0, 10.0, 1.01, 1.01, 1.01, 1.01,
+      10.0, 10.0, 10.0, 10.0, 3.75, 3.75, 3.75, 3.75 };
+static const double flopsKernelV2[NUM_FLOPS_KERNELS] =
+    { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,
+      0.9899, 0.9899, 0.9899, 0.9899, 0.355, 0.355, 0.355, 0.355 };
+
+static bool FlopsISASupported(FlopsISA isa)
+{
+    switch (isa)
+    {
+      case FLOPS_AVX2:
+        return HostSupports(ISA_AVX2);
+      case FLOPS_AVX512:
+        return HostSupports(ISA_AVX512);
+      default:
+        return true;
+    }
+}
+
+// Elements of type T per register
+template <class T>
+static int FlopsISALanes(FlopsISA isa)
+{
+    return flopsISABytes[isa] ? flopsISABytes[isa] / (int)sizeof(T) : 1;
+}
+
+// The kernels are inlined into the per-ISA entry points below, so they are
+// compiled for that entry point's target
+#define SHOC_FLOPS_INLINE inline __attribute__((always_inline))
+
+// Keeps the scalar variant scalar: the independent chains of Add8 and
+// friends would otherwise be packed into vectors
+#if defined(__GNUC__) && !defined(__INTEL_COMPILER) && !defined(__clang__)
+#define SHOC_NO_VECTORIZE \
+    __attribute__((optimize("no-tree-vectorize", "no-tree-slp-vectorize")))
+#else
+#define SHOC_NO_VECTORIZE
+#endif
+
+// ****************************************************************************
+// Function: FlopsElement
+//
+// Purpose:
+//   Runs one operation mix on one register's worth of elements: the body of
+//   the card kernel for a single gid, with V a vector or scalar type.
+//
+// Arguments:
+//   x: the elements, updated in place
+//   nIters: iterations of the unrolled operation block
+//   v1, v2: the kernel's constant operands, splatted across the lanes
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T, class V, int K>
+static SHOC_FLOPS_INLINE void FlopsElement(V &x, const int nIters,
+                                           const V &v1, const V &v2)
+{
+    const V v = v1;
+    if (K == FLOPS_ADD1 || K == FLOPS_MADD1 || K == FLOPS_MULMADD1)
+    {
+        V s = x;
+        for (int j = 0; j < nIters; ++j)
+        {
+            if (K == FLOPS_ADD1)
+            {
+                ADD1_MOP20 ADD1_MOP20 ADD1_MOP20 ADD1_MOP20 ADD1_MOP20
+                ADD1_MOP20 ADD1_MOP20 ADD1_MOP20 ADD1_MOP20 ADD1_MOP20
+                ADD1_MOP20 ADD1_MOP20
+            }
+            else if (K == FLOPS_MADD1)
+            {
+                MADD1_MOP20 MADD1_MOP20 MADD1_MOP20 MADD1_MOP20
+                MADD1_MOP20 MADD1_MOP20 MADD1_MOP20 MADD1_MOP20
+                MADD1_MOP20 MADD1_MOP20 MADD1_MOP20 MADD1_MOP20
+            }
+            else
+            {
+                MULMADD1_MOP20 MULMADD1_MOP20 MULMADD1_MOP20
+                MULMADD1_MOP20 MULMADD1_MOP20 MULMADD1_MOP20
+                MULMADD1_MOP20 MULMADD1_MOP20
+            }
+        }
+        x = s;
+    }
+    else if (K == FLOPS_ADD2 || K == FLOPS_MADD2 || K == FLOPS_MULMADD2)
+    {
+        V s = x;
+        V s2 = (T)10.0f - s;
+        for (int j = 0; j < nIters; ++j)
+        {
+            if (K == FLOPS_ADD2)
+            {
+                ADD2_MOP20 ADD2_MOP20 ADD2_MOP20
+                ADD2_MOP20 ADD2_MOP20 ADD2_MOP20
+            }
+            else if (K == FLOPS_MADD2)
+            {
+                MADD2_MOP20 MADD2_MOP20 MADD2_MOP20
+                MADD2_MOP20 MADD2_MOP20 MADD2_MOP20
+            }
+            else
+            {
+                MULMADD2_MOP20 MULMADD2_MOP20
+                MULMADD2_MOP20 MULMADD2_MOP20
+            }
+        }
+        x = s + s2;
+    }
+    else if (K == FLOPS_ADD4 || K == FLOPS_MADD4 || K == FLOPS_MULMADD4)
+    {
+        V s = x;
+        V s2 = (T)10.0f - s;
+        V s3 = (T)9.0f - s;
+        V s4 = (T)9.0f - s2;
+        for (int j = 0; j < nIters; ++j)
+        {
+            if (K == FLOPS_ADD4)
+            {
+                ADD4_MOP10 ADD4_MOP10 ADD4_MOP10
+                ADD4_MOP10 ADD4_MOP10 ADD4_MOP10
+            }
+            else if (K == FLOPS_MADD4)
+            {
+                MADD4_MOP10 MADD4_MOP10 MADD4_MOP10
+                MADD4_MOP10 MADD4_MOP10 MADD4_MOP10
+            }
+            else
+            {
+                MULMADD4_MOP10 MULMADD4_MOP10
+                MULMADD4_MOP10 MULMADD4_MOP10
+            }
+        }
+        x = (s + s2) + (s3 + s4);
+    }
+    else if (K == FLOPS_ADD8 || K == FLOPS_MADD8 || K == FLOPS_MULMADD8)
+    {
+        V s = x;
+        V s2 = (T)10.0f - s;
+        V s3 = (T)9.0f - s;
+        V s4 = (T)9.0f - s2;
+        V s5 = (T)8.0f - s;
+        V s6 = (T)8.0f - s2;
+        V s7 = (T)7.0f - s;
+        V s8 = (T)7.0f - s2;
+        for (int j = 0; j < nIters; ++j)
+        {
+            if (K == FLOPS_ADD8)
+            {
+                ADD8_MOP5 ADD8_MOP5 ADD8_MOP5
+                ADD8_MOP5 ADD8_MOP5 ADD8_MOP5
+            }
+            else if (K == FLOPS_MADD8)
+            {
+                MADD8_MOP5 MADD8_MOP5 MADD8_MOP5
+                MADD8_MOP5 MADD8_MOP5 MADD8_MOP5
+            }
+            else
+            {
+                MULMADD8_MOP5 MULMADD8_MOP5
+                MULMADD8_MOP5 MULMADD8_MOP5
+            }
+        }
+        x = ((s + s2) + (s3 + s4)) + ((s5 + s6) + (s7 + s8));
+    }
+    else
+    {
+        // The Mul family starts from constants rather than the data
+        V s = x - x + (T)0.999f;
+        V s2 = s - (T)0.0001f;
+        V s3 = s - (T)0.0002f;
+        V s4 = s - (T)0.0003f;
+        V s5 = s - (T)0.0004f;
+        V s6 = s - (T)0.0005f;
+        V s7 = s - (T)0.0006f;
+        V s8 = s - (T)0.0007f;
+        for (int j = 0; j < nIters; ++j)
+        {
+            if (K == FLOPS_MUL1)
+            {
+                MUL1_MOP20 MUL1_MOP20 MUL1_MOP20 MUL1_MOP20 MUL1_MOP20
+                MUL1_MOP20 MUL1_MOP20 MUL1_MOP20 MUL1_MOP20 MUL1_MOP20
+            }
+            else if (K == FLOPS_MUL2)
+            {
+                MUL2_MOP20 MUL2_MOP20 MUL2_MOP20 MUL2_MOP20 MUL2_MOP20
+            }
+            else if (K == FLOPS_MUL4)
+            {
+                MUL4_MOP10 MUL4_MOP10 MUL4_MOP10 MUL4_MOP10 MUL4_MOP10
+            }
+            else
+            {
+                MUL8_MOP5 MUL8_MOP5 MUL8_MOP5 MUL8_MOP5 MUL8_MOP5
+            }
+        }
+        if (K == FLOPS_MUL1)
+            x = s;
+        else if (K == FLOPS_MUL2)
+            x = s + s2;
+        else if (K == FLOPS_MUL4)
+            x = (s + s2) + (s3 + s4);
+        else
+            x = ((s + s2) + (s3 + s4)) + ((s5 + s6) + (s7 + s8));
+    }
+}
+
+template <class T, class V, int K>
+static SHOC_FLOPS_INLINE void FlopsLoop(T *data, const long n,
+                                        const int nIters, const T v1,
+                                        const T v2)
+{
+    V *x = (V *)data;
+    const long nVec = n / (long)(sizeof(V) / sizeof(T));
+    const V w1 = (V)(x[0] - x[0]) + v1;
+    const V w2 = (V)(x[0] - x[0]) + v2;
+    for (long i = 0; i < nVec; i++)
+    {
+        FlopsElement<T, V, K>(x[i], nIters, w1, w2);
+    }
+}
+
+// ****************************************************************************
+// Function: FlopsBlock
+//
+// Purpose:
+//   Runs one kernel over n elements with register type V.
+//
+// Arguments:
+//   kernel: the operation mix
+//   data: the elements, aligned to the register width
+//   n: number of elements, a multiple of the lanes of V
+//   nIters: iterations of the unrolled operation block
+//   v1, v2: the kernel's constant operands
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T, class V>
+static SHOC_FLOPS_INLINE void FlopsBlock(FlopsKernel kernel, T *data,
+                                         long n, int nIters, T v1, T v2)
+{
+    switch (kernel)
+    {
+      case FLOPS_ADD1:
+        FlopsLoop<T, V, FLOPS_ADD1>(data, n, nIters, v1, v2); break;
+      case FLOPS_ADD2:
+        FlopsLoop<T, V, FLOPS_ADD2>(data, n, nIters, v1, v2); break;
+      case FLOPS_ADD4:
+        FlopsLoop<T, V, FLOPS_ADD4>(data, n, nIters, v1, v2); break;
+      case FLOPS_ADD8:
+        FlopsLoop<T, V, FLOPS_ADD8>(data, n, nIters, v1, v2); break;
+      case FLOPS_MUL1:
+        FlopsLoop<T, V, FLOPS_MUL1>(data, n, nIters, v1, v2); break;
+      case FLOPS_MUL2:
+        FlopsLoop<T, V, FLOPS_MUL2>(data, n, nIters, v1, v2); break;
+      case FLOPS_MUL4:
+        FlopsLoop<T, V, FLOPS_MUL4>(data, n, nIters, v1, v2); break;
+      case FLOPS_MUL8:
+        FlopsLoop<T, V, FLOPS_MUL8>(data, n, nIters, v1, v2); break;
+      case FLOPS_MADD1:
+        FlopsLoop<T, V, FLOPS_MADD1>(data, n, nIters, v1, v2); break;
+      case FLOPS_MADD2:
+        FlopsLoop<T, V, FLOPS_MADD2>(data, n, nIters, v1, v2); break;
+      case FLOPS_MADD4:
+        FlopsLoop<T, V, FLOPS_MADD4>(data, n, nIters, v1, v2); break;
+      case FLOPS_MADD8:
+        FlopsLoop<T, V, FLOPS_MADD8>(data, n, nIters, v1, v2); break;
+      case FLOPS_MULMADD1:
+        FlopsLoop<T, V, FLOPS_MULMADD1>(data, n, nIters, v1, v2); break;
+      case FLOPS_MULMADD2:
+        FlopsLoop<T, V, FLOPS_MULMADD2>(data, n, nIters, v1, v2); break;
+      case FLOPS_MULMADD4:
+        FlopsLoop<T, V, FLOPS_MULMADD4>(data, n, nIters, v1, v2); break;
+      default:
+        FlopsLoop<T, V, FLOPS_MULMADD8>(data, n, nIters, v1, v2); break;
+    }
+}
+
+// Per-ISA entry points
+template <class T>
+static SHOC_NO_VECTORIZE void FlopsScalar(FlopsKernel kernel, T *data,
+                                          long n, int nIters, T v1, T v2)
+{
+    FlopsBlock<T, T>(kernel, data, n, nIters, v1, v2);
+}
+
+template <class T>
+static void FlopsSSE(FlopsKernel kernel, T *data, long n, int nIters,
+                     T v1, T v2)
+{
+    typedef T V __attribute__((vector_size(16)));
+    FlopsBlock<T, V>(kernel, data, n, nIters, v1, v2);
+}
+
+template <class T>
+static SHOC_TARGET_AVX2 void FlopsAVX2(FlopsKernel kernel, T *data, long n,
+                                       int nIters, T v1, T v2)
+{
+    typedef T V __attribute__((vector_size(32)));
+    FlopsBlock<T, V>(kernel, data, n, nIters, v1, v2);
+}
+
+template <class T>
+static SHOC_TARGET_AVX512 void FlopsAVX512(FlopsKernel kernel, T *data,
+                                           long n, int nIters, T v1, T v2)
+{
+    typedef T V __attribute__((vector_size(64)));
+    FlopsBlock<T, V>(kernel, data, n, nIters, v1, v2);
+}
+
+// ****************************************************************************
+// Function: FlopsRun
+//
+// Purpose:
+//   Runs one kernel with one ISA over the whole array, split between the
+//   threads of the OpenMP team in whole 64-byte lines.
+//
+// Arguments:
+//   isa: the instruction set, which must be supported
+//   kernel: the operation mix
+//   data: the elements, 64-byte aligned
+//   n: number of elements, a multiple of 16
+//   nIters: iterations of the unrolled operation block
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T>
+static void FlopsRun(FlopsISA isa, FlopsKernel kernel, T *data, long n,
+                     int nIters)
+{
+    const T v1 = (T)flopsKernelV1[kernel];
+    const T v2 = (T)flopsKernelV2[kernel];
+    const long lineElems = 64 / sizeof(T);
+
+    #pragma omp parallel
+    {
+        const long lines = n / lineElems;
+        const int nThreads = omp_get_num_threads();
+        const int tid = omp_get_thread_num();
+        const long begin = lines * tid / nThreads * lineElems;
+        const long end = lines * (tid + 1) / nThreads * lineElems;
+        T *part = data + begin;
+
+        switch (isa)
+        {
+          case FLOPS_AVX512:
+            FlopsAVX512<T>(kernel, part, end - begin, nIters, v1, v2);
+            break;
+          case FLOPS_AVX2:
+            FlopsAVX2<T>(kernel, part, end - begin, nIters, v1, v2);
+            break;
+          case FLOPS_SSE:
+            FlopsSSE<T>(kernel, part, end - begin, nIters, v1, v2);
+            break;
+          default:
+            FlopsScalar<T>(kernel, part, end - begin, nIters, v1, v2);
+            break;
+        }
+    }
+}
+
+#endif
@@ -35,16 +35,29 @@
 #include <stdio.h>
 #include <math.h>
 #include <omp.h>
+#include <algorithm>
 #include "MaxFlops.h"
+#include "HostFlops.h"
+#include "Backend.h"
 #include "OptionParser.h"
 #include "ProgressBar.h"
 #include "ResultDatabase.h"
+#include "Benchmark.h"
 #include "Timer.h"
 
 // Forward declarations
 template <class T>
-void RunTest(ResultDatabase &resultDB, int npasses, int verbose, int quiet,
-    float repeatF, ProgressBar &pb, const char* precision, const int micdev);
+static void
+RunTest(ResultDatabase &resultDB, int npasses, int verbose, int quiet,
+    float repeatF, ProgressBar &pb, const char* precision, const int micdev,
+    const bool useMIC);
+template <class T>
+void RunHostTest(ResultDatabase &resultDB, int npasses, bool verbose,
+    bool quiet, ProgressBar &pb, const char* precision,
+    const vector<FlopsISA> &isas, double ghz, int cores, int fpPipes);
+template <class T>
+void RunHostScaling(ResultDatabase &resultDB, int npasses, bool verbose,
+    const char* precision, const vector<FlopsISA> &isas);
 
 // ****************************************************************************
 // Function: addBenchmarkSpecOptions
@@ -60,9 +73,17 @@ void RunTest(ResultDatabase &resultDB, int npasses, int verbose, int quiet,
 // Modifications:
 //
 // ****************************************************************************
-void addBenchmarkSpecOptions(OptionParser &op)
+static void addBenchmarkSpecOptions(OptionParser &op)
 {
-    // No specific options for this benchmark
+    op.addOption("isa", OPT_VECSTRING, "auto",
+        "host kernel ISAs: auto (widest supported), all, scalar, sse, avx2, "
+        "avx512");
+    op.addOption("cpu-ghz", OPT_FLOAT, "0",
+        "host clock for the theoretical peak (0: read from the OS)");
+    op.addOption("fp-pipes", OPT_INT, "2",
+        "vector floating point pipes per host core");
+    op.addOption("scaling", OPT_BOOL, "",
+        "sweep pinned thread counts with MAdd8 (host only)");
 }
 
 // ****************************************************************************
@@ -128,6 +149,106 @@ void InitData(T *hostMem, const int numFloats)
     }
 }
 
+// ****************************************************************************
+// Function: RunHostBenchmark
+//
+// Purpose:
+//   Runs the operation mixes on the host with each requested instruction
+//   set, picking the widest one CPUID reports by default, and compares the
+//   best mix of every ISA and precision against the theoretical peak.
+//
+// Arguments:
+//   op: the options parser / parameter database
+//   resultDB: the benchmark stores its results in this ResultDatabase
+//   quiet: no progress bar
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+static void RunHostBenchmark(OptionParser &op, ResultDatabase &resultDB,
+                             bool quiet)
+{
+    const bool verbose = op.getOptionBool("verbose");
+    const unsigned int passes = op.getOptionInt("passes");
+
+    vector<FlopsISA> isas;
+    vector<string> names = op.getOptionVecString("isa");
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        vector<FlopsISA> chosen;
+        if (names[i] == "auto")
+        {
+            int widest = NUM_FLOPS_ISAS - 1;
+            while (!FlopsISASupported((FlopsISA)widest))
+            {
+                widest--;
+            }
+            chosen.push_back((FlopsISA)widest);
+        }
+        for (int isa = 0; isa < NUM_FLOPS_ISAS; isa++)
+        {
+            if (names[i] == "all" ? FlopsISASupported((FlopsISA)isa)
+                                  : names[i] == flopsISANames[isa])
+            {
+                chosen.push_back((FlopsISA)isa);
+            }
+        }
+        if (chosen.empty())
+        {
+            cerr << "Error: unknown ISA \"" << names[i] << "\"\n";
+            return;
+        }
+        for (size_t j = 0; j < chosen.size(); j++)
+        {
+            if (!FlopsISASupported(chosen[j]))
+            {
+                cerr << "Warning: this host does not support "
+                     << flopsISANames[chosen[j]] << ", skipping it\n";
+            }
+            else if (find(isas.begin(), isas.end(), chosen[j]) == isas.end())
+            {
+                isas.push_back(chosen[j]);
+            }
+        }
+    }
+
+    if (op.getOptionBool("scaling"))
+    {
+        RunHostScaling<float>(resultDB, passes, verbose, "-SP", isas);
+        RunHostScaling<double>(resultDB, passes, verbose, "-DP", isas);
+        return;
+    }
+
+    // Hyperthreads share their core's pipes, so the peak counts cores
+    double ghz = op.getOptionFloat("cpu-ghz");
+    if (ghz <= 0.0)
+    {
+        ghz = HostRatedGHz();
+    }
+    const int cores = min(omp_get_max_threads(), HostPhysicalCores());
+    const int fpPipes = op.getOptionInt("fp-pipes");
+    if (verbose)
+    {
+        cerr << "Theoretical peak from " << cores << " cores at " << ghz
+             << " GHz with " << fpPipes << " pipes each\n";
+    }
+
+    ProgressBar pb(NUM_FLOPS_KERNELS * passes * 2 * isas.size());
+    if (!verbose && !quiet)
+    {
+        pb.Show(stdout);
+    }
+
+    RunHostTest<float>(resultDB, passes, verbose, quiet, pb, "-SP", isas,
+                       ghz, cores, fpPipes);
+    RunHostTest<double>(resultDB, passes, verbose, quiet, pb, "-DP", isas,
+                        ghz, cores, fpPipes);
+
+    if (!verbose) cout << endl;
+}
+
 // ****************************************************************************
 // Function: RunBenchmark
 //
@@ -147,15 +268,28 @@ void InitData(T *hostMem, const int numFloats)
 //
 // Modifications:
 // 12/12/12 - Kyle Spafford - Code style and minor integration updates
+// October 16, 2026 - The host backend runs the ISA-specialized kernels.
 //
 // ****************************************************************************
-void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
+static void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
 {
     const bool verbose = op.getOptionBool("verbose");
     // Quiet == no progress bar.
     const bool quiet   = op.getOptionBool("quiet");
     const unsigned int passes = op.getOptionInt("passes");
     const int micdev = op.getOptionInt("target");
+    const bool useMIC = UseOffload(op);
+
+    if (!useMIC)
+    {
+        RunHostBenchmark(op, resultDB, quiet);
+        return;
+    }
+    if (op.getOptionBool("scaling"))
+    {
+        cerr << "Error: --scaling needs the host backend\n";
+        return;
+    }
 
     double repeatF = 3;
     cout << "Adjust repeat factor = " << repeatF << "\n";
@@ -169,17 +303,18 @@ void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
     }
 
     RunTest<float>(resultDB, passes, verbose, quiet,
-                   repeatF, pb, "-SP", micdev);
+                   repeatF, pb, "-SP", micdev, useMIC);
     RunTest<double>(resultDB, passes, verbose, quiet,
-                    repeatF, pb, "-DP", micdev);
+                    repeatF, pb, "-DP", micdev, useMIC);
 
     if (!verbose) cout << endl;
 }
 
 template <class T>
-void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
+static void
+RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
         const int noPB, const float repeatF, ProgressBar &pb,
-        const char* precision, const int micdev)
+        const char* precision, const int micdev, const bool useMIC)
 {
     char sizeStr[128];
     static __declspec(target(mic)) T *hostMem;
@@ -202,10 +337,10 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
     {
         ////////// Add1 //////////
         InitData<T>(hostMem,numFloats);
-        #pragma offload target(mic:micdev) in(hostMem:length(numFloats) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) in(hostMem:length(numFloats) free_if(0))
         {}
         TH = curr_second();
-        #pragma offload target(mic:micdev) in(numFloats,realRepeats) nocopy(hostMem)
+        #pragma offload target(mic:micdev) if(useMIC) in(numFloats,realRepeats) nocopy(hostMem)
         {
             Add1_MIC<T>(numFloats,hostMem, realRepeats, 10.0);
         }
@@ -215,7 +350,7 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
         gflop = flopCount / (double)(t*1e9);
         resultDB.AddResult(string("Add1")+precision, sizeStr, "GFLOPS", gflop);
 
-        #pragma offload target(mic:micdev) out(hostMem:length(numFloats) alloc_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) out(hostMem:length(numFloats) alloc_if(0))
         {}
         CheckResults<T>(hostMem,numFloats);
         pb.addItersDone();
@@ -223,10 +358,10 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
 
         ////////// Add2 //////////
         InitData<T>(hostMem,numFloats);
-        #pragma offload target(mic:micdev) in(hostMem:length(numFloats) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) in(hostMem:length(numFloats) free_if(0))
         {}
         TH = curr_second();
-        #pragma offload target(mic:micdev) in(numFloats,realRepeats) nocopy(hostMem)
+        #pragma offload target(mic:micdev) if(useMIC) in(numFloats,realRepeats) nocopy(hostMem)
         {
             Add2_MIC<T>(numFloats,hostMem, realRepeats, 10.0);
         }
@@ -235,7 +370,7 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
         flopCount = (double)numFloats * 2 * realRepeats * 114 ;
         gflop = flopCount / (double)(t*1e9);
         resultDB.AddResult(string("Add2")+precision, sizeStr, "GFLOPS", gflop);
-        #pragma offload target(mic:micdev) out(hostMem:length(numFloats) alloc_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) out(hostMem:length(numFloats) alloc_if(0))
         {}
         CheckResults<T>(hostMem,numFloats);
         pb.addItersDone();
@@ -243,10 +378,10 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
 
         ////////// Add4 //////////
         InitData<T>(hostMem,numFloats);
-        #pragma offload target(mic:micdev) in(hostMem:length(numFloats) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) in(hostMem:length(numFloats) free_if(0))
         {}
         TH = curr_second();
-        #pragma offload target(mic:micdev) in(numFloats,realRepeats) nocopy(hostMem)
+        #pragma offload target(mic:micdev) if(useMIC) in(numFloats,realRepeats) nocopy(hostMem)
         {
             Add4_MIC<T>(numFloats,hostMem, realRepeats, 10.0);
         }
@@ -255,7 +390,7 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
         flopCount = (double)numFloats *  4 * realRepeats * 57 ;
         gflop = flopCount / (double)(t*1e9);
         resultDB.AddResult(string("Add4")+precision, sizeStr, "GFLOPS", gflop);
-        #pragma offload target(mic:micdev) out(hostMem:length(numFloats) alloc_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) out(hostMem:length(numFloats) alloc_if(0))
         {}
         CheckResults<T>(hostMem,numFloats);
         pb.addItersDone();
@@ -263,10 +398,10 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
 
         ////////// Add8 //////////
         InitData<T>(hostMem,numFloats);
-        #pragma offload target(mic:micdev) in(hostMem:length(numFloats) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) in(hostMem:length(numFloats) free_if(0))
         {}
         TH = curr_second();
-        #pragma offload target(mic:micdev) in(numFloats,realRepeats) nocopy(hostMem)
+        #pragma offload target(mic:micdev) if(useMIC) in(numFloats,realRepeats) nocopy(hostMem)
         {
             Add8_MIC<T>(numFloats,hostMem, realRepeats, 10.0);
         }
@@ -274,7 +409,7 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
         flopCount = (double)numFloats * 8 * realRepeats * 30 ;
         gflop = flopCount / (double)(t*1e9);
         resultDB.AddResult(string("Add8")+precision, sizeStr, "GFLOPS", gflop);
-        #pragma offload target(mic:micdev) out(hostMem:length(numFloats) alloc_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) out(hostMem:length(numFloats) alloc_if(0))
         {}
         CheckResults<T>(hostMem,numFloats);
         pb.addItersDone();
@@ -282,10 +417,10 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
 
         ////////// Mul1 //////////
         InitData<T>(hostMem,numFloats);
-        #pragma offload target(mic:micdev) in(hostMem:length(numFloats) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) in(hostMem:length(numFloats) free_if(0))
         {}
         TH = curr_second();
-        #pragma offload target(mic:micdev) in(numFloats,realRepeats) nocopy(hostMem)
+        #pragma offload target(mic:micdev) if(useMIC) in(numFloats,realRepeats) nocopy(hostMem)
         {
             Mul1_MIC<T>(numFloats,hostMem, realRepeats, 1.01);
         }
@@ -293,7 +428,7 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
         flopCount = (double)numFloats * 2 * realRepeats * 200;
         gflop = flopCount / (double)(t*1e9);
         resultDB.AddResult(string("Mul1")+precision, sizeStr, "GFLOPS", gflop);
-        #pragma offload target(mic:micdev) out(hostMem:length(numFloats) alloc_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) out(hostMem:length(numFloats) alloc_if(0))
         {}
         CheckResults<T>(hostMem,numFloats);
         pb.addItersDone();
@@ -301,10 +436,10 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
 
         ////////// Mul2 //////////
         InitData<T>(hostMem,numFloats);
-        #pragma offload target(mic:micdev) in(hostMem:length(numFloats) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) in(hostMem:length(numFloats) free_if(0))
         {}
         TH = curr_second();
-        #pragma offload target(mic:micdev) in(numFloats,realRepeats) nocopy(hostMem)
+        #pragma offload target(mic:micdev) if(useMIC) in(numFloats,realRepeats) nocopy(hostMem)
         {
             Mul2_MIC<T>(numFloats,hostMem, realRepeats, 1.01);
         }
@@ -312,7 +447,7 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
         flopCount = (double)numFloats * 2 * realRepeats * 100 * 2;
         gflop = flopCount / (double)(t*1e9);
         resultDB.AddResult(string("Mul2")+precision, sizeStr, "GFLOPS", gflop);
-        #pragma offload target(mic:micdev) out(hostMem:length(numFloats) alloc_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) out(hostMem:length(numFloats) alloc_if(0))
         {}
         CheckResults<T>(hostMem,numFloats);
         pb.addItersDone();
@@ -320,10 +455,10 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
 
         ////////// Mul4 //////////
         InitData<T>(hostMem,numFloats);
-        #pragma offload target(mic:micdev) in(hostMem:length(numFloats) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) in(hostMem:length(numFloats) free_if(0))
         {}
         TH = curr_second();
-        #pragma offload target(mic:micdev) in(numFloats,realRepeats) nocopy(hostMem)
+        #pragma offload target(mic:micdev) if(useMIC) in(numFloats,realRepeats) nocopy(hostMem)
         {
             Mul4_MIC<T>(numFloats,hostMem, realRepeats, 1.01);
         }
@@ -331,7 +466,7 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
         flopCount = (double)numFloats * 2 * realRepeats * 50 * 4;
         gflop = flopCount / (double)(t*1e9);
         resultDB.AddResult(string("Mul4")+precision, sizeStr, "GFLOPS", gflop);
-        #pragma offload target(mic:micdev) out(hostMem:length(numFloats) alloc_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) out(hostMem:length(numFloats) alloc_if(0))
         {}
         CheckResults<T>(hostMem,numFloats);
         pb.addItersDone();
@@ -339,10 +474,10 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
 
         ////////// Mul8 //////////
         InitData<T>(hostMem,numFloats);
-        #pragma offload target(mic:micdev) in(hostMem:length(numFloats) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) in(hostMem:length(numFloats) free_if(0))
         {}
         TH = curr_second();
-        #pragma offload target(mic:micdev) in(numFloats,realRepeats) nocopy(hostMem)
+        #pragma offload target(mic:micdev) if(useMIC) in(numFloats,realRepeats) nocopy(hostMem)
         {
             Mul8_MIC<T>(numFloats,hostMem, realRepeats, 1.01);
         }
@@ -350,7 +485,7 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
         flopCount = (double)numFloats * 2 * realRepeats * 25 * 8;
         gflop = flopCount / (double)(t*1e9);
         resultDB.AddResult(string("Mul8")+precision, sizeStr, "GFLOPS", gflop);
-        #pragma offload target(mic:micdev) out(hostMem:length(numFloats) alloc_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) out(hostMem:length(numFloats) alloc_if(0))
         {}
         CheckResults<T>(hostMem,numFloats);
         pb.addItersDone();
@@ -358,10 +493,10 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
 
         ////////// MAdd1 //////////
         InitData<T>(hostMem,numFloats);
-        #pragma offload target(mic:micdev) in(hostMem:length(numFloats) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) in(hostMem:length(numFloats) free_if(0))
         {}
         TH = curr_second();
-        #pragma offload target(mic:micdev) in(numFloats,realRepeats) nocopy(hostMem)
+        #pragma offload target(mic:micdev) if(useMIC) in(numFloats,realRepeats) nocopy(hostMem)
         {
             MAdd1_MIC<T>(numFloats,hostMem, realRepeats, 10.0, 0.9899);
         }
@@ -370,7 +505,7 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
         flopCount = (double)numFloats * 2 * realRepeats * 228;
         gflop = flopCount / (double)(t*1e9);
         resultDB.AddResult(string("MAdd1")+precision, sizeStr, "GFLOPS", gflop);
-        #pragma offload target(mic:micdev) out(hostMem:length(numFloats) alloc_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) out(hostMem:length(numFloats) alloc_if(0))
         {}
         CheckResults<T>(hostMem,numFloats);
         pb.addItersDone();
@@ -378,10 +513,10 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
 
         ////////// MAdd2 //////////
         InitData<T>(hostMem,numFloats);
-        #pragma offload target(mic:micdev) in(hostMem:length(numFloats) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) in(hostMem:length(numFloats) free_if(0))
         {}
         TH = curr_second();
-        #pragma offload target(mic:micdev) in(numFloats,realRepeats) nocopy(hostMem)
+        #pragma offload target(mic:micdev) if(useMIC) in(numFloats,realRepeats) nocopy(hostMem)
         {
             MAdd2_MIC<T>(numFloats,hostMem, realRepeats, 10.0, 0.9899);
         }
@@ -389,7 +524,7 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
         flopCount = (double)numFloats * 2 * realRepeats * 114 * 2;
         gflop = flopCount / (double)(t*1e9);
         resultDB.AddResult(string("MAdd2")+precision, sizeStr, "GFLOPS", gflop);
-        #pragma offload target(mic:micdev) out(hostMem:length(numFloats) alloc_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) out(hostMem:length(numFloats) alloc_if(0))
         {}
         CheckResults<T>(hostMem,numFloats);
         pb.addItersDone();
@@ -397,10 +532,10 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
 
         ////////// MAdd4 //////////
         InitData<T>(hostMem,numFloats);
-        #pragma offload target(mic:micdev) in(hostMem:length(numFloats) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) in(hostMem:length(numFloats) free_if(0))
         {}
         TH = curr_second();
-        #pragma offload target(mic:micdev) in(numFloats,realRepeats) nocopy(hostMem)
+        #pragma offload target(mic:micdev) if(useMIC) in(numFloats,realRepeats) nocopy(hostMem)
         {
             MAdd4_MIC<T>(numFloats,hostMem, realRepeats, 10.0, 0.9899);
         }
@@ -408,7 +543,7 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
         flopCount = (double)numFloats * 2 * realRepeats * 57 * 4;
         gflop = flopCount / (double)(t*1e9);
         resultDB.AddResult(string("MAdd4")+precision, sizeStr, "GFLOPS", gflop);
-        #pragma offload target(mic:micdev) out(hostMem:length(numFloats) alloc_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) out(hostMem:length(numFloats) alloc_if(0))
         {}
         CheckResults<T>(hostMem,numFloats);
         pb.addItersDone();
@@ -416,10 +551,10 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
 
         ////////// MAdd8 //////////
         InitData<T>(hostMem,numFloats);
-        #pragma offload target(mic:micdev) in(hostMem:length(numFloats) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) in(hostMem:length(numFloats) free_if(0))
         {}
         TH = curr_second();
-        #pragma offload target(mic:micdev) in(numFloats,realRepeats) nocopy(hostMem)
+        #pragma offload target(mic:micdev) if(useMIC) in(numFloats,realRepeats) nocopy(hostMem)
         {
             MAdd8_MIC<T>(numFloats,hostMem, realRepeats, 10.0, 0.9899);
         }
@@ -427,7 +562,7 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
         flopCount = (double)numFloats * 2 * realRepeats * 30 * 8;
         gflop = flopCount / (double)(t*1e9);
         resultDB.AddResult(string("MAdd8")+precision, sizeStr, "GFLOPS", gflop);
-        #pragma offload target(mic:micdev) out(hostMem:length(numFloats) alloc_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) out(hostMem:length(numFloats) alloc_if(0))
         {}
         CheckResults<T>(hostMem,numFloats);
         pb.addItersDone();
@@ -435,10 +570,10 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
 
         ////////// MulMAdd1 //////////
         InitData<T>(hostMem,numFloats);
-        #pragma offload target(mic:micdev) in(hostMem:length(numFloats) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) in(hostMem:length(numFloats) free_if(0))
         {}
         TH = curr_second();
-        #pragma offload target(mic:micdev) in(numFloats,realRepeats) nocopy(hostMem)
+        #pragma offload target(mic:micdev) if(useMIC) in(numFloats,realRepeats) nocopy(hostMem)
         {
             MulMAdd1_MIC<T>(numFloats,hostMem, realRepeats, 3.75, 0.355);
         }
@@ -446,7 +581,7 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
         flopCount = (double)numFloats * 3 * realRepeats * 160 * 1;
         gflop = flopCount / (double)(t*1e9);
         resultDB.AddResult(string("MulMAdd1")+precision, sizeStr, "GFLOPS", gflop);
-        #pragma offload target(mic:micdev) out(hostMem:length(numFloats) alloc_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) out(hostMem:length(numFloats) alloc_if(0))
         {}
         CheckResults<T>(hostMem,numFloats);
         pb.addItersDone();
@@ -454,10 +589,10 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
 
         ////////// MulMAdd2 //////////
         InitData<T>(hostMem,numFloats);
-        #pragma offload target(mic:micdev) in(hostMem:length(numFloats) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) in(hostMem:length(numFloats) free_if(0))
         {}
         TH = curr_second();
-        #pragma offload target(mic:micdev) in(numFloats,realRepeats) nocopy(hostMem)
+        #pragma offload target(mic:micdev) if(useMIC) in(numFloats,realRepeats) nocopy(hostMem)
         {
             MulMAdd2_MIC<T>(numFloats,hostMem, realRepeats, 3.75, 0.355);
         }
@@ -465,7 +600,7 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
         flopCount = (double)numFloats * 3 * realRepeats * 80 * 2;
         gflop = flopCount / (double)(t*1e9);
         resultDB.AddResult(string("MulMAdd2")+precision, sizeStr, "GFLOPS", gflop);
-        #pragma offload target(mic:micdev) out(hostMem:length(numFloats) alloc_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) out(hostMem:length(numFloats) alloc_if(0))
         {}
         CheckResults<T>(hostMem,numFloats);
         pb.addItersDone();
@@ -473,10 +608,10 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
 
         ////////// MulMAdd4 //////////
         InitData<T>(hostMem,numFloats);
-        #pragma offload target(mic:micdev) in(hostMem:length(numFloats) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) in(hostMem:length(numFloats) free_if(0))
         {}
         TH = curr_second();
-        #pragma offload target(mic:micdev) in(numFloats,realRepeats) nocopy(hostMem)
+        #pragma offload target(mic:micdev) if(useMIC) in(numFloats,realRepeats) nocopy(hostMem)
         {
             MulMAdd4_MIC<T>(numFloats,hostMem, realRepeats, 3.75, 0.355);
         }
@@ -484,7 +619,7 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
         flopCount = (double)numFloats * 3 * realRepeats * 40 * 4;
         gflop = flopCount / (double)(t*1e9);
         resultDB.AddResult(string("MulMAdd4")+precision, sizeStr, "GFLOPS", gflop);
-        #pragma offload target(mic:micdev) out(hostMem:length(numFloats) alloc_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) out(hostMem:length(numFloats) alloc_if(0))
         {}
         CheckResults<T>(hostMem,numFloats);
         pb.addItersDone();
@@ -492,10 +627,10 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
 
         ////////// MulMAdd8 //////////
         InitData<T>(hostMem,numFloats);
-        #pragma offload target(mic:micdev) in(hostMem:length(numFloats) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) in(hostMem:length(numFloats) free_if(0))
         {}
         TH = curr_second();
-        #pragma offload target(mic:micdev) in(numFloats,realRepeats) nocopy(hostMem)
+        #pragma offload target(mic:micdev) if(useMIC) in(numFloats,realRepeats) nocopy(hostMem)
         {
             MulMAdd8_MIC<T>(numFloats,hostMem, realRepeats, 3.75, 0.355);
         }
@@ -503,11 +638,244 @@ void RunTest(ResultDatabase &resultDB, const int npasses, const int verbose,
         flopCount = (double)numFloats * 3 * realRepeats * 20 * 8;
         gflop = flopCount / (double)(t*1e9);
         resultDB.AddResult(string("MulMAdd8")+precision, sizeStr, "GFLOPS", gflop);
-        #pragma offload target(mic:micdev) out(hostMem:length(numFloats) alloc_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) out(hostMem:length(numFloats) alloc_if(0))
         {}
         CheckResults<T>(hostMem,numFloats);
         pb.addItersDone();
         if (!verbose && !noPB)pb.Show(stdout);
     }
     _mm_free(hostMem);
+
+    // These kernels define the compute ceilings of the roofline report
+    const char *kernels[] = { "Add1", "Add2", "Add4", "Add8",
+                              "Mul1", "Mul2", "Mul4", "Mul8",
+                              "MAdd1", "MAdd2", "MAdd4", "MAdd8",
+                              "MulMAdd1", "MulMAdd2", "MulMAdd4", "MulMAdd8" };
+    for (int i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++)
+    {
+        resultDB.SetCeiling(string(kernels[i]) + precision, sizeStr,
+                            precision + 1);
+    }
 }
+
+// ****************************************************************************
+// Function: RunHostTest
+//
+// Purpose:
+//   Times every operation mix with each ISA in one precision.  The
+//   iteration count of each mix is calibrated once so that a run takes
+//   about 0.1 s whatever the ISA.  Besides the per-mix GFLOPS, each pass
+//   records the best mix as AchievedPeak and, when the clock is known, its
+//   share of the theoretical peak
+//
+//     cores x GHz x lanes x pipes x (2 if the ISA has FMA)
+//
+// Arguments:
+//   resultDB: the benchmark stores its results in this ResultDatabase
+//   npasses: number of passes
+//   verbose, quiet: output and progress bar control
+//   pb: progress bar
+//   precision: "-SP" or "-DP"
+//   isas: supported instruction sets to run
+//   ghz, cores, fpPipes: the machine's peak parameters
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T>
+void RunHostTest(ResultDatabase &resultDB, int npasses, bool verbose,
+    bool quiet, ProgressBar &pb, const char* precision,
+    const vector<FlopsISA> &isas, double ghz, int cores, int fpPipes)
+{
+    // Every thread owns whole 64-byte lines for every register width
+    const int numFloats = omp_get_max_threads() * 4096;
+    T *hostMem = (T*)_mm_malloc(sizeof(T)*numFloats, 64);
+
+    for (size_t i = 0; i < isas.size(); i++)
+    {
+        const FlopsISA isa = isas[i];
+        char sizeStr[128], isaStr[128];
+        sprintf(sizeStr, "Size:%07d ISA:%s", numFloats, flopsISANames[isa]);
+        sprintf(isaStr, "ISA:%s", flopsISANames[isa]);
+
+        int iters[NUM_FLOPS_KERNELS];
+        for (int k = 0; k < NUM_FLOPS_KERNELS; k++)
+        {
+            double t;
+            int nIters = 1;
+            for (;;)
+            {
+                InitData<T>(hostMem, numFloats);
+                double TH = curr_second();
+                FlopsRun<T>(isa, (FlopsKernel)k, hostMem, numFloats, nIters);
+                t = curr_second() - TH;
+                if (t >= 0.02 || nIters >= (1 << 20))
+                {
+                    break;
+                }
+                nIters *= 2;
+            }
+            iters[k] = max(1, (int)(nIters * 0.1 / t));
+        }
+
+        const double peak = ghz * cores * FlopsISALanes<T>(isa) * fpPipes *
+                            (flopsISAFMA[isa] ? 2 : 1);
+
+        for (int pass = 0; pass < npasses; ++pass)
+        {
+            double best = 0.0;
+            for (int k = 0; k < NUM_FLOPS_KERNELS; k++)
+            {
+                InitData<T>(hostMem, numFloats);
+                double TH = curr_second();
+                FlopsRun<T>(isa, (FlopsKernel)k, hostMem, numFloats,
+                            iters[k]);
+                double t = curr_second() - TH;
+
+                double flopCount = (double)numFloats * iters[k] *
+                                   flopsKernelFlops[k];
+                double gflop = flopCount / (t*1e9);
+                resultDB.AddResult(string(flopsKernelNames[k])+precision,
+                                   sizeStr, "GFLOPS", gflop);
+                best = max(best, gflop);
+
+                CheckResults<T>(hostMem, numFloats);
+                pb.addItersDone();
+                if (!verbose && !quiet) pb.Show(stdout);
+            }
+
+            resultDB.AddResult(string("AchievedPeak")+precision, isaStr,
+                               "GFLOPS", best);
+            if (peak > 0.0)
+            {
+                resultDB.AddResult(string("TheoreticalPeak")+precision,
+                                   isaStr, "GFLOPS", peak);
+                resultDB.AddResult(string("PeakFraction")+precision, isaStr,
+                                   "%", 100.0 * best / peak);
+            }
+        }
+
+        // These kernels define the compute ceilings of the roofline report
+        for (int k = 0; k < NUM_FLOPS_KERNELS; k++)
+        {
+            resultDB.SetCeiling(string(flopsKernelNames[k]) + precision,
+                                sizeStr, precision + 1);
+        }
+    }
+    _mm_free(hostMem);
+}
+
+// ****************************************************************************
+// Function: RunHostScaling
+//
+// Purpose:
+//   Runs MAdd8, the mix with the most independent work, with teams of
+//   pinned threads that grow core by core through the first socket, then
+//   across sockets, then onto the SMT siblings.  Each thread keeps the same
+//   share of elements, so ideal scaling keeps GFLOPS per thread constant;
+//   the efficiency against one thread drops where threads start sharing a
+//   core's pipes.
+//
+// Arguments:
+//   resultDB: the benchmark stores its results in this ResultDatabase
+//   npasses: samples per team size
+//   verbose: print each point
+//   precision: "-SP" or "-DP"
+//   isas: supported instruction sets to run
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+template <class T>
+void RunHostScaling(ResultDatabase &resultDB, int npasses, bool verbose,
+    const char* precision, const vector<FlopsISA> &isas)
+{
+    const FlopsKernel kernel = FLOPS_MADD8;
+    const string test = string(flopsKernelNames[kernel]) + precision;
+
+    vector<int> cpus, teamSizes;
+    HostScalingSweep(cpus, teamSizes);
+
+    for (size_t i = 0; i < isas.size(); i++)
+    {
+        const FlopsISA isa = isas[i];
+        vector<vector<double> > gflops(teamSizes.size());
+        int nIters = 1;
+
+        for (size_t p = 0; p < teamSizes.size(); p++)
+        {
+            const int threads = teamSizes[p];
+            if (!PinOpenMPThreads(vector<int>(cpus.begin(),
+                                              cpus.begin() + threads)))
+            {
+                continue;
+            }
+            const int numFloats = threads * 4096;
+            T *hostMem = (T*)_mm_malloc(sizeof(T)*numFloats, 64);
+
+            // Calibrate on one thread to about 0.1 s per run
+            if (p == 0)
+            {
+                double t;
+                for (;;)
+                {
+                    InitData<T>(hostMem, numFloats);
+                    double TH = curr_second();
+                    FlopsRun<T>(isa, kernel, hostMem, numFloats, nIters);
+                    t = curr_second() - TH;
+                    if (t >= 0.02 || nIters >= (1 << 20))
+                    {
+                        break;
+                    }
+                    nIters *= 2;
+                }
+                nIters = max(1, (int)(nIters * 0.1 / t));
+            }
+
+            char attStr[128];
+            sprintf(attStr, "Threads:%03d ISA:%s", threads,
+                    flopsISANames[isa]);
+            for (int pass = 0; pass < npasses; pass++)
+            {
+                InitData<T>(hostMem, numFloats);
+                double TH = curr_second();
+                FlopsRun<T>(isa, kernel, hostMem, numFloats, nIters);
+                double t = curr_second() - TH;
+                CheckResults<T>(hostMem, numFloats);
+
+                gflops[p].push_back((double)numFloats * nIters *
+                                    flopsKernelFlops[kernel] / (t*1e9));
+                resultDB.AddResult(test + "_Scaling", attStr, "GFLOPS",
+                                   gflops[p].back());
+            }
+            if (verbose)
+            {
+                cerr << test << " " << attStr << ": " << gflops[p].back()
+                     << " GFLOPS\n";
+            }
+            _mm_free(hostMem);
+        }
+        UnpinOpenMPThreads();
+
+        // Efficiency of each team against the same pass of one thread
+        for (size_t p = 0; p < teamSizes.size(); p++)
+        {
+            char attStr[128];
+            sprintf(attStr, "Threads:%03d ISA:%s", teamSizes[p],
+                    flopsISANames[isa]);
+            for (size_t pass = 0; pass < gflops[p].size() &&
+                                  pass < gflops[0].size(); pass++)
+            {
+                resultDB.AddResult(test + "_ScalingEfficiency", attStr, "%",
+                    100.0 * gflops[p][pass] /
+                    (teamSizes[p] * gflops[0][pass]));
+            }
+        }
+    }
+}
+
+SHOC_REGISTER_BENCHMARK(MaxFlops);
@@ -0,0 +1,347 @@
+// This example from an alpha release of the Scalable HeterOgeneous Computing
+// (SHOC) Benchmark Suite Alpha v1.1.4a-mic for Intel MIC architecture
+// Contact: Kyle Spafford <kys@ornl.gov>
+//          Rezaur Rahman <rezaur.rahman@intel.com>
+//
+// Copyright (c) 2011, UT-Battelle, LLC
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of Oak Ridge National Laboratory, nor UT-Battelle, LLC, 
+//    nor the names of its contributors may be used to endorse or promote 
+//    products derived from this software without specific prior written 
+//    permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, 
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
+// THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Backend.h"
+#include "Measurement.h"
+#include "OptionParser.h"
+#include "ResultDatabase.h"
+#include "Benchmark.h"
+#include "Timer.h"
+
+using namespace std;
+
+// Mappings are rounded up to whole huge pages
+#define HUGE_PAGE (2*1024*1024)
+
+// ****************************************************************************
+// Function: addBenchmarkSpecOptions
+//
+// Purpose:
+//   Add benchmark specific command line argument parsing.
+//
+// Arguments:
+//   op: the options parser / parameter database
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+static void addBenchmarkSpecOptions(OptionParser &op)
+{
+    op.addOption("max-footprint", OPT_INT, "256",
+        "largest working set of the sweep, in MB");
+    op.addOption("strides", OPT_VECINT, "64,4096",
+        "bytes between consecutive chain nodes");
+    op.addOption("chain-orders", OPT_VECSTRING, "random",
+        "node visiting orders: random, sequential");
+    op.addOption("huge-pages", OPT_BOOL, "",
+        "back the chains with 2 MB pages");
+    op.addOption("chase-loads", OPT_INT, "1048576",
+        "dependent loads timed per measurement");
+}
+
+// ****************************************************************************
+// Function: ChaseLatency
+//
+// Purpose:
+//   Builds a pointer chain through a fresh working set and times walking
+//   it.  Nodes are stride bytes apart and linked into a single cycle, in
+//   address order or in a random permutation that defeats the hardware
+//   prefetchers.  Every load depends on the previous one, so the time per
+//   load is the load-to-use latency of the level the working set lives in.
+//
+// Arguments:
+//   footprint: working set size in bytes
+//   stride: bytes between nodes, a multiple of the pointer size
+//   randomOrder: visit the nodes in random order
+//   hugePages: ask for 2 MB pages instead of forcing 4 kB ones
+//   loads: number of dependent loads to time
+//
+// Returns:  seconds per load, or a negative value if allocation failed
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+__declspec(target(MIC)) static double
+ChaseLatency(size_t footprint, size_t stride, bool randomOrder,
+             bool hugePages, long loads)
+{
+    static void * volatile sink;
+
+    // mmap only guarantees 4 kB alignment, so map one huge page extra and
+    // start the buffer on a 2 MB boundary, where huge pages can back it
+    size_t region = (footprint + HUGE_PAGE - 1) & ~(size_t)(HUGE_PAGE - 1);
+    size_t mapped = region + HUGE_PAGE;
+    char *base = (char *)mmap(NULL, mapped, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+    {
+        return -1.0;
+    }
+    char *buf = (char *)(((uintptr_t)base + HUGE_PAGE - 1) &
+                         ~(uintptr_t)(HUGE_PAGE - 1));
+    // Without the request the page size is pinned to 4 kB, so transparent
+    // huge pages cannot blur the TLB steps
+#if defined(MADV_HUGEPAGE) && defined(MADV_NOHUGEPAGE)
+    madvise(buf, region, hugePages ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+#endif
+
+    const size_t n = footprint / stride;
+    size_t *order = (size_t *)malloc(n * sizeof(size_t));
+    if (order == NULL)
+    {
+        munmap(base, mapped);
+        return -1.0;
+    }
+    for (size_t i = 0; i < n; i++)
+    {
+        order[i] = i;
+    }
+    if (randomOrder)
+    {
+        // Fisher-Yates over all but the first node, with a fixed-seed
+        // xorshift generator so every run walks the same chain
+        unsigned long long x = 88172645463325252ULL;
+        for (size_t i = n - 1; i > 1; i--)
+        {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            size_t j = 1 + (size_t)(x % i);
+            size_t tmp = order[i];
+            order[i] = order[j];
+            order[j] = tmp;
+        }
+    }
+    for (size_t i = 0; i < n; i++)
+    {
+        size_t next = order[(i + 1) % n];
+        *(void **)(buf + order[i] * stride) = buf + next * stride;
+    }
+    free(order);
+
+    // One untimed lap brings the working set into the caches and TLBs
+    void *p = buf;
+    for (size_t i = 0; i < n; i++)
+    {
+        p = *(void **)p;
+    }
+
+    double start = curr_second();
+    for (long i = 0; i < loads; i += 8)
+    {
+        p = *(void **)p;
+        p = *(void **)p;
+        p = *(void **)p;
+        p = *(void **)p;
+        p = *(void **)p;
+        p = *(void **)p;
+        p = *(void **)p;
+        p = *(void **)p;
+    }
+    double t = curr_second() - start;
+    sink = p;
+
+    munmap(base, mapped);
+    return t / (double)loads;
+}
+
+// ****************************************************************************
+// Function: RunBenchmark
+//
+// Purpose:
+//   Measures dependent-load latency against working set size for each
+//   stride and chain order.  The footprints step by factors of 1.5 and 2
+//   from 4 kB up to --max-footprint, so the curve resolves the cache and
+//   TLB reach boundaries of the target.
+//
+// Arguments:
+//   op: the options parser / parameter database
+//   resultDB: the benchmark stores its results in this ResultDatabase
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+static void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
+{
+    const bool verbose = op.getOptionBool("verbose");
+    const bool hugePages = op.getOptionBool("huge-pages");
+    const int micdev = op.getOptionInt("target");
+    const bool useMIC = UseOffload(op);
+
+    const size_t maxFootprint =
+        (size_t)op.getOptionInt("max-footprint") * 1024 * 1024;
+    long loads = op.getOptionInt("chase-loads");
+    vector<long long> strides = op.getOptionVecInt("strides");
+    vector<string> orders = op.getOptionVecString("chain-orders");
+
+    if (loads < 8)
+    {
+        cerr << "Error: --chase-loads must be at least 8\n";
+        return;
+    }
+    loads &= ~7L;
+    for (size_t i = 0; i < strides.size(); i++)
+    {
+        if (strides[i] < (long long)sizeof(void *) ||
+            strides[i] % sizeof(void *) != 0)
+        {
+            cerr << "Error: stride " << strides[i]
+                 << " is not a multiple of the pointer size\n";
+            return;
+        }
+    }
+    for (size_t i = 0; i < orders.size(); i++)
+    {
+        if (orders[i] != "random" && orders[i] != "sequential")
+        {
+            cerr << "Error: unknown chain order \"" << orders[i] << "\"\n";
+            return;
+        }
+    }
+
+    // 4 kB, 6 kB, 8 kB, 12 kB, ... up to the largest footprint
+    vector<size_t> footprints;
+    for (size_t f = 4096; f <= maxFootprint; f *= 2)
+    {
+        footprints.push_back(f);
+        if (f + f / 2 <= maxFootprint)
+        {
+            footprints.push_back(f + f / 2);
+        }
+    }
+
+    struct ChaseTest
+    {
+        string name;
+        size_t stride;
+        bool randomOrder;
+    };
+    vector<ChaseTest> tests;
+    for (size_t o = 0; o < orders.size(); o++)
+    {
+        for (size_t s = 0; s < strides.size(); s++)
+        {
+            ChaseTest test;
+            char name[256];
+            sprintf(name, "LoadLatency_%s_%lldB%s", orders[o].c_str(),
+                    strides[s], hugePages ? "_huge" : "");
+            test.name = name;
+            test.stride = strides[s];
+            test.randomOrder = orders[o] == "random";
+            tests.push_back(test);
+        }
+    }
+
+    // With --rel-ci, noisy footprints keep repeating after the rest converged
+    Measurement meas(op);
+
+    for (int pass = 0; !meas.Finished(); pass++)
+    {
+        for (size_t t = 0; t < tests.size(); t++)
+        {
+            for (size_t i = 0; i < footprints.size(); i++)
+            {
+                const size_t footprint = footprints[i];
+                const size_t stride = tests[t].stride;
+                const bool randomOrder = tests[t].randomOrder;
+
+                // A chain needs at least two nodes
+                if (footprint / stride < 2)
+                {
+                    continue;
+                }
+                char sizeStr[256];
+                sprintf(sizeStr, "% 8ldkB", (long)(footprint / 1024));
+                string region = tests[t].name + sizeStr;
+                if (meas.Done(region))
+                {
+                    continue;
+                }
+
+                double latency;
+                #pragma offload target(mic:micdev) if(useMIC)
+                latency = ChaseLatency(footprint, stride, randomOrder,
+                                       hugePages, loads);
+                if (latency < 0.0)
+                {
+                    cerr << "Error: could not allocate a " << sizeStr
+                         << " chain\n";
+                    return;
+                }
+                meas.Add(region, latency);
+
+                if (verbose)
+                {
+                    cerr << tests[t].name << sizeStr << ": "
+                         << latency * 1.e9 << " ns\n";
+                }
+            }
+        }
+    }
+
+    for (size_t t = 0; t < tests.size(); t++)
+    {
+        for (size_t i = 0; i < footprints.size(); i++)
+        {
+            if (footprints[i] / tests[t].stride < 2)
+            {
+                continue;
+            }
+            char sizeStr[256];
+            sprintf(sizeStr, "% 8ldkB", (long)(footprints[i] / 1024));
+            string region = tests[t].name + sizeStr;
+            vector<double> latencies = meas.Samples(region);
+            for (size_t j = 0; j < latencies.size(); j++)
+            {
+                resultDB.AddResult(tests[t].name, sizeStr, "ns",
+                                   latencies[j] * 1.e9);
+            }
+            meas.RecordConfidence(resultDB, region, tests[t].name, sizeStr);
+        }
+    }
+}
+
+SHOC_REGISTER_BENCHMARK(MemoryLatency);
@@ -36,8 +36,10 @@
 #include <string>
 #include <sstream>
 
+#include "Backend.h"
 #include "OptionParser.h"
 #include "ResultDatabase.h"
+#include "Benchmark.h"
 #include "Timer.h"
 #include <stdlib.h>
 #include <stdio.h>
@@ -53,7 +55,8 @@ using namespace std;
 
 // Forward declaration
 template <class real, int MAXVL>
-void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op);
+static void
+RunTest(string testName, ResultDatabase &resultDB, OptionParser &op);
 
 // ********************************************************
 // Function: toString
@@ -189,7 +192,7 @@ void BlackScholesFormula(
 // Modifications:
 //
 // ****************************************************************************
-void
+static void
 addBenchmarkSpecOptions(OptionParser &op)
 {
     ; // No MC specific options
@@ -213,7 +216,7 @@ addBenchmarkSpecOptions(OptionParser &op)
 // Modifications:
 //
 // ****************************************************************************
-void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
+static void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
 {
     printf("Runnig single precision  version of MonteCarlo benchmark\n");
     RunTest<float, 16>("MC-SP_16", resultDB, op);
@@ -225,7 +228,8 @@ void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
 __declspec(target(MIC) align(4096))   int OPT_N;
 
 template <class real, int MAXVL>
-void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
+static void
+RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
 {
 
     __declspec(target(MIC) align(4096)) static real
@@ -257,11 +261,11 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
     mem_size = sizeof(real)*OPT_N;
     rand_size = sizeof(real)*RAND_N;
 
-    CallResultParallel = (real *)_mm_malloc(mem_size, SIMDALIGN);
-    CallConfidence     = (real *)_mm_malloc(mem_size, SIMDALIGN);
-    StockPrice         = (real *)_mm_malloc(mem_size, SIMDALIGN);
-    OptionStrike       = (real *)_mm_malloc(mem_size, SIMDALIGN);
-    OptionYears        = (real *)_mm_malloc(mem_size, SIMDALIGN);
+    CallResultParallel = (real *)BackendAlloc(mem_size, SIMDALIGN);
+    CallConfidence     = (real *)BackendAlloc(mem_size, SIMDALIGN);
+    StockPrice         = (real *)BackendAlloc(mem_size, SIMDALIGN);
+    OptionStrike       = (real *)BackendAlloc(mem_size, SIMDALIGN);
+    OptionYears        = (real *)BackendAlloc(mem_size, SIMDALIGN);
 
     // Initialize Test Problem
     for(int i = 0; i < OPT_N; i++)
@@ -274,29 +278,24 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
     }
 
     unsigned int passes = op.getOptionInt("passes");
+    const bool useMIC = UseOffload(op);
+    const int micdev = op.getOptionInt("target");
     double start;
 
     // Initialize  data on the coprocessor
-    #pragma offload target (mic:0)                                     \
-        in(StockPrice: length(OPT_N) alloc_if(1) free_if(0))           \
-        in(OptionStrike:length(OPT_N) alloc_if(1) free_if(0))          \
-        in(OptionYears : length(OPT_N)  alloc_if(1) free_if(0))        \
-        out(CallResultParallel : length(OPT_N) alloc_if(1) free_if(0)) \
-        out(CallConfidence : length(OPT_N) alloc_if(1) free_if(0))
-    {
-    }
+    BackendCreate(op, StockPrice, mem_size);
+    BackendCreate(op, OptionStrike, mem_size);
+    BackendCreate(op, OptionYears, mem_size);
+    BackendCreate(op, CallResultParallel, mem_size);
+    BackendCreate(op, CallConfidence, mem_size);
 
     // Transfer the data
     fflush(0);
     start=curr_second();
 
-    #pragma offload target (mic:0)                              \
-        in(OPT_N)                                               \
-        in(StockPrice: length(OPT_N) alloc_if(0) free_if(0))    \
-        in(OptionStrike:length(OPT_N) alloc_if(0) free_if(0))   \
-        in(OptionYears : length(OPT_N)  alloc_if(0) free_if(0))
-    {
-    }
+    BackendCopyIn(op, StockPrice, mem_size);
+    BackendCopyIn(op, OptionStrike, mem_size);
+    BackendCopyIn(op, OptionYears, mem_size);
 
     double transferTime=curr_second()-start;
     double kernelTime;
@@ -311,12 +310,9 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
         start=curr_second();
 
         // Do the compute
-        #pragma offload target (mic:0)                                       \
-           nocopy(StockPrice: length(OPT_N) alloc_if(0) free_if(0))          \
-           nocopy(OptionStrike:length(OPT_N) alloc_if(0) free_if(0))         \
-           nocopy(OptionYears : length(OPT_N)  alloc_if(0) free_if(0))       \
-           nocopy(CallResultParallel : length(OPT_N) alloc_if(0) free_if(0)) \
-           nocopy(CallConfidence : length(OPT_N) alloc_if(0) free_if(0))
+        #pragma offload target (mic:micdev) if(useMIC) in(OPT_N)           \
+           nocopy(StockPrice, OptionStrike, OptionYears)                     \
+           nocopy(CallResultParallel, CallConfidence)
         {
             MonteCarlo(CallResultParallel,
                        CallConfidence,
@@ -329,11 +325,8 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
 
         // Now copy the results back
         start=curr_second();
-        #pragma offload target(mic:0)\
-          out(CallResultParallel : length(OPT_N) alloc_if(0) free_if(0))  \
-          out(CallConfidence : length(OPT_N) alloc_if(0) free_if(0))
-        {
-        }
+        BackendCopyOut(op, CallResultParallel, mem_size);
+        BackendCopyOut(op, CallConfidence, mem_size);
 
         if (validate)
         {
@@ -384,25 +377,18 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
     // Print out answers for all wdot for loop_index of 0
 
     // Free the memory on the card
-   #pragma offload target (mic:0)                                       \
-        in(StockPrice: length(OPT_N) alloc_if(0) free_if(1))            \
-        in(OptionStrike:length(OPT_N) alloc_if(0) free_if(1))           \
-        in(OptionYears : length(OPT_N)  alloc_if(0) free_if(1))         \
-        out(CallResultParallel : length(OPT_N) alloc_if(0) free_if(1))  \
-        out(CallConfidence : length(OPT_N) alloc_if(0) free_if(1))
-    {
-    }
+    BackendRelease(op, StockPrice, mem_size);
+    BackendRelease(op, OptionStrike, mem_size);
+    BackendRelease(op, OptionYears, mem_size);
+    BackendRelease(op, CallResultParallel, mem_size);
+    BackendRelease(op, CallConfidence, mem_size);
 
     //Free host memory;
-    CallResultParallel = (real *)_mm_malloc(mem_size, SIMDALIGN);
-    CallConfidence     = (real *)_mm_malloc(mem_size, SIMDALIGN);
-    StockPrice         = (real *)_mm_malloc(mem_size, SIMDALIGN);
-    OptionStrike       = (real *)_mm_malloc(mem_size, SIMDALIGN);
-    OptionYears        = (real *)_mm_malloc(mem_size, SIMDALIGN);
-
-    _mm_free(CallResultParallel);
-    _mm_free(CallConfidence);
-    _mm_free(StockPrice);
-    _mm_free(OptionStrike);
-    _mm_free(OptionYears);
+    BackendFree(CallResultParallel);
+    BackendFree(CallConfidence);
+    BackendFree(StockPrice);
+    BackendFree(OptionStrike);
+    BackendFree(OptionYears);
 }
+
+SHOC_REGISTER_BENCHMARK(MC);
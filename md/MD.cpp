@@ -56,8 +56,11 @@
 #include "omp.h"
 
 #include "MD.h"
+#include "Backend.h"
 #include "OptionParser.h"
+#include "PerfCounters.h"
 #include "ResultDatabase.h"
+#include "Benchmark.h"
 #include "Timer.h"
 
 #ifdef __MIC2__
@@ -68,10 +71,6 @@
 #define SIMD_SIZE       16
 #define PF2_THRESHOLD   36960
 #define NUM_THREADS     228
-#define ALLOC           alloc_if(1)
-#define REUSE           alloc_if(0)
-#define RETAIN          free_if(0)
-#define FREE            free_if(1)
 
 using namespace std;
 
@@ -91,7 +90,7 @@ using namespace std;
 //
 // ****************************************************************************
 
-void addBenchmarkSpecOptions(OptionParser& op) {
+static void addBenchmarkSpecOptions(OptionParser& op) {
    // Problem Constants
    op.addOption("nAtom", OPT_INT, "0", "number of atoms");
    op.addOption("cutsq", OPT_FLOAT, "16.0", "cutoff distance squared");
@@ -284,11 +283,19 @@ bool checkResults(forceVecType*  d_force,
     return true;
 }
 
-void
+static void
 RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
 {
-   runTest<float,   float3,  float3, true>("MIC-MD-LJ-SP", resultDB, op);
-   runTest<double, double3, double3, true>("MIC-MD-LJ-DP", resultDB, op);
+   if (UseOffload(op))
+   {
+      runTest<float,   float3,  float3, true>("MIC-MD-LJ-SP", resultDB, op);
+      runTest<double, double3, double3, true>("MIC-MD-LJ-DP", resultDB, op);
+   }
+   else
+   {
+      runTest<float,   float3,  float3, false>("MIC-MD-LJ-SP", resultDB, op);
+      runTest<double, double3, double3, false>("MIC-MD-LJ-DP", resultDB, op);
+   }
 }
 
 template <class T, class forceVecType, class posVecType, bool useMIC>
@@ -318,11 +325,16 @@ void runTest(const string& testName, ResultDatabase& resultDB, OptionParser& op)
     const double     eps          = op.getOptionFloat("eps");
     const int        passes       = op.getOptionInt    ("passes");
     const int        iter         = op.getOptionInt    ("iterations");
+    const int        micdev       = op.getOptionInt    ("target");
+    PerfCounters     counters(op);
 
     // Allocate problem data on host
-    position         = (posVecType *)     _mm_malloc(nAtom*sizeof(posVecType), LINESIZE);
-    force            = (forceVecType*)    _mm_malloc(nAtom*sizeof(forceVecType), LINESIZE);
-    neighborList     = (int*)             _mm_malloc(nAtom*maxNeighbors*sizeof(int), LINESIZE);
+    const size_t positionBytes = nAtom*sizeof(posVecType);
+    const size_t forceBytes    = nAtom*sizeof(forceVecType);
+    const size_t neighborBytes = (size_t)nAtom*maxNeighbors*sizeof(int);
+    position     = (posVecType *)  BackendAlloc(positionBytes, LINESIZE);
+    force        = (forceVecType*) BackendAlloc(forceBytes, LINESIZE);
+    neighborList = (int*)          BackendAlloc(neighborBytes, LINESIZE);
 
     cout << "Initializing test problem (this can take several minutes for large problems)" << endl;
 
@@ -348,15 +360,18 @@ void runTest(const string& testName, ResultDatabase& resultDB, OptionParser& op)
         100.0 * ((double)totalPairs / (nAtom*maxNeighbors)) << " %" << endl;
 
     // Warm up the kernel and check correctness
-    size_t nl_length = nAtom * maxNeighbors;
-    #pragma offload target(mic:0) if(useMIC)                     \
-            in(position:length(nAtom)             ALLOC RETAIN)  \
-            in(neighborList:length(nl_length)     ALLOC RETAIN)  \
-            out(force:length(nAtom)               ALLOC RETAIN)
+    BackendCreate(op, position, positionBytes);
+    BackendCreate(op, neighborList, neighborBytes);
+    BackendCreate(op, force, forceBytes);
+    BackendCopyIn(op, position, positionBytes);
+    BackendCopyIn(op, neighborList, neighborBytes);
+    #pragma offload target(mic:micdev) if(useMIC)          \
+            nocopy(position, neighborList, force)
     {
         compute_lj_force<T, forceVecType, posVecType>(force, position,
             maxNeighbors, neighborList, cutsq, lj1, lj2, nAtom, maxNeighbors, 1);
     }
+    BackendCopyOut(op, force, forceBytes);
 
     // If results are incorrect, skip the performance tests
     cout << "Performing Correctness Check (can take several minutes)\n";
@@ -372,13 +387,9 @@ void runTest(const string& testName, ResultDatabase& resultDB, OptionParser& op)
 
     // Compute Transfer Time
     double start=curr_second();
-    #pragma offload target(mic:0) if(useMIC)                      \
-            in(position:length(nAtom)             REUSE RETAIN)   \
-            in(neighborList:length(nl_length)     REUSE RETAIN)   \
-            out(force:length(nAtom)               REUSE RETAIN)
-    {
-
-    }
+    BackendCopyIn(op, position, positionBytes);
+    BackendCopyIn(op, neighborList, neighborBytes);
+    BackendCopyOut(op, force, forceBytes);
     double transferTime=curr_second()-start;
 
     // Every pair of atoms compute distance - 8 flops
@@ -394,18 +405,18 @@ void runTest(const string& testName, ResultDatabase& resultDB, OptionParser& op)
     for (int i = 0; i < passes; i++)
     {
         double start1, stop, kernelTime, totalTime;
+        counters.Start();
         start1 = curr_second();
 
-        #pragma offload target(mic:0) if(useMIC)                         \
-                nocopy(position:length(nAtom)              REUSE RETAIN) \
-                nocopy(neighborList:length(nl_length)      REUSE RETAIN) \
-                nocopy(force:length(nAtom)                 REUSE RETAIN)
+        #pragma offload target(mic:micdev) if(useMIC)              \
+                nocopy(position, neighborList, force)
         {
             compute_lj_force<T, forceVecType, posVecType>(force, position,
                 maxNeighbors, neighborList, cutsq, lj1, lj2, nAtom, maxNeighbors, iter);
         }
 
         stop         = curr_second();
+        counters.Stop();
         kernelTime     = (stop - start1) / (double)iter;
         totalTime     = kernelTime + transferTime;
 
@@ -416,20 +427,21 @@ void runTest(const string& testName, ResultDatabase& resultDB, OptionParser& op)
         resultDB.AddResult(testName + "-Bandwidth", atts, "GB/s",      gbytes / totalTime);
         resultDB.AddResult(testName + "-Bandwidth_PCIe", atts, "GB/s", gbytes / (kernelTime+transferTime));
         resultDB.AddResult(testName + "_Parity", atts, "N", (transferTime) / kernelTime);
+        counters.Record(resultDB, testName, atts, gflops * 1e9 * iter);
+        resultDB.SetWork(testName, atts, gflops * 1e9, (double)nbytes,
+                         sizeof(T) == sizeof(double) ? "DP" : "SP");
     }
 
     // Clean up MIC
-    #pragma offload target(mic:0) if(useMIC)                  \
-        nocopy(position:length(nAtom)             REUSE FREE) \
-        nocopy(neighborList:length(nl_length)     REUSE FREE) \
-        out(force:length(nAtom)                   REUSE FREE)
-    {
-    }
+    BackendCopyOut(op, force, forceBytes);
+    BackendRelease(op, position, positionBytes);
+    BackendRelease(op, neighborList, neighborBytes);
+    BackendRelease(op, force, forceBytes);
 
     // Clean up host
-    _mm_free(position);
-    _mm_free(force);
-    _mm_free(neighborList);
+    BackendFree(position);
+    BackendFree(force);
+    BackendFree(neighborList);
 }
 
 // ********************************************************
@@ -632,3 +644,5 @@ inline int populateNeighborList(list<T>& currDist,
     }
     return validPairs;
 }
+
+SHOC_REGISTER_BENCHMARK(MD);
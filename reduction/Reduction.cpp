@@ -42,8 +42,10 @@
 #include "omp.h"
 #include "offload.h"
 
+#include "Backend.h"
 #include "OptionParser.h"
 #include "ResultDatabase.h"
+#include "Benchmark.h"
 #include "Timer.h"
 
 #ifdef __MIC2__
@@ -54,7 +56,7 @@ using namespace std;
 
 // Forward Declaration
 template <class T>
-void RunTest(string, ResultDatabase &, OptionParser &);
+static void RunTest(string, ResultDatabase &, OptionParser &);
 
 // ****************************************************************************
 // Function: reduceGold
@@ -133,29 +135,31 @@ bool check(T result, T ref) {
     return true;
 }
 
-void addBenchmarkSpecOptions(OptionParser& op)
+static void addBenchmarkSpecOptions(OptionParser& op)
 {
     op.addOption("iterations", OPT_INT, "256",
             "specify reduction iterations");
 }
 
 template <typename T>
-void RunTest(string testName, ResultDatabase& resultDB, OptionParser& op) 
+static void
+RunTest(string testName, ResultDatabase& resultDB, OptionParser& op) 
 {
     __attribute__ ((target(mic))) T *indata  = NULL;
     __attribute__ ((target(mic))) T *outdata = NULL;
 
     const int micdev = op.getOptionInt("target");
+    const bool useMIC = UseOffload(op);
 
     // Get Problem Size
     int probSizes[4] = { 4, 8, 32, 64 };
     int N = probSizes[op.getOptionInt("size")-1];
     N = (N * 1024 * 1024) / sizeof(T);
 
-    indata = (T*) _mm_malloc(N * sizeof(T), (2*1024*1024));
+    indata = (T*) BackendAlloc(N * sizeof(T), (2*1024*1024));
     if (!indata) return;
 
-    outdata = (T*)_mm_malloc(64 * sizeof(T), (2*1024*1024));
+    outdata = (T*)BackendAlloc(64 * sizeof(T), (2*1024*1024));
     if (!outdata) return;
 
     // Initialize Host Memory
@@ -182,28 +186,20 @@ void RunTest(string testName, ResultDatabase& resultDB, OptionParser& op)
         double avgTime;
         double transferTime=0;
 
-        #pragma offload target(mic:micdev) \
-        in(outdata:length(64)  align(4*1024*1024) alloc_if(1) free_if(0))
-        {
-        }
+        BackendCreate(op, outdata, 64 * sizeof(T));
+        BackendCopyIn(op, outdata, 64 * sizeof(T));
         // Warm up
-        #pragma offload target(mic:micdev) \
-        in(indata:length(N)  align(4*1024*1024) alloc_if(1) free_if(0))
-        {
-        }
+        BackendCreate(op, indata, N * sizeof(T));
+        BackendCopyIn(op, indata, N * sizeof(T));
 
         start = curr_second();
 
-        #pragma offload target(mic:micdev) \
-        in(indata:length(N)  alloc_if(0) free_if(0))
-        {
-        }
+        BackendCopyIn(op, indata, N * sizeof(T));
         stop = curr_second();
         transferTime = stop - start;
 
         start = curr_second();
-        #pragma offload target(mic:micdev) nocopy(indata:length(N) \
-                align(4*1024) alloc_if(0) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) nocopy(indata)
         {
             for (int j=0; j<iterations; j++) 
             {
@@ -216,20 +212,15 @@ void RunTest(string testName, ResultDatabase& resultDB, OptionParser& op)
         avgTime = (stop - start) / (double)iterations;
 
         start = curr_second();
-        #pragma offload target(mic:micdev) \
-                out(outdata:length(64) alloc_if(0) free_if(1) )
-        {
-        }
+        BackendCopyOut(op, outdata, 64 * sizeof(T));
         stop = curr_second();
         transferTime += (stop - start);
 
         check(result, ref);
 
-        // Free buffer on card
-        #pragma offload target(mic:micdev) nocopy(indata:length(N) \
-                align(4*1024*1024) alloc_if(0) free_if(1))
-        {
-        }
+        // Free buffers on card
+        BackendRelease(op, outdata, 64 * sizeof(T));
+        BackendRelease(op, indata, N * sizeof(T));
 
         double gbytes = (double)(N*sizeof(T))/(1000.*1000.*1000.);
         resultDB.AddResult(testName, atts, "GB/s", gbytes / avgTime);
@@ -238,8 +229,8 @@ void RunTest(string testName, ResultDatabase& resultDB, OptionParser& op)
         resultDB.AddResult(testName+"_Parity", atts, "N",
                 transferTime / avgTime);
     }
-    _mm_free( indata);
-    _mm_free( outdata);
+    BackendFree(indata);
+    BackendFree(outdata);
 }
 
 /*
@@ -248,7 +239,7 @@ void RunTest(string testName, ResultDatabase& resultDB, OptionParser& op)
  * setenv MIC_OMP_NUM_THREADS 90
  * setenv MIC_KMP_AFFINITY balanced,granularity=fine
  */
-void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
+static void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
 {
     cout << "Running single precision test" << endl;
     RunTest<float>("Reduction", resultDB, op);
@@ -257,3 +248,4 @@ void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
     RunTest<double>("Reduction-DP", resultDB, op);
 }
 
+SHOC_REGISTER_BENCHMARK(Reduction);
@@ -36,8 +36,10 @@
 #include <string>
 #include <sstream>
 
+#include "Backend.h"
 #include "OptionParser.h"
 #include "ResultDatabase.h"
+#include "Benchmark.h"
 #include "S3D.h"
 #include "Timer.h"
 
@@ -52,7 +54,8 @@ using namespace std;
 
 // Forward declaration
 template <class real, int MAXVL>
-void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op);
+static void
+RunTest(string testName, ResultDatabase &resultDB, OptionParser &op);
 
 // ********************************************************
 // Function: toString
@@ -93,7 +96,7 @@ template<class T> inline string toString(const T& t)
 // Modifications:
 //
 // ****************************************************************************
-    void
+static void
 addBenchmarkSpecOptions(OptionParser &op)
 {
     ; // No S3D specific options
@@ -117,7 +120,7 @@ addBenchmarkSpecOptions(OptionParser &op)
 // Modifications:
 //
 // ****************************************************************************
-void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
+static void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
 {
     RunTest<float, 16>("S3D-SP_16", resultDB, op); 
     RunTest<double, 8>("S3D-DP_8", resultDB, op);
@@ -143,7 +146,8 @@ void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
 #define yspec(i,j) vecarr(yspec,i,j)
 
 template <class real, int MAXVL>
-void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
+static void
+RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
 {
     // Number of grid points (specified in header file)
     const int probSizes[4] = { 16, 32, 40, 64 };
@@ -167,18 +171,33 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
     __declspec(target(MIC) align(4096)) static real *host_eg;
 
     // Malloc host memory
-    host_t=(real*)_mm_malloc(n*sizeof(real),ALIGN);
-    host_p=(real*)_mm_malloc(n*sizeof(real),ALIGN);;
-    host_y=(real*)_mm_malloc(Y_SIZE*n*sizeof(real),ALIGN);;
-    host_wdot=(real*)_mm_malloc(WDOT_SIZE*n*sizeof(real),ALIGN);
-    host_molwt=(real*)_mm_malloc(WDOT_SIZE*n*sizeof(real),ALIGN);
-
-    host_rf=(real*)_mm_malloc(n*RF_SIZE*sizeof(real), ALIGN);
-    host_rb=(real*)_mm_malloc(n*RB_SIZE*sizeof(real), ALIGN);
-    host_rklow=(real*)_mm_malloc(n*RKLOW_SIZE*sizeof(real), ALIGN);
-    host_c=(real*)_mm_malloc(n*C_SIZE*sizeof(real), ALIGN);
-    host_a=(real*)_mm_malloc(n*A_SIZE*sizeof(real), ALIGN);
-    host_eg=(real*)_mm_malloc(n*EG_SIZE*sizeof(real), ALIGN);
+    host_t=(real*)BackendAlloc(n*sizeof(real),ALIGN);
+    host_p=(real*)BackendAlloc(n*sizeof(real),ALIGN);
+    host_y=(real*)BackendAlloc(Y_SIZE*n*sizeof(real),ALIGN);
+    host_wdot=(real*)BackendAlloc(WDOT_SIZE*n*sizeof(real),ALIGN);
+    host_molwt=(real*)BackendAlloc(WDOT_SIZE*n*sizeof(real),ALIGN);
+
+    host_rf=(real*)BackendAlloc(n*RF_SIZE*sizeof(real), ALIGN);
+    host_rb=(real*)BackendAlloc(n*RB_SIZE*sizeof(real), ALIGN);
+    host_rklow=(real*)BackendAlloc(n*RKLOW_SIZE*sizeof(real), ALIGN);
+    host_c=(real*)BackendAlloc(n*C_SIZE*sizeof(real), ALIGN);
+    host_a=(real*)BackendAlloc(n*A_SIZE*sizeof(real), ALIGN);
+    host_eg=(real*)BackendAlloc(n*EG_SIZE*sizeof(real), ALIGN);
+
+    // The arrays mirrored on the card; the first four are inputs
+    real *bufs[11] = { host_t, host_p, host_y, host_molwt, host_wdot,
+                       host_rf, host_rb, host_rklow, host_c, host_a,
+                       host_eg };
+    const size_t bufBytes[11] = { n*sizeof(real), n*sizeof(real),
+                                  n*Y_SIZE*sizeof(real),
+                                  n*WDOT_SIZE*sizeof(real),
+                                  n*WDOT_SIZE*sizeof(real),
+                                  n*RF_SIZE*sizeof(real),
+                                  n*RB_SIZE*sizeof(real),
+                                  n*RKLOW_SIZE*sizeof(real),
+                                  n*C_SIZE*sizeof(real),
+                                  n*A_SIZE*sizeof(real),
+                                  n*EG_SIZE*sizeof(real) };
 
     // Initialize Test Problem
 
@@ -216,42 +235,29 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
     }
 
     unsigned int passes = op.getOptionInt("passes");
+    const bool useMIC = UseOffload(op);
+    const int micdev = op.getOptionInt("target");
     double start;
 
     // Allocate data on the coprocessor
-    #pragma offload target(mic:0)                                   \
-        in(host_t:length(n) alloc_if(1) free_if(0))                 \
-        in(host_p:length(n) alloc_if(1) free_if(0))                 \
-        in(host_y:length(n*Y_SIZE)  alloc_if(1) free_if(0))         \
-        in(host_molwt:length(n*WDOT_SIZE)  alloc_if(1) free_if(0))  \
-        out(host_wdot:length(n*WDOT_SIZE)  alloc_if(1) free_if(0))  \
-        in(host_rf:length(n*RF_SIZE)  alloc_if(1) free_if(0))       \
-        in(host_rb:length(n*RB_SIZE)  alloc_if(1) free_if(0))       \
-        in(host_rklow:length(n*RKLOW_SIZE)  alloc_if(1) free_if(0)) \
-        in(host_c:length(n*C_SIZE)  alloc_if(1) free_if(0))         \
-        in(host_a:length(n*A_SIZE)  alloc_if(1) free_if(0))         \
-        in(host_eg:length(n*EG_SIZE)  alloc_if(1) free_if(0))
+    for (int b = 0; b < 11; b++)
     {
-    }   
+        BackendCreate(op, bufs[b], bufBytes[b]);
+    }
 
     // Transfer the data
     fflush(0);
     start=curr_second();
-    #pragma offload_transfer target(mic:0)                 \
-        in(host_t:length(n) alloc_if(0) free_if(0))        \
-        in(host_p:length(n) alloc_if(0) free_if(0))        \
-        in(host_y:length(n*Y_SIZE) alloc_if(0) free_if(0)) \
-        in(host_molwt:length(n*WDOT_SIZE) alloc_if(0) free_if(0))
+    for (int b = 0; b < 4; b++)
     {
+        BackendCopyIn(op, bufs[b], bufBytes[b]);
     }
     double transferTime=curr_second()-start;
     double kernelTime;
     double otransferTime;
 
     
-    #pragma offload target(mic:0)                       \
-        nocopy(host_p:length(n) alloc_if(0) free_if(0)) \
-        nocopy(host_t:length(n) alloc_if(0) free_if(0))
+    #pragma offload target(mic:micdev) if(useMIC) nocopy(host_p, host_t)
     {
         ALIGN64 real dummy[n];
         #pragma omp parallel for private(dummy)
@@ -270,18 +276,9 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
         start=curr_second();
 
     // Do the compute 
-        #pragma offload target(mic:0)                                  \
-        nocopy(host_t:length(n) alloc_if(0) free_if(0))                \
-        nocopy(host_p:length(n) alloc_if(0) free_if(0))                \
-        nocopy(host_y:length(n*Y_SIZE) alloc_if(0) free_if(0))         \
-        nocopy(host_molwt:length(n*WDOT_SIZE) alloc_if(0) free_if(0))  \
-        nocopy(host_wdot:length(n*WDOT_SIZE) alloc_if(0) free_if(0))   \
-        nocopy(host_rf:length(n*RF_SIZE) alloc_if(0) free_if(0))       \
-        nocopy(host_rb:length(n*RB_SIZE) alloc_if(0) free_if(0))       \
-        nocopy(host_rklow:length(n*RKLOW_SIZE) alloc_if(0) free_if(0)) \
-        nocopy(host_c:length(n*C_SIZE) alloc_if(0) free_if(0))         \
-        nocopy(host_a:length(n*A_SIZE) alloc_if(0) free_if(0))         \
-        nocopy(host_eg:length(n*EG_SIZE) alloc_if(0) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC)                  \
+        nocopy(host_t, host_p, host_y, host_molwt, host_wdot)          \
+        nocopy(host_rf, host_rb, host_rklow, host_c, host_a, host_eg)
         {
             ALIGN64 real rr_r1[MAXVL*22], yspec[MAXVL*22];
             ALIGN64 real ptemp[MAXVL], ttemp[MAXVL];
@@ -328,10 +325,7 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
 
         // Now copy the results back
         start=curr_second();
-        #pragma offload target(mic:0)\
-        out(host_wdot:length(n*WDOT_SIZE) alloc_if(0) free_if(0))
-        {
-        }
+        BackendCopyOut(op, host_wdot, n*WDOT_SIZE*sizeof(real));
 
         otransferTime=curr_second()-start;
 
@@ -343,6 +337,10 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
                            gflops / (kernelTime + transferTime + otransferTime));
         resultDB.AddResult(testName + "_Parity", toString(n) + "_gridPoints", "N",
                            (transferTime + otransferTime) / kernelTime);
+        // Temperature, pressure and mass fractions in, rates out
+        resultDB.SetWork(testName, toString(n) + "_gridPoints", n * 10000.,
+                         (2. + Y_SIZE + WDOT_SIZE) * n * sizeof(real),
+                         sizeof(real) == sizeof(double) ? "DP" : "SP");
     }
 
 
@@ -355,33 +353,16 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
     printf("\n");
 
     // Free the memory on the card
-#pragma offload target(mic:0)                           \
-    in(host_t:length(n) alloc_if(0))                    \
-    in(host_p:length(n) alloc_if(0))                    \
-    in(host_y:length(n*Y_SIZE) alloc_if(0))             \
-    in(host_molwt:length(n*WDOT_SIZE) alloc_if(0))      \
-    out(host_wdot:length(n*WDOT_SIZE) alloc_if(0))      \
-    in(host_rf:length(n*RF_SIZE) alloc_if(0))           \
-    in(host_rb:length(n*RB_SIZE) alloc_if(0))           \
-    in(host_rklow:length(n*RKLOW_SIZE) alloc_if(0))     \
-    in(host_c:length(n*C_SIZE) alloc_if(0))             \
-    in(host_a:length(n*A_SIZE) alloc_if(0))             \
-    in(host_eg:length(n*EG_SIZE) alloc_if(0))
+    for (int b = 0; b < 11; b++)
     {
+        BackendRelease(op, bufs[b], bufBytes[b]);
     }
 
-
     //Free memory;
-    _mm_free(host_t);
-    _mm_free(host_p);
-    _mm_free(host_y);
-    _mm_free(host_wdot);
-    _mm_free(host_molwt);
-
-    _mm_free(host_rf);
-    _mm_free(host_rb);
-    _mm_free(host_rklow);
-    _mm_free(host_c);
-    _mm_free(host_a);
-    _mm_free(host_eg);
+    for (int b = 0; b < 11; b++)
+    {
+        BackendFree(bufs[b]);
+    }
 }
+
+SHOC_REGISTER_BENCHMARK(S3D);
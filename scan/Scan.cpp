@@ -42,8 +42,10 @@
 
 #include <unistd.h>
 #include "omp.h"
+#include "Backend.h"
 #include "OptionParser.h"
 #include "ResultDatabase.h"
+#include "Benchmark.h"
 #include "Timer.h"
 
 #ifdef __MIC2__
@@ -77,7 +79,7 @@ using namespace std;
 // Modifications:
 //
 // ****************************************************************************
-void addBenchmarkSpecOptions(OptionParser &op)
+static void addBenchmarkSpecOptions(OptionParser &op)
 {
     op.addOption("iterations", OPT_INT, "256", "specify scan iterations");
 }
@@ -100,7 +102,7 @@ void addBenchmarkSpecOptions(OptionParser &op)
 // Modifications:
 //
 // ****************************************************************************
-void
+static void
 RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
 {
     cout << "Running single precision test" << endl;
@@ -112,21 +114,28 @@ RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
 }
 
 template <class T>
-void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
+static void
+RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
 {
     int pbIndex = op.getOptionInt("size") - 1;
     int passes  = op.getOptionInt("passes");
     int iters   = op.getOptionInt("iterations");
     int micdev  = op.getOptionInt("target");
+    const bool useMIC = UseOffload(op);
 
     int nThreads = 228; // Default
 
-    #pragma offload target(mic) inout(nThreads)
+    #pragma offload target(mic) if(useMIC) inout(nThreads)
     {
         nThreads = sysconf(_SC_NPROCESSORS_ONLN) - 4; // Leave something for the OS
     }
+    if (nThreads < 1)
+    {
+        nThreads = 1;
+    }
 
-    printf("Using %d available threads for MIC run.\n", nThreads);
+    printf("Using %d available threads for %s run.\n", nThreads,
+           useMIC ? "MIC" : "host");
 
     size_t szOptimum = L1B * nThreads;
 
@@ -139,9 +148,9 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
     __declspec(target(MIC)) static T* reference;
     __declspec(target(MIC)) static T* h_odata;
 
-    h_idata     = (T*)_mm_malloc(pbSizeBytes + ALIGN * sizeof(T), ALIGN);
-    reference   = (T*)_mm_malloc(pbSizeBytes + ALIGN * sizeof(T), ALIGN);
-    h_odata     = (T*)_mm_malloc(pbSizeBytes + ALIGN * sizeof(T), ALIGN);
+    h_idata     = (T*)BackendAlloc(pbSizeBytes + ALIGN * sizeof(T), ALIGN);
+    reference   = (T*)BackendAlloc(pbSizeBytes + ALIGN * sizeof(T), ALIGN);
+    h_odata     = (T*)BackendAlloc(pbSizeBytes + ALIGN * sizeof(T), ALIGN);
 
     //Manually align memory
     h_idata += ALIGN - 1;
@@ -157,17 +166,14 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
     }
 
     // Allocate data to mic
-    #pragma offload target(mic:micdev) in(h_idata:length(pbSizeElements + 1) free_if(0)) \
-        out(h_odata:length(pbSizeElements + 1) free_if(0))
-    {
-    }
+    const size_t dataBytes = (pbSizeElements + 1) * sizeof(T);
+    BackendCreate(op, h_idata, dataBytes);
+    BackendCreate(op, h_odata, dataBytes);
 
     double start = curr_second();
     // Get data transfer time
-    #pragma offload target(mic:micdev) in(h_idata:length(pbSizeElements + 1) alloc_if(0) \
-            free_if(0)) out(h_odata:length(pbSizeElements + 1) alloc_if(0) free_if(0))
-    {
-    }
+    BackendCopyIn(op, h_idata, dataBytes);
+    BackendCopyOut(op, h_odata, dataBytes);
 
     float transferTime = curr_second()-start;
 
@@ -177,9 +183,7 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
 
         double totalScanTime = 0.0f;
         start = curr_second();
-        #pragma offload target(mic:micdev) nocopy(h_idata:length(pbSizeElements + 1) \
-                alloc_if(0) free_if(0)) nocopy(h_odata:length(pbSizeElements + 1)    \
-                alloc_if(0) free_if(0))
+        #pragma offload target(mic:micdev) if(useMIC) nocopy(h_idata, h_odata)
         {
             if (pbIndex > 0)
             {
@@ -204,10 +208,7 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
         double stop = curr_second();
         totalScanTime = (stop-start);
 
-        #pragma offload target(mic:micdev) out(h_odata:length(pbSizeElements + 1) \
-                alloc_if(0) free_if(0))
-        {
-        }
+        BackendCopyOut(op, h_odata, dataBytes);
 
         // If results aren't correct, don't report perf numbers
         if (! scanCPU<T>(h_idata, reference, h_odata, pbSizeElements))
@@ -225,13 +226,11 @@ void RunTest(string testName, ResultDatabase &resultDB, OptionParser &op)
     }
 
     // Clean up
-    #pragma offload target(mic:micdev) in(h_idata:length(pbSizeElements + 1) alloc_if(0) ) \
-                                out(h_odata:length(pbSizeElements + 1) alloc_if(0))
-    {
-    }
-    _mm_free(h_idata - ALIGN + 1);
-    _mm_free(h_odata - ALIGN + 1);
-    _mm_free(reference);
+    BackendRelease(op, h_idata, dataBytes);
+    BackendRelease(op, h_odata, dataBytes);
+    BackendFree(h_idata - ALIGN + 1);
+    BackendFree(h_odata - ALIGN + 1);
+    BackendFree(reference);
 }
 
 // ****************************************************************************
@@ -287,3 +286,5 @@ bool scanCPU(T *data, T* reference, T* dev_result, const size_t size)
         cout << "Failed" << endl;
     return passed;
 }
+
+SHOC_REGISTER_BENCHMARK(Scan);
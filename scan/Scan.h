@@ -32,9 +32,6 @@
 // ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
 // THE POSSIBILITY OF SUCH DAMAGE.
 
-void
-RunBenchmark(ResultDatabase&, OptionParser&);
-
 template <class T>
 __declspec(target(mic))
 void scanArray(T* , T* , const size_t);
@@ -43,5 +40,5 @@ template <class T>
 bool scanCPU(T*, T* , T* , const size_t );
 
 template <class T>
-void RunTest(string , ResultDatabase &, OptionParser &);
+static void RunTest(string , ResultDatabase &, OptionParser &);
 
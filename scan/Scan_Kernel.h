@@ -41,14 +41,17 @@ template <class T> __declspec(target(mic)) void SCAN_KNC(T* pInput,
                                                          T fOffset)
 {
     // Keep partial sums in it
-    unsigned int nThreads = sysconf(_SC_NPROCESSORS_ONLN) - 4; // Leave something for the OS
+    int nOnline = sysconf(_SC_NPROCESSORS_ONLN) - 4; // Leave something for the OS
+    unsigned int nThreads = (nOnline > 0) ? nOnline : 1;
 
     T*     pPartialSums    = (T*)_mm_malloc((nThreads + 1) * sizeof(T), ALIGN);
     size_t nThreadElements = nElements / nThreads;
 
     __declspec(target(mic)) __declspec(align(64)) volatile int g_nThdIndex = -1;
 
-    #pragma omp parallel
+    // One partial sum per thread, so the team must match nThreads on the
+    // host as well as on the card
+    #pragma omp parallel num_threads(nThreads)
     {
         int i = _InterlockedIncrement((void *)&g_nThdIndex);
 
@@ -40,8 +40,10 @@
 #include "mkl_types.h"
 #include "mkl_spblas.h"
 
+#include "Backend.h"
 #include "OptionParser.h"
 #include "ResultDatabase.h"
+#include "Benchmark.h"
 #include "Timer.h"
 #include "util.h"
 
@@ -64,7 +66,7 @@ char *target_str[] = { "CPU", "MKL", "MIC", "MKL_MIC" };
 // Returns:  nothing
 //
 // ****************************************************************************
-void addBenchmarkSpecOptions(OptionParser &op)
+static void addBenchmarkSpecOptions(OptionParser &op)
 {
     op.addOption("iterations", OPT_INT, "100", "Number of SpMV iterations "
                  "per pass"); 
@@ -239,7 +241,8 @@ bool verifyResults(const floatType *cpuResults, const floatType *gpuResults,
 //
 // ****************************************************************************
 template <typename floatType> 
-void RunTest( ResultDatabase &resultDB, OptionParser &op, enum spmv_target 
+static void
+RunTest( ResultDatabase &resultDB, OptionParser &op, enum spmv_target 
         target, int nRows=0) 
 {
     // Host data structures
@@ -301,44 +304,42 @@ void RunTest( ResultDatabase &resultDB, OptionParser &op, enum spmv_target
 
     cout << target_str[target] << " Test\n";
     int micdev = op.getOptionInt("target"); 
+    const bool useMIC = UseOffload(op);
 
     int passes = op.getOptionInt("passes");
     int iters  = op.getOptionInt("iterations");
 
+    // What the card needs, and how much of each buffer it uses
+    void *bufs[5] = { h_cols, h_rowDelimiters, h_vec, h_val, h_out };
+    const size_t bufBytes[5] = { nItems * sizeof(int),
+                                 (numRows + 1) * sizeof(int),
+                                 numRows * sizeof(floatType),
+                                 nItems * sizeof(floatType),
+                                 numRows * sizeof(floatType) };
+
     for (int k = 0; k < passes; k++)
     {
         double iTransferTime, oTransferTime, totalKernelTime;
         switch (target) {
         case use_mic:
             // Warm up MIC device
-            #pragma offload target(mic:micdev) in(k)
-            { }
-            #pragma offload target(mic:micdev) \
-                        in(h_cols:length(nItems)             free_if(0)) \
-                        in(h_rowDelimiters:length(numRows+1) free_if(0)) \
-                        in(h_vec:length(numRows)             free_if(0)) \
-                        in(h_val:length(nItems)              free_if(0)) \
-                        in(h_out:length(numRows)             free_if(0))
+            #pragma offload target(mic:micdev) if(useMIC) in(k)
             { }
-
+            for (int b = 0; b < 5; b++)
+            {
+                BackendCreate(op, bufs[b], bufBytes[b]);
+            }
 
             iTransferTime = curr_second();
-            #pragma offload target(mic:micdev) \
-                in(h_cols:length(nItems)              alloc_if(0) free_if(0)) \
-                in(h_rowDelimiters:length(numRows+1)  alloc_if(0) free_if(0)) \
-                in(h_vec:length(numRows)              alloc_if(0) free_if(0)) \
-                in(h_val:length(nItems)               alloc_if(0) free_if(0)) \
-                in(h_out:length(numRows)              alloc_if(0) free_if(0))
-                { }
+            for (int b = 0; b < 5; b++)
+            {
+                BackendCopyIn(op, bufs[b], bufBytes[b]);
+            }
             iTransferTime = curr_second() - iTransferTime;
 
             totalKernelTime = curr_second();
-            #pragma offload target(mic:micdev) in(numRows, iters) \
-            nocopy(h_cols:length(nItems)             alloc_if(0) free_if(0)) \
-            nocopy(h_rowDelimiters:length(numRows+1) alloc_if(0) free_if(0)) \
-            nocopy(h_vec:length(numRows)             alloc_if(0) free_if(0)) \
-            nocopy(h_val:length(nItems)              alloc_if(0) free_if(0)) \
-            nocopy(h_out:length(numRows)             alloc_if(0) free_if(0))
+            #pragma offload target(mic:micdev) if(useMIC) in(numRows, iters) \
+                nocopy(h_cols, h_rowDelimiters, h_vec, h_val, h_out)
             for (int i=0; i<iters; i++) 
             {
                 spmvMic(h_val, h_cols, h_rowDelimiters, h_vec, numRows, h_out);
@@ -346,14 +347,12 @@ void RunTest( ResultDatabase &resultDB, OptionParser &op, enum spmv_target
             totalKernelTime = curr_second() - totalKernelTime;
 
             oTransferTime = curr_second();
-            #pragma offload target(mic:micdev) \
-              nocopy(h_cols:length(nItems)             alloc_if(0) free_if(1)) \
-              nocopy(h_rowDelimiters:length(numRows+1) alloc_if(0) free_if(1)) \
-              nocopy(h_vec:length(numRows)             alloc_if(0) free_if(1)) \
-              nocopy(h_val:length(nItems)              alloc_if(0) free_if(1)) \
-              out(h_out:length(numRows)                alloc_if(0) free_if(1)) 
-            { }
+            BackendCopyOut(op, h_out, bufBytes[4]);
             oTransferTime = curr_second() - oTransferTime;
+            for (int b = 0; b < 5; b++)
+            {
+                BackendRelease(op, bufs[b], bufBytes[b]);
+            }
             break;
 
         case use_cpu:
@@ -378,35 +377,23 @@ void RunTest( ResultDatabase &resultDB, OptionParser &op, enum spmv_target
 
         case use_mkl_mic:
             // Warm up MIC device
-            #pragma offload target(mic:micdev) in(k)
-            { }
-
-            #pragma offload target(mic:micdev) \
-                in(h_cols:length(nItems)             free_if(0)) \
-                in(h_rowDelimiters:length(numRows+1) free_if(0)) \
-                in(h_vec:length(numRows)             free_if(0)) \
-                in(h_val:length(nItems)              free_if(0)) \
-                in(h_out:length(numRows)             free_if(0))
+            #pragma offload target(mic:micdev) if(useMIC) in(k)
             { }
+            for (int b = 0; b < 5; b++)
+            {
+                BackendCreate(op, bufs[b], bufBytes[b]);
+            }
 
             iTransferTime = curr_second();
-            #pragma offload target(mic:micdev) \
-            in(h_cols:length(nItems)              alloc_if(0)  free_if(0)) \
-            in(h_rowDelimiters:length(numRows+1)  alloc_if(0)  free_if(0)) \
-            in(h_vec:length(numRows)              alloc_if(0)  free_if(0)) \
-            in(h_val:length(nItems)               alloc_if(0)  free_if(0)) \
-            in(h_out:length(numRows)              alloc_if(0)  free_if(0))
-            { }
+            for (int b = 0; b < 5; b++)
+            {
+                BackendCopyIn(op, bufs[b], bufBytes[b]);
+            }
             iTransferTime = curr_second() - iTransferTime;
 
             totalKernelTime = curr_second();
-            #pragma offload target(mic:micdev) \
-            in(numRows, iters) \
-            nocopy(h_cols:length(nItems)             alloc_if(0) free_if(0)) \
-            nocopy(h_rowDelimiters:length(numRows+1) alloc_if(0) free_if(0)) \
-            nocopy(h_vec:length(numRows)             alloc_if(0) free_if(0)) \
-            nocopy(h_val:length(nItems)              alloc_if(0) free_if(0)) \
-            nocopy(h_out:length(numRows)             alloc_if(0) free_if(0))
+            #pragma offload target(mic:micdev) if(useMIC) in(numRows, iters) \
+                nocopy(h_cols, h_rowDelimiters, h_vec, h_val, h_out)
             for (int i=0; i<iters; i++) 
             {
                     spmvMkl(h_val, h_cols, h_rowDelimiters, h_vec, numRows, h_out);
@@ -414,21 +401,12 @@ void RunTest( ResultDatabase &resultDB, OptionParser &op, enum spmv_target
             totalKernelTime = curr_second() - totalKernelTime;
 
             oTransferTime = curr_second();
-            #pragma offload target(mic:micdev) \
-            nocopy(h_cols:length(nItems)             alloc_if(0) free_if(0)) \
-            nocopy(h_rowDelimiters:length(numRows+1) alloc_if(0) free_if(0)) \
-            nocopy(h_vec:length(numRows)             alloc_if(0) free_if(0)) \
-            nocopy(h_val:length(nItems)              alloc_if(0) free_if(0)) \
-            out(h_out:length(numRows)                alloc_if(0) free_if(0))
-            { }
+            BackendCopyOut(op, h_out, bufBytes[4]);
             oTransferTime = curr_second() - oTransferTime;
-	    #pragma offload target(mic:micdev) \
-	    nocopy(h_cols:length(nItems)             alloc_if(0) free_if(1)) \
-            nocopy(h_rowDelimiters:length(numRows+1) alloc_if(0) free_if(1)) \
-	    nocopy(h_vec:length(numRows)             alloc_if(0) free_if(1)) \
-       	    nocopy(h_val:length(nItems)              alloc_if(0) free_if(1)) \
-            nocopy(h_out:length(numRows)                alloc_if(0) free_if(1))
-            { }
+            for (int b = 0; b < 5; b++)
+            {
+                BackendRelease(op, bufs[b], bufBytes[b]);
+            }
             break;
         }
 
@@ -443,6 +421,13 @@ void RunTest( ResultDatabase &resultDB, OptionParser &op, enum spmv_target
         bool dpTest = (sizeof(floatType) == sizeof(double));
         sprintf(benchName, "%s-%s", target_str[target], dpTest ? "DP":"SP");
         resultDB.AddResult(benchName, atts, "Gflop/s", gflop/avgTime);
+        // CSR traffic: values and column indices, row delimiters, and
+        // one pass over the input and output vectors
+        resultDB.SetWork(benchName, atts, 2 * (double) nItems,
+                (double) nItems * (sizeof(floatType) + sizeof(int)) +
+                (numRows + 1.0) * sizeof(int) +
+                2.0 * numRows * sizeof(floatType),
+                dpTest ? "DP" : "SP");
         sprintf(benchName, "%s_PCIe", benchName);
         resultDB.AddResult(benchName, atts, "Gflop/s", gflop / 
             (avgTime + iTransferTime + oTransferTime));
@@ -456,6 +441,7 @@ void RunTest( ResultDatabase &resultDB, OptionParser &op, enum spmv_target
     FREE(h_valPad);
     FREE(h_colsPad);
     FREE(h_rowDelimitersPad);
+    FREE(refOut);
 }
 
 // ****************************************************************************
@@ -475,7 +461,7 @@ void RunTest( ResultDatabase &resultDB, OptionParser &op, enum spmv_target
 // Modifications:
 //
 // ****************************************************************************
-void
+static void
 RunBenchmark( OptionParser &op, ResultDatabase &resultDB)
 {
     // Create list of problem sizes
@@ -491,3 +477,5 @@ RunBenchmark( OptionParser &op, ResultDatabase &resultDB)
     RunTest<double> (resultDB, op, use_mkl, probSizes[sizeClass]);
     RunTest<double> (resultDB, op, use_mkl_mic, probSizes[sizeClass]);
 }
+
+SHOC_REGISTER_BENCHMARK(Spmv);
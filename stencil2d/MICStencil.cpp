@@ -37,9 +37,9 @@ template<class T>
 MICStencil<T>::MICStencil( T _wCenter,
                     T _wCardinal,
                     T _wDiagonal,
-                    int _device )
+                    const OptionParser& _options )
   : Stencil<T>( _wCenter, _wCardinal, _wDiagonal ),
-    device( _device )
+    options( _options )
 {
     // nothing else to do
 }
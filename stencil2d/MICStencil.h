@@ -34,6 +34,7 @@
 #ifndef MICSTENCIL_H
 #define MICSTENCIL_H
 
+#include "OptionParser.h"
 #include "Stencil.h"
 
 // ****************************************************************************
@@ -50,7 +51,8 @@ template<class T>
 class MICStencil : public Stencil<T>
 {
 private:
-    int device;
+    // --backend and --target select where the kernel runs
+    const OptionParser& options;
 
 protected:
     virtual void DoPreIterationWork( T* currBuf,    // in device global memory
@@ -62,7 +64,7 @@ public:
     MICStencil( T _wCenter,
                     T _wCardinal,
                     T _wDiagonal,
-                    int _device );
+                    const OptionParser& _options );
 
     virtual void operator()( Matrix2D<T>&, unsigned int nIters );
 };
@@ -36,6 +36,7 @@
 #include <cassert>
 #include "MICStencilFactory.h"
 #include "MICStencil.h"
+#include "Backend.h"
 
 
 template<class T>
@@ -53,17 +54,12 @@ MICStencilFactory<T>::BuildStencil( const OptionParser& options )
                     wDiagonal,
                     devs );
 
-    // determine whcih device to use
-    // We would really prefer this to be done in main() but
-    // since BuildStencil is a virtual function, we cannot change its 
-    // signature, and OptionParser provides no way to override an
-    // options' value after it is set during parsing.
-    int chosenDevice = 0;//(int)devs[0];
-
+    // The stencil reads the backend and device from the options when
+    // it runs
     return new MICStencil<T>( wCenter, 
                                 wCardinal, 
                                 wDiagonal, 
-                                chosenDevice );
+                                options );
 }
 
 
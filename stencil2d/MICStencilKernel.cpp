@@ -45,14 +45,11 @@
 #include "omp.h"
 #include "math.h"
 #include "offload.h"
+#include "Backend.h"
 #include "Timer.h"
 #include "MICStencil.cpp"
 
 #define LINESIZE    64
-#define ALLOC       alloc_if(1)
-#define FREE        free_if(1)
-#define RETAIN      free_if(0)
-#define REUSE       alloc_if(0)
 
 ////////////////////////////////////////////////////////////////
 // TODO: Tune Threads, Partitions according to card's parameters
@@ -71,16 +68,20 @@ MICStencil<T>::operator()( Matrix2D<T>& mtx, unsigned int nIters )
     __declspec(target(mic), align(sizeof(T)))    T wdiag        = this->wDiagonal;
     __declspec(target(mic), align(sizeof(T)))    T wcardinal    = this->wCardinal;
 
-    #pragma offload target(mic) in(pIn:length(uImgElements) ALLOC RETAIN)
-    {
-        // Just copy pIn to compute the copy transfer time
-    }
+    const bool useMIC = UseOffload(options);
+    const int  micdev = options.getOptionInt("target");
+    const size_t imgBytes = uImgElements * sizeof(T);
+
+    BackendCreate(options, pIn, imgBytes);
+    BackendCopyIn(options, pIn, imgBytes);
 
-    #pragma offload target(mic) in(pIn:length(uImgElements) REUSE RETAIN)    \
+    #pragma offload target(mic:micdev) if(useMIC)                 \
+                                nocopy(pIn)                                  \
                                 in(uImgElements) in(uDimWithHalo)            \
                                 in(wcenter) in(wdiag) in(wcardinal)
     {
-        unsigned int uRowPartitions = sysconf(_SC_NPROCESSORS_ONLN) / 4 - 1;
+        int nRowPartitions = sysconf(_SC_NPROCESSORS_ONLN) / 4 - 1;
+        unsigned int uRowPartitions = (nRowPartitions > 0) ? nRowPartitions : 1;
         unsigned int uColPartitions = 4;    // Threads per core for KNC
 
         unsigned int uRowTileSize    = (uDimWithHalo - 2 * uHaloWidth) / uRowPartitions;
@@ -92,7 +93,8 @@ MICStencil<T>::operator()( Matrix2D<T>& mtx, unsigned int nIters )
         T *pTmp     = (T*)pIn;
         T *pCrnt = (T*)memset((T*)_mm_malloc(uImgElements * sizeof(T), LINESIZE), 0, uImgElements * sizeof(T));
 
-        #pragma omp parallel firstprivate(pTmp, pCrnt, uRowTileSize, uColTileSize, uHaloWidth, uDimWithHalo)
+        #pragma omp parallel num_threads(uRowPartitions * uColPartitions) \
+                             firstprivate(pTmp, pCrnt, uRowTileSize, uColTileSize, uHaloWidth, uDimWithHalo)
         {
             unsigned int uThreadId = omp_get_thread_num();
 
@@ -154,20 +156,19 @@ MICStencil<T>::operator()( Matrix2D<T>& mtx, unsigned int nIters )
         _mm_free(pCrnt);
     } // End Offload
 
-    #pragma offload target(mic) out(pIn:length(uImgElements) REUSE FREE)
-    {
-        // Just copy back pIn
-    }
+    BackendCopyOut(options, pIn, imgBytes);
+    BackendRelease(options, pIn, imgBytes);
 }
 
 void
 EnsureStencilInstantiation( void )
 {
-    MICStencil<float> csf( 0, 0, 0, 0 );
+    OptionParser op;
+    MICStencil<float> csf( 0, 0, 0, op );
     Matrix2D<float> mf( 2, 2 );
     csf( mf, 0);
 
-    MICStencil<double> csd( 0, 0, 0, 0 );
+    MICStencil<double> csd( 0, 0, 0, op );
     Matrix2D<double> md( 2, 2 );
     csd( md, 0);
 }
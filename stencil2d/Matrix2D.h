@@ -38,6 +38,7 @@
 #include <stdio.h>
 #include <iostream>
 #include "config.h"
+#include "Backend.h"
 
 // ****************************************************************************
 // Class:  Matrix2D
@@ -67,7 +68,7 @@ public:
     Matrix2D( size_t _nRows, size_t _nColumns )
       : nRows( _nRows ),
         nColumns( _nColumns ),
-        flatData((T*) _mm_malloc(nRows*nColumns*sizeof(T), 64)),
+        flatData((T*) BackendAlloc(nRows*nColumns*sizeof(T), 64)),
         data( new T*[nRows] )
     {
         for( size_t i = 0; i < nRows; i++ )
@@ -81,7 +82,7 @@ public:
         delete[] data;
         data = NULL;
 
-        _mm_free(flatData);
+        BackendFree(flatData);
         flatData = NULL;
     }
 
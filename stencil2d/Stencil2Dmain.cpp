@@ -39,7 +39,9 @@
 
 #include "OptionParser.h"
 #include "ResultDatabase.h"
+#include "Benchmark.h"
 #include "Timer.h"
+#include "PerfCounters.h"
 #include "BadCommandLine.h"
 #include "InvalidArgValue.h"
 #include "Matrix2D.h"
@@ -169,18 +171,22 @@ DoTest( const char* timerDesc, ResultDatabase& resultDB, OptionParser& opts )
     Matrix2D<T> data(arrayDims[0] + 2 * haloWidth, arrayDims[1] + 2 * haloWidth);
     testStencil = testStencilFactory->BuildStencil( opts );
 
+    PerfCounters counters(opts);
     std::cout<<"Passes:"<<nPasses<<endl;
     for( unsigned int pass = 0; pass < nPasses; pass++ )
     {
         init(data);
 
+        counters.Start();
         double start         = curr_second();
         (*testStencil)(data, nIters);
         double elapsedTime     = curr_second() - start;
+        counters.Stop();
 
         double gflopsPCIe     = (nflops / elapsedTime) / 1e9;
 
         resultDB.AddResult(timerDesc, experimentDescriptionStr.str(), "GFLOPS_PCIe", gflopsPCIe);
+        counters.Record(resultDB, timerDesc, experimentDescriptionStr.str(), nflops);
 
         if( beVerbose )
             std::cout << "observed result, pass " << pass << ":\n"<< data<< std::endl;
@@ -188,6 +194,11 @@ DoTest( const char* timerDesc, ResultDatabase& resultDB, OptionParser& opts )
         MICValidate(exp, data, valErrThreshold, nValErrsToPrint);
     }
 
+    // Each iteration streams the grid in and out once
+    resultDB.SetWork(timerDesc, experimentDescriptionStr.str(), nflops,
+                     2.0 * npts * sizeof(T) * nIters,
+                     sizeof(T) == sizeof(double) ? "DP" : "SP");
+
     // clean up - normal termination
     delete stdStencil;
     delete stdStencilFactory;
@@ -195,7 +206,7 @@ DoTest( const char* timerDesc, ResultDatabase& resultDB, OptionParser& opts )
     delete testStencilFactory;
 }
 
-void RunBenchmark(OptionParser& opts, ResultDatabase& resultDB )
+static void RunBenchmark(OptionParser& opts, ResultDatabase& resultDB )
 {
     std::cout << "Running Single Precision test :" << std::endl;
     DoTest<float>( "SP_Sten2D", resultDB, opts);
@@ -205,7 +216,7 @@ void RunBenchmark(OptionParser& opts, ResultDatabase& resultDB )
 }
 
 // Adds command line options to given OptionParser
-void addBenchmarkSpecOptions( OptionParser& opts )
+static void addBenchmarkSpecOptions( OptionParser& opts )
 {
     opts.addOption( "customSize",      OPT_VECINT, "0,0",   "specify custom problem size");
     opts.addOption( "num-iters",       OPT_INT,    "1000",  "number of stencil iterations" );
@@ -247,3 +258,5 @@ void CheckOptions( const OptionParser& opts )
         throw InvalidArgValue( "number of validation errors to print must be non-negative" );
     }
 }
+
+SHOC_REGISTER_BENCHMARK(Stencil2D);
@@ -0,0 +1,421 @@
+// This example from an alpha release of the Scalable HeterOgeneous Computing
+// (SHOC) Benchmark Suite Alpha v1.1.4a-mic for Intel MIC architecture
+// Contact: Kyle Spafford <kys@ornl.gov>
+//          Rezaur Rahman <rezaur.rahman@intel.com>
+//
+// Copyright (c) 2011, UT-Battelle, LLC
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of Oak Ridge National Laboratory, nor UT-Battelle, LLC, 
+//    nor the names of its contributors may be used to endorse or promote 
+//    products derived from this software without specific prior written 
+//    permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, 
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
+// THE POSSIBILITY OF SUCH DAMAGE.
+
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "omp.h"
+
+#include "offload.h"
+#include "Backend.h"
+#include "Benchmark.h"
+#include "CommonOptions.h"
+#include "OptionParser.h"
+#include "ResultDatabase.h"
+#include "Timer.h"
+#include "Suite.h"
+
+using namespace std;
+
+// The benchmarks linked into the driver, in run order
+static vector<SuiteBenchmark> benchmarks;
+
+// ****************************************************************************
+// Function: SetOffloadDefaults
+//
+// Purpose:
+//   Applies the offload runtime settings the old bin/runbench.sh exported
+//   for most benchmarks.  They must be in the environment before the
+//   first offload region runs; values already set by the user are left
+//   alone.  The settings MD, Scan and Stencil2D ran with (compact
+//   affinity, a 2 s block time, 128K 2 MB buffers and load_balance
+//   dynamic mode) are not applied; bin/runbench.sh runs those in their
+//   own processes with their environment.
+//
+// Arguments:
+//
+// Returns:  nothing
+//
+// ****************************************************************************
+static void SetOffloadDefaults()
+{
+    setenv("MIC_ENV_PREFIX", "MIC", 0);
+    setenv("MIC_USE_2MB_BUFFERS", "32K", 0);
+    setenv("MIC_KMP_AFFINITY", "granularity=fine,balanced", 0);
+    setenv("MIC_BUFFERSIZE", "128M", 0);
+    setenv("MIC_MKL_DYNAMIC", "false", 0);
+}
+
+// ****************************************************************************
+// Function: ListBenchmarks
+//
+// Purpose:
+//   Collects the registered benchmarks in the order, and with the card
+//   thread counts, of the old bin/runbench.sh.  Benchmarks left out of the
+//   build (Spmv and MC without MKL) are skipped; registered ones missing
+//   from that list run last with the runtime's default thread count.
+//
+// Arguments:  none
+//
+// Returns:  the benchmarks to offer
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+static vector<SuiteBenchmark> ListBenchmarks()
+{
+    static const struct
+    {
+        const char *name;
+        int micThreads;
+    } runOrder[] =
+    {
+        { "BusSpeed",         0   },
+        { "BusSpeedDownload", 0   },
+        { "BusSpeedReadback", 0   },
+        { "DeviceMemory",     228 },
+        { "MemoryLatency",    0   },
+        { "FFT",              228 },
+        { "GEMM",             228 },
+        { "MaxFlops",         228 },
+        { "Reduction",        114 },
+        { "S3D",              228 },
+        { "Spmv",             224 },
+        { "Triad",            228 },
+        { "MD",               224 },
+        { "Scan",             228 },
+        { "Stencil2D",        228 },
+        { "MC",               0   },
+    };
+    const int nOrdered = sizeof(runOrder) / sizeof(runOrder[0]);
+
+    vector<SuiteBenchmark> list;
+    for (int i = 0; i < nOrdered; i++)
+    {
+        const Benchmark *bench = FindBenchmark(runOrder[i].name);
+        if (bench != NULL)
+        {
+            SuiteBenchmark entry = { bench->name, bench->addOptions,
+                                     bench->run, runOrder[i].micThreads };
+            list.push_back(entry);
+        }
+    }
+
+    const vector<Benchmark> &registered = RegisteredBenchmarks();
+    for (size_t i = 0; i < registered.size(); i++)
+    {
+        bool ordered = false;
+        for (int j = 0; j < nOrdered; j++)
+        {
+            ordered = ordered || !strcmp(registered[i].name, runOrder[j].name);
+        }
+        if (!ordered)
+        {
+            SuiteBenchmark entry = { registered[i].name,
+                                     registered[i].addOptions,
+                                     registered[i].run, 0 };
+            list.push_back(entry);
+        }
+    }
+    return list;
+}
+
+static const SuiteBenchmark *FindSuiteBenchmark(const string &name)
+{
+    for (size_t i = 0; i < benchmarks.size(); i++)
+    {
+        if (name == benchmarks[i].name)
+        {
+            return &benchmarks[i];
+        }
+    }
+    return NULL;
+}
+
+// ****************************************************************************
+// Function: SetThreads
+//
+// Purpose:
+//   Sets the OpenMP thread count of later parallel regions on the selected
+//   backend.  The setting persists across offload regions because the card
+//   keeps one offload thread per host thread.
+//
+// Arguments:
+//   useMIC:   true to configure the card, false for the host
+//   micdev:   the card to configure
+//   nThreads: the thread count
+//
+// Returns:  nothing
+//
+// ****************************************************************************
+static void SetThreads(const bool useMIC, const int micdev, int nThreads)
+{
+    #pragma offload target(mic:micdev) if(useMIC) in(nThreads)
+    {
+        omp_set_num_threads(nThreads);
+    }
+}
+
+// ****************************************************************************
+// Function: BenchmarkArguments
+//
+// Purpose:
+//   Builds the command line one benchmark is parsed with: the suite-wide
+//   common options, followed by the benchmark's --<Name>-opts string so
+//   that it can override them.
+//
+// Arguments:
+//   op:    the suite's options
+//   bench: the benchmark about to run
+//
+// Returns:  the argument list, without a program name
+//
+// ****************************************************************************
+static vector<string> BenchmarkArguments(const OptionParser &op,
+                                         const SuiteBenchmark &bench)
+{
+    vector<string> args;
+    if (op.getOptionBool("verbose"))
+    {
+        args.push_back("--verbose");
+    }
+    args.push_back("--passes");
+    args.push_back(op.getOptionString("passes"));
+    args.push_back("--size");
+    args.push_back(op.getOptionString("size"));
+    args.push_back("--rel-ci");
+    args.push_back(op.getOptionString("rel-ci"));
+    args.push_back("--max-passes");
+    args.push_back(op.getOptionString("max-passes"));
+    args.push_back("--time-budget");
+    args.push_back(op.getOptionString("time-budget"));
+    if (op.getOptionBool("perf-counters"))
+    {
+        args.push_back("--perf-counters");
+    }
+    if (!op.getOptionString("perf-fp-event").empty())
+    {
+        args.push_back("--perf-fp-event");
+        args.push_back(op.getOptionString("perf-fp-event"));
+    }
+    args.push_back("--target");
+    args.push_back(op.getOptionString("target"));
+    args.push_back("--backend");
+    args.push_back(BackendName(op));
+
+    istringstream extra(op.getOptionString(string(bench.name) + "-opts"));
+    string arg;
+    while (extra >> arg)
+    {
+        args.push_back(arg);
+    }
+    return args;
+}
+
+// ****************************************************************************
+// Function: main
+//
+// Purpose:
+//   Single-process driver for the whole suite.  Runs the benchmarks chosen
+//   with --benchmarks one after another, sharing the offload runtime and
+//   OpenMP thread pools, and collects their results into one database.
+//
+// Arguments:
+//   argc, argv: the command line
+//
+// Returns:  0 if every benchmark ran, -1 otherwise
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+int main(int argc, char **argv)
+{
+    SetOffloadDefaults();
+    benchmarks = ListBenchmarks();
+
+    OptionParser op;
+    AddCommonOptions(op);
+    op.addOption("benchmarks", OPT_VECSTRING, "",
+                 "comma separated benchmarks to run (default: all)");
+    op.addOption("threads", OPT_VECSTRING, "",
+                 "per-benchmark thread counts, e.g. MD=224,Reduction=114");
+    op.addOption("list", OPT_BOOL, "", "list the available benchmarks");
+    for (size_t i = 0; i < benchmarks.size(); i++)
+    {
+        op.addOption(string(benchmarks[i].name) + "-opts", OPT_STRING, "",
+                     string("extra options for ") + benchmarks[i].name +
+                     ", e.g. \"--passes 5\"");
+    }
+
+    if (!op.parse(argc, argv))
+    {
+        op.usage();
+        return -1;
+    }
+
+    if (!CheckCommonOptions(op))
+    {
+        return -1;
+    }
+
+    if (op.getOptionBool("list"))
+    {
+        for (size_t i = 0; i < benchmarks.size(); i++)
+        {
+            cout << benchmarks[i].name << endl;
+        }
+        return 0;
+    }
+
+    // Benchmarks to run, in the order given
+    vector<const SuiteBenchmark *> selected;
+    vector<string> names = op.getOptionVecString("benchmarks");
+    for (int i = 0; i < names.size(); i++)
+    {
+        if (names[i].empty())
+        {
+            continue;
+        }
+        const SuiteBenchmark *bench = FindSuiteBenchmark(names[i]);
+        if (bench == NULL)
+        {
+            cerr << "Error: unknown benchmark \"" << names[i]
+                 << "\" (see --list)" << endl;
+            return -1;
+        }
+        selected.push_back(bench);
+    }
+    if (selected.empty())
+    {
+        for (size_t i = 0; i < benchmarks.size(); i++)
+        {
+            selected.push_back(&benchmarks[i]);
+        }
+    }
+
+    // Thread count overrides, Name=N
+    map<string, int> threads;
+    vector<string> threadSpecs = op.getOptionVecString("threads");
+    for (int i = 0; i < threadSpecs.size(); i++)
+    {
+        if (threadSpecs[i].empty())
+        {
+            continue;
+        }
+        const size_t eq = threadSpecs[i].find('=');
+        const string name = threadSpecs[i].substr(0, eq);
+        const int nThreads = (eq == string::npos) ? 0 :
+            atoi(threadSpecs[i].c_str() + eq + 1);
+        if (FindSuiteBenchmark(name) == NULL || nThreads <= 0)
+        {
+            cerr << "Error: invalid thread count \"" << threadSpecs[i]
+                 << "\" (expected Name=N)" << endl;
+            return -1;
+        }
+        threads[name] = nThreads;
+    }
+
+    const bool useMIC = UseOffload(op);
+    const int micdev = op.getOptionInt("target");
+    const int defaultThreads = BackendThreads(op);
+    if (op.getOptionBool("verbose"))
+    {
+        cout << "Using " << BackendName(op) << " backend" << endl;
+    }
+
+    ResultDatabase resultDB;
+    RecordMetadata(argc, argv, op, resultDB);
+
+    RegionTimer timer;
+    int failures = 0;
+    for (int i = 0; i < selected.size(); i++)
+    {
+        const SuiteBenchmark &bench = *selected[i];
+
+        OptionParser benchOp;
+        AddCommonOptions(benchOp);
+        bench.addOptions(benchOp);
+        if (!benchOp.parse(BenchmarkArguments(op, bench)))
+        {
+            cerr << "Error: bad options for " << bench.name << endl;
+            benchOp.usage();
+            failures++;
+            continue;
+        }
+
+        int nThreads = defaultThreads;
+        if (threads.count(bench.name))
+        {
+            nThreads = threads[bench.name];
+        }
+        else if (useMIC && bench.micThreads > 0)
+        {
+            nThreads = bench.micThreads;
+        }
+        SetThreads(useMIC, micdev, nThreads);
+
+        cout << "Running " << bench.name << " (" << nThreads << " threads)"
+             << endl;
+        timer.Start(bench.name);
+        try
+        {
+            bench.run(benchOp, resultDB);
+        }
+        catch (exception &e)
+        {
+            cerr << "Error: " << bench.name << " failed: " << e.what()
+                 << endl;
+            failures++;
+        }
+        catch (...)
+        {
+            cerr << "Error: " << bench.name << " failed" << endl;
+            failures++;
+        }
+        resultDB.AddResult("SuiteTime", bench.name, "s",
+                           timer.Stop(bench.name));
+    }
+    SetThreads(useMIC, micdev, defaultThreads);
+
+    if (!DumpResults(op, resultDB))
+    {
+        return -1;
+    }
+
+    return (failures == 0) ? 0 : -1;
+}
@@ -0,0 +1,371 @@
+// This example from an alpha release of the Scalable HeterOgeneous Computing
+// (SHOC) Benchmark Suite Alpha v1.1.4a-mic for Intel MIC architecture
+// Contact: Kyle Spafford <kys@ornl.gov>
+//          Rezaur Rahman <rezaur.rahman@intel.com>
+//
+// Copyright (c) 2011, UT-Battelle, LLC
+// All rights reserved.
+// 
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//   
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of Oak Ridge National Laboratory, nor UT-Battelle, LLC, 
+//    nor the names of its contributors may be used to endorse or promote 
+//    products derived from this software without specific prior written 
+//    permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE 
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE 
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE 
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, 
+// OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF 
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS 
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN 
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF 
+// THE POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef HOST_STREAM_H
+#define HOST_STREAM_H
+
+#include <stddef.h>
+#include <immintrin.h>
+
+#include "HostCPU.h"
+
+// ****************************************************************************
+// File:  HostStream.h
+//
+// Purpose:
+//   Kernels of the host bandwidth engine, each applied to one thread's part
+//   of the arrays:
+//
+//     Copy   C = A             Read   sum += A
+//     Scale  C = s*A           Write  C = s
+//     Add    C = A + B
+//     Triad  C = A + s*B
+//
+//   Every kernel comes in the same variants.  They differ in how the loop
+//   is vectorized (left to the compiler, or written with AVX2 or AVX-512
+//   intrinsics), in whether C is written with ordinary stores, which first
+//   read the line into the cache, or non-temporal ("-nt") stores that
+//   bypass it, and in how far ahead the inputs are software prefetched.
+//
+//   Arrays are split between threads in whole cache lines, so each thread's
+//   part starts on a line boundary of the 4 KB aligned arrays and the
+//   aligned vector loads and streaming stores are legal.
+//
+// Creation:    October 16, 2026
+//
+// ****************************************************************************
+enum StreamKernel
+{
+    STREAM_COPY,
+    STREAM_SCALE,
+    STREAM_ADD,
+    STREAM_TRIAD,
+    STREAM_READ,
+    STREAM_WRITE,
+    NUM_STREAM_KERNELS
+};
+
+static const char *streamKernelNames[NUM_STREAM_KERNELS] =
+    { "Copy", "Scale", "Add", "Triad", "Read", "Write" };
+
+// Arrays each kernel reads and writes, for the bandwidth it achieved
+// (STREAM convention: the write-allocate read of C is not counted)
+static const int streamKernelArrays[NUM_STREAM_KERNELS] =
+    { 2, 2, 3, 3, 1, 1 };
+
+// Floating point operations per element
+static const int streamKernelFlops[NUM_STREAM_KERNELS] =
+    { 0, 1, 1, 2, 1, 0 };
+
+enum StreamVariant
+{
+    STREAM_COMPILER,
+    STREAM_AVX2,
+    STREAM_AVX2_NT,
+    STREAM_AVX512,
+    STREAM_AVX512_NT,
+    NUM_STREAM_VARIANTS
+};
+
+static const char *streamVariantNames[NUM_STREAM_VARIANTS] =
+    { "compiler", "avx2", "avx2-nt", "avx512", "avx512-nt" };
+
+static const size_t STREAM_LINE_FLOATS = 64 / sizeof(float);
+
+static bool StreamVariantSupported(StreamVariant variant)
+{
+    switch (variant)
+    {
+      case STREAM_AVX2:
+      case STREAM_AVX2_NT:
+        return HostSupports(ISA_AVX2);
+      case STREAM_AVX512:
+      case STREAM_AVX512_NT:
+        return HostSupports(ISA_AVX512);
+      default:
+        return true;
+    }
+}
+
+// Read stores nothing, so its streaming-store variants would repeat the
+// plain ones
+static bool StreamVariantApplies(StreamKernel kernel, StreamVariant variant)
+{
+    return !(kernel == STREAM_READ &&
+             (variant == STREAM_AVX2_NT || variant == STREAM_AVX512_NT));
+}
+
+// Elements [begin, end) of an n element array belong to thread t of nThreads
+static void StreamChunk(size_t n, int t, int nThreads,
+                        size_t &begin, size_t &end)
+{
+    size_t lines = (n + STREAM_LINE_FLOATS - 1) / STREAM_LINE_FLOATS;
+    size_t perThread = lines / nThreads;
+    size_t extra = lines % nThreads;
+    size_t first = t * perThread + ((size_t)t < extra ? t : extra);
+    size_t count = perThread + ((size_t)t < extra ? 1 : 0);
+
+    begin = first * STREAM_LINE_FLOATS;
+    end   = (first + count) * STREAM_LINE_FLOATS;
+    if (begin > n) begin = n;
+    if (end > n)   end = n;
+}
+
+// Element-wise kernels, also used for the tails of the intrinsic variants
+static float StreamCompiler(StreamKernel kernel, const float *A,
+                            const float *B, float *C, const float s,
+                            const size_t n)
+{
+    float sum = 0.0f;
+    switch (kernel)
+    {
+      case STREAM_COPY:
+        #pragma ivdep
+        for (size_t i = 0; i < n; i++)
+            C[i] = A[i];
+        break;
+      case STREAM_SCALE:
+        #pragma ivdep
+        for (size_t i = 0; i < n; i++)
+            C[i] = s*A[i];
+        break;
+      case STREAM_ADD:
+        #pragma ivdep
+        for (size_t i = 0; i < n; i++)
+            C[i] = A[i] + B[i];
+        break;
+      case STREAM_TRIAD:
+        #pragma ivdep
+        for (size_t i = 0; i < n; i++)
+            C[i] = A[i] + s*B[i];
+        break;
+      case STREAM_READ:
+        for (size_t i = 0; i < n; i++)
+            sum += A[i];
+        break;
+      case STREAM_WRITE:
+        #pragma ivdep
+        for (size_t i = 0; i < n; i++)
+            C[i] = s;
+        break;
+      default:
+        break;
+    }
+    return sum;
+}
+
+#ifndef __MIC__
+// One cache line of each array per iteration, so one prefetch per line.
+// K is a StreamKernel; the branches on it fold away at compile time.
+template <int K, bool NT>
+static SHOC_TARGET_AVX2 float StreamAVX2(const float *A, const float *B,
+        float *C, const float s, const size_t n, const size_t prefetch)
+{
+    const __m256 vs = _mm256_set1_ps(s);
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        if (prefetch && K != STREAM_WRITE)
+            _mm_prefetch((const char *)(A + i + prefetch), _MM_HINT_T0);
+        if (prefetch && (K == STREAM_ADD || K == STREAM_TRIAD))
+            _mm_prefetch((const char *)(B + i + prefetch), _MM_HINT_T0);
+
+        __m256 c0 = vs, c1 = vs;
+        if (K != STREAM_WRITE)
+        {
+            c0 = _mm256_load_ps(A + i);
+            c1 = _mm256_load_ps(A + i + 8);
+        }
+        if (K == STREAM_SCALE)
+        {
+            c0 = _mm256_mul_ps(vs, c0);
+            c1 = _mm256_mul_ps(vs, c1);
+        }
+        else if (K == STREAM_ADD)
+        {
+            c0 = _mm256_add_ps(c0, _mm256_load_ps(B + i));
+            c1 = _mm256_add_ps(c1, _mm256_load_ps(B + i + 8));
+        }
+        else if (K == STREAM_TRIAD)
+        {
+            c0 = _mm256_fmadd_ps(vs, _mm256_load_ps(B + i), c0);
+            c1 = _mm256_fmadd_ps(vs, _mm256_load_ps(B + i + 8), c1);
+        }
+
+        if (K == STREAM_READ)
+        {
+            sum0 = _mm256_add_ps(sum0, c0);
+            sum1 = _mm256_add_ps(sum1, c1);
+        }
+        else if (NT)
+        {
+            _mm256_stream_ps(C + i,     c0);
+            _mm256_stream_ps(C + i + 8, c1);
+        }
+        else
+        {
+            _mm256_store_ps(C + i,     c0);
+            _mm256_store_ps(C + i + 8, c1);
+        }
+    }
+    if (NT)
+    {
+        _mm_sfence();
+    }
+
+    float lanes[8];
+    _mm256_storeu_ps(lanes, _mm256_add_ps(sum0, sum1));
+    float sum = StreamCompiler((StreamKernel)K, A + i, B + i, C + i, s, n - i);
+    for (int l = 0; l < 8; l++)
+        sum += lanes[l];
+    return sum;
+}
+
+template <int K, bool NT>
+static SHOC_TARGET_AVX512 float StreamAVX512(const float *A, const float *B,
+        float *C, const float s, const size_t n, const size_t prefetch)
+{
+    const __m512 vs = _mm512_set1_ps(s);
+    __m512 sum0 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        if (prefetch && K != STREAM_WRITE)
+            _mm_prefetch((const char *)(A + i + prefetch), _MM_HINT_T0);
+        if (prefetch && (K == STREAM_ADD || K == STREAM_TRIAD))
+            _mm_prefetch((const char *)(B + i + prefetch), _MM_HINT_T0);
+
+        __m512 c = vs;
+        if (K != STREAM_WRITE)
+            c = _mm512_load_ps(A + i);
+        if (K == STREAM_SCALE)
+            c = _mm512_mul_ps(vs, c);
+        else if (K == STREAM_ADD)
+            c = _mm512_add_ps(c, _mm512_load_ps(B + i));
+        else if (K == STREAM_TRIAD)
+            c = _mm512_fmadd_ps(vs, _mm512_load_ps(B + i), c);
+
+        if (K == STREAM_READ)
+            sum0 = _mm512_add_ps(sum0, c);
+        else if (NT)
+            _mm512_stream_ps(C + i, c);
+        else
+            _mm512_store_ps(C + i, c);
+    }
+    if (NT)
+    {
+        _mm_sfence();
+    }
+
+    float lanes[16];
+    _mm512_storeu_ps(lanes, sum0);
+    float sum = StreamCompiler((StreamKernel)K, A + i, B + i, C + i, s, n - i);
+    for (int l = 0; l < 16; l++)
+        sum += lanes[l];
+    return sum;
+}
+
+template <int K>
+static float StreamIntrinsics(StreamVariant variant, const float *A,
+        const float *B, float *C, const float s, const size_t n,
+        const size_t prefetch)
+{
+    switch (variant)
+    {
+      case STREAM_AVX2:
+        return StreamAVX2<K, false>(A, B, C, s, n, prefetch);
+      case STREAM_AVX2_NT:
+        return StreamAVX2<K, true>(A, B, C, s, n, prefetch);
+      case STREAM_AVX512:
+        return StreamAVX512<K, false>(A, B, C, s, n, prefetch);
+      case STREAM_AVX512_NT:
+        return StreamAVX512<K, true>(A, B, C, s, n, prefetch);
+      default:
+        return StreamCompiler((StreamKernel)K, A, B, C, s, n);
+    }
+}
+#endif
+
+// ****************************************************************************
+// Function: StreamRun
+//
+// Purpose:
+//   Runs one kernel variant over one thread's part of the arrays.
+//
+// Arguments:
+//   kernel:   operation to run
+//   variant:  code generation (must be supported by the host)
+//   A, B, C:  line aligned inputs and output; unused ones may be NULL
+//   s:        the scalar
+//   n:        number of elements
+//   prefetch: software prefetch distance in elements (0: none); only the
+//             intrinsic variants prefetch
+//
+// Returns:  the sum of A for the Read kernel, 0 otherwise
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+static float StreamRun(StreamKernel kernel, StreamVariant variant,
+                       const float *A, const float *B, float *C,
+                       const float s, const size_t n, const size_t prefetch)
+{
+#ifndef __MIC__
+    switch (kernel)
+    {
+      case STREAM_COPY:
+        return StreamIntrinsics<STREAM_COPY>(variant, A, B, C, s, n, prefetch);
+      case STREAM_SCALE:
+        return StreamIntrinsics<STREAM_SCALE>(variant, A, B, C, s, n,
+                                              prefetch);
+      case STREAM_ADD:
+        return StreamIntrinsics<STREAM_ADD>(variant, A, B, C, s, n, prefetch);
+      case STREAM_TRIAD:
+        return StreamIntrinsics<STREAM_TRIAD>(variant, A, B, C, s, n,
+                                              prefetch);
+      case STREAM_READ:
+        return StreamIntrinsics<STREAM_READ>(variant, A, B, C, s, n, prefetch);
+      case STREAM_WRITE:
+        return StreamIntrinsics<STREAM_WRITE>(variant, A, B, C, s, n,
+                                              prefetch);
+      default:
+        return 0.0f;
+    }
+#else
+    return StreamCompiler(kernel, A, B, C, s, n);
+#endif
+}
+
+#endif
@@ -36,21 +36,41 @@
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
+#include <algorithm>
 #include <iostream>
+#include <string>
+#include <vector>
+#include "omp.h"
 
+#include "Backend.h"
+#include "HostCPU.h"
+#include "HostStream.h"
 #include "OptionParser.h"
+#include "PerfCounters.h"
 #include "ResultDatabase.h"
+#include "Benchmark.h"
 #include "Timer.h"
 
-void addBenchmarkSpecOptions(OptionParser &op)
+static void addBenchmarkSpecOptions(OptionParser &op)
 {
-    ;
+    op.addOption("stream-kernels", OPT_VECSTRING, "all",
+                 "host kernels: copy, scale, add, triad, read, write or all");
+    op.addOption("stream-variants", OPT_VECSTRING, "all",
+                 "host kernel code: compiler, avx2, avx2-nt, avx512, "
+                 "avx512-nt or all");
+    op.addOption("prefetch-distances", OPT_VECINT, "0",
+                 "host software prefetch distances in bytes "
+                 "(0: no prefetch)");
+    op.addOption("overlap", OPT_STRING, "both",
+                 "block pipeline runs: pipelined, serial or both");
 }
 
 __declspec(target(MIC)) void Triad(const float* A, const float* B, 
         float* C, const float s, const int start, const int length)
 {
-    int index = (int)((length/256) * 228);
+    // Streaming stores on whole 64 byte lines, the remainder element-wise
+    int index = length & ~15;
 
     #pragma omp parallel for
     #pragma vector aligned
@@ -73,52 +93,792 @@ __declspec(target(MIC)) void Triad(const float* A, const float* B,
 
 __declspec(target(MIC) align(4096)) float *A0, *B0, *C0,*A1, *B1, *C1;
 
-void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
+const int nSizes = 14;
+const size_t blockSizes[] = { 64, 128, 256, 512, 1024, 2048, 4096, 8192,
+    16384, 32768, 65536, 131072, 262144, 524288, 1048576};
+
+// Host array sizes in KB: the block sizes, preceded by sizes that fit the
+// first level cache, so the curve covers L1 to DRAM
+const int nHostSizes = 18;
+const size_t hostSizes[] = { 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048,
+    4096, 8192, 16384, 32768, 65536, 131072, 262144, 524288 };
+
+// Each timed host run streams at least this much, repeating small arrays
+static const double HOST_MIN_BYTES = 256.0 * 1024 * 1024;
+
+// Input values: small integers, so every result is exact in single
+// precision.  A sums to zero over any 7 elements, also in a vector lane
+// that sees every 8th or 16th of them, which keeps the Read partial sums
+// small however long the array.
+static inline float StreamA(size_t j) { return (float)(j % 7) - 3.0f; }
+static inline float StreamB(size_t j) { return (float)(j % 5); }
+
+// Value C[j] must hold after a kernel ran
+static float StreamExpected(StreamKernel kernel, size_t j, float s)
+{
+    switch (kernel)
+    {
+      case STREAM_COPY:  return StreamA(j);
+      case STREAM_SCALE: return s*StreamA(j);
+      case STREAM_ADD:   return StreamA(j) + StreamB(j);
+      case STREAM_TRIAD: return StreamA(j) + s*StreamB(j);
+      case STREAM_WRITE: return s;
+      default:           return 0.0f;
+    }
+}
+
+// ****************************************************************************
+// Function: HostStreamTeam
+//
+// Purpose:
+//   Runs the host bandwidth engine with the OpenMP team pinned to one set
+//   of CPUs.  For each array size the arrays are allocated and initialized
+//   by the same threads, in the same line-aligned parts, that the kernels
+//   later use, so with first-touch page placement every thread streams
+//   through memory of its own NUMA node.
+//
+// Arguments:
+//   op:        the options parser / parameter database
+//   resultDB:  where results are stored
+//   cpus:      the CPU for each thread
+//   suffix:    appended to the result names ("" or "_socket<N>")
+//   kernels:   operations to run
+//   variants:  code generation variants to run
+//   prefetch:  prefetch distances to run, in bytes
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+static void HostStreamTeam(OptionParser &op, ResultDatabase &resultDB,
+                           const vector<int> &cpus, const string &suffix,
+                           const vector<StreamKernel> &kernels,
+                           const vector<StreamVariant> &variants,
+                           const vector<long long> &prefetch)
+{
+    const bool verbose = op.getOptionBool("verbose");
+    const int n_passes = op.getOptionInt("passes");
+    const float scalar = 1.75f;
+
+    PinOpenMPThreads(cpus);
+
+    char sizeStr[256];
+    RegionTimer timer;
+    PerfCounters counters(op);
+    vector<double> sums(cpus.size());
+
+    for (int pass = 0; pass < n_passes; ++pass)
+    {
+        for (int i = 0; i < nHostSizes; ++i)
+        {
+            const size_t n = hostSizes[i] * 1024 / sizeof(float);
+            const size_t bytes = n * sizeof(float);
+            sprintf(sizeStr, "Block:%05ldKB", hostSizes[i]);
+
+            float *A = (float *)BackendAlloc(bytes, ALIGNMENT);
+            float *B = (float *)BackendAlloc(bytes, ALIGNMENT);
+            float *C = (float *)BackendAlloc(bytes, ALIGNMENT);
+            if (!A || !B || !C)
+            {
+                cerr << "Error: unable to allocate arrays of "
+                     << hostSizes[i] << " KB" << endl;
+                BackendFree(A);
+                BackendFree(B);
+                BackendFree(C);
+                break;
+            }
+
+            // First touch
+            #pragma omp parallel
+            {
+                size_t begin, end;
+                StreamChunk(n, omp_get_thread_num(), omp_get_num_threads(),
+                            begin, end);
+                for (size_t j = begin; j < end; j++)
+                {
+                    A[j] = StreamA(j);
+                    B[j] = StreamB(j);
+                }
+            }
+            double sumA = 0.0;
+            for (size_t j = 0; j < n; j++)
+            {
+                sumA += StreamA(j);
+            }
+
+            for (int k = 0; k < kernels.size(); k++)
+            for (int v = 0; v < variants.size(); v++)
+            for (int p = 0; p < prefetch.size(); p++)
+            {
+                const StreamKernel kernel = kernels[k];
+                const StreamVariant variant = variants[v];
+                const size_t distance = prefetch[p] / sizeof(float);
+                if (!StreamVariantApplies(kernel, variant))
+                    continue;
+
+                const double traffic = (double)streamKernelArrays[kernel]
+                                     * bytes;
+                const int reps = (int)max(1.0, HOST_MIN_BYTES / traffic);
+
+                char pfStr[64] = "";
+                if (prefetch[p] > 0)
+                {
+                    sprintf(pfStr, "_pf%lld", prefetch[p]);
+                }
+                const string test = string(streamKernelNames[kernel])
+                    + "Bdwth_" + streamVariantNames[variant] + pfStr + suffix;
+
+                if (verbose)
+                {
+                    cout << ">> " << test << ": " << reps << " runs over "
+                         << n << " elements on " << cpus.size()
+                         << " threads\n";
+                }
+
+                // Clear C so a kernel that writes nothing fails the check
+                #pragma omp parallel
+                {
+                    size_t begin, end;
+                    StreamChunk(n, omp_get_thread_num(),
+                                omp_get_num_threads(), begin, end);
+                    for (size_t j = begin; j < end; j++)
+                        C[j] = -1.0f;
+                }
+
+                counters.Start();
+                timer.Start(test);
+                #pragma omp parallel
+                {
+                    const int t = omp_get_thread_num();
+                    size_t begin, end;
+                    StreamChunk(n, t, omp_get_num_threads(), begin, end);
+                    // Every repetition feeds the result, so none of them
+                    // can be dropped; double keeps reps partial sums exact
+                    double sum = 0.0;
+                    for (int r = 0; r < reps; r++)
+                    {
+                        sum += StreamRun(kernel, variant, A + begin,
+                                        B + begin, C + begin, scalar,
+                                        end - begin, distance);
+                    }
+                    sums[t] = sum;
+                }
+                double time = timer.Stop(test);
+                counters.Stop();
+
+                double bdwth = traffic * reps / (time * 1.e9);
+                resultDB.AddResult(test, sizeStr, "GB/s", bdwth);
+                counters.Record(resultDB, test, sizeStr,
+                        (double)streamKernelFlops[kernel] * n * reps);
+
+                if (kernel == STREAM_READ)
+                {
+                    double sum = 0.0;
+                    for (int t = 0; t < sums.size(); t++)
+                        sum += sums[t];
+                    if (sum != sumA * reps)
+                    {
+                        cout << "Error; " << test << " sum=" << sum
+                             << " instead of " << sumA * reps << "\n";
+                    }
+                    continue;
+                }
+                for (size_t j = 0; j < n; j += 997)
+                {
+                    float expect = StreamExpected(kernel, j, scalar);
+                    if (C[j] != expect)
+                    {
+                        cout << "Error; " << test << " C[" << j << "]="
+                             << C[j] << " instead of " << expect
+                             << ", stopping check\n";
+                        break;
+                    }
+                }
+            }
+
+            BackendFree(A);
+            BackendFree(B);
+            BackendFree(C);
+        }
+    }
+
+    UnpinOpenMPThreads();
+}
+
+// Resolves a list of names against a table, "all" selecting every entry
+static bool ParseNames(const vector<string> &names, const char *table[],
+                       int nEntries, const char *what, vector<int> &selected)
+{
+    for (int i = 0; i < names.size(); i++)
+    {
+        bool found = false;
+        for (int e = 0; e < nEntries; e++)
+        {
+            if (names[i] == "all" || strcasecmp(names[i].c_str(),
+                                                table[e]) == 0)
+            {
+                selected.push_back(e);
+                found = true;
+            }
+        }
+        if (!found)
+        {
+            cerr << "Error: unknown " << what << " \"" << names[i] << "\""
+                 << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// ****************************************************************************
+// Function: RunHostStream
+//
+// Purpose:
+//   The host backend's Triad: a STREAM-style sweep of array sizes from L1
+//   to DRAM for every selected kernel, variant and prefetch distance, first
+//   with all sockets and then, on multi-socket hosts, with each socket
+//   alone.
+//
+// Arguments:
+//   op:       the options parser / parameter database
+//   resultDB: where results are stored
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+static void RunHostStream(OptionParser &op, ResultDatabase &resultDB)
+{
+    vector<int> selected;
+    if (!ParseNames(op.getOptionVecString("stream-kernels"),
+                    streamKernelNames, NUM_STREAM_KERNELS, "kernel",
+                    selected))
+    {
+        return;
+    }
+    vector<StreamKernel> kernels;
+    for (int i = 0; i < selected.size(); i++)
+    {
+        kernels.push_back((StreamKernel)selected[i]);
+    }
+
+    vector<string> names = op.getOptionVecString("stream-variants");
+    selected.clear();
+    if (!ParseNames(names, streamVariantNames, NUM_STREAM_VARIANTS,
+                    "variant", selected))
+    {
+        return;
+    }
+    vector<StreamVariant> variants;
+    for (int i = 0; i < selected.size(); i++)
+    {
+        StreamVariant variant = (StreamVariant)selected[i];
+        if (StreamVariantSupported(variant))
+        {
+            variants.push_back(variant);
+        }
+        else if (find(names.begin(), names.end(), "all") == names.end())
+        {
+            cerr << "Warning: this host cannot run the "
+                 << streamVariantNames[variant] << " kernels, skipping them"
+                 << endl;
+        }
+    }
+
+    vector<long long> prefetch = op.getOptionVecInt("prefetch-distances");
+    if (prefetch.empty())
+    {
+        prefetch.push_back(0);
+    }
+
+    // OMP_NUM_THREADS threads, dealt round-robin over the sockets so a
+    // partial team still uses every memory controller
+    const int nThreads = omp_get_max_threads();
+    vector<vector<int> > sockets = HostSockets();
+    vector<int> allCPUs;
+    for (int k = 0; allCPUs.size() < nThreads; k++)
+    {
+        bool added = false;
+        for (int s = 0; s < sockets.size() && allCPUs.size() < nThreads; s++)
+        {
+            if (k < sockets[s].size())
+            {
+                allCPUs.push_back(sockets[s][k]);
+                added = true;
+            }
+        }
+        if (!added)
+            break;
+    }
+
+    HostStreamTeam(op, resultDB, allCPUs, "", kernels, variants, prefetch);
+    if (sockets.size() > 1)
+    {
+        for (int s = 0; s < sockets.size(); s++)
+        {
+            vector<int> cpus(sockets[s].begin(), sockets[s].begin() +
+                             min((int)sockets[s].size(), nThreads));
+            char suffix[64];
+            sprintf(suffix, "_socket%d", s);
+            HostStreamTeam(op, resultDB, cpus, suffix, kernels, variants,
+                           prefetch);
+        }
+    }
+}
+
+// ****************************************************************************
+// Function: OffloadTriadPipelined
+//
+// Purpose:
+//   Streams the arrays through the card block by block with two buffer
+//   sets: while the card computes on one set, the inputs of the next block
+//   are sent into the other and the previous result comes back.
+//
+// Arguments:
+//   elemsInBlock: block size in elements
+//   numMaxFloats: array length in elements
+//   scalar:       the Triad scalar
+//   useMIC:       whether the offload regions run on the card
+//   micdev:       the card
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+static void OffloadTriadPipelined(const int elemsInBlock,
+        const int numMaxFloats, const float scalar, const bool useMIC,
+        const int micdev)
+{
+    int crtIdx = 0;
+
+    #pragma offload target(mic:micdev) if(useMIC) \
+    in(A0:length(elemsInBlock) free_if (0) alloc_if (0) ) \
+    in(B0:length(elemsInBlock) free_if (0) alloc_if (0) ) \
+    nocopy(C0:free_if (0) alloc_if (0))
+    {
+        fflush(0);
+        Triad(A0, B0, C0,  scalar, crtIdx, elemsInBlock);
+    }
+    #pragma offload_transfer target(mic:micdev) if(useMIC) \
+    out(C0 [0:elemsInBlock]:alloc_if (0) free_if (0)) signal(C0)
+
+    if (elemsInBlock < numMaxFloats)
+    {
+        // start downloading data for next block
+        #pragma offload_transfer target(mic:micdev) if(useMIC) \
+        in(A1[elemsInBlock:elemsInBlock]: free_if (0) alloc_if (0)) \
+        in(B1[elemsInBlock:elemsInBlock]: free_if (0) alloc_if (0)) \
+        signal(A1)
+    }
+    int blockIdx = 1;
+    unsigned int currStream = 1;
+
+    while (crtIdx < numMaxFloats)
+    {
+        currStream = blockIdx & 1;
+        if (currStream)
+        {
+            #pragma offload_wait target(mic:micdev) if(useMIC) wait(C0)
+        }
+
+        else
+        {
+            #pragma offload_wait target(mic:micdev) if(useMIC) wait(C1)
+        }
+
+        crtIdx += elemsInBlock;
+        if (crtIdx < numMaxFloats)
+        {
+            if (currStream)
+            {
+                #pragma offload target(mic:micdev) if(useMIC) \
+                nocopy(A1,B1) wait(A1) nocopy(C1)
+                {
+                    Triad(A1, B1, C1,  scalar, crtIdx, elemsInBlock);
+                }
+                #pragma offload_transfer target(mic:micdev) if(useMIC) \
+                out(C1[crtIdx:elemsInBlock]:alloc_if (0) free_if (0) ) \
+                signal(C1)
+            }
+            else
+            {
+                #pragma offload target(mic:micdev) if(useMIC) \
+                nocopy(A0,B0) wait(A0) nocopy(C0)
+                {
+                    Triad(A0, B0, C0,  scalar, crtIdx, elemsInBlock);
+                }
+
+                #pragma offload_transfer target(mic:micdev) if(useMIC) \
+                out(C0[crtIdx:elemsInBlock]:alloc_if (0) free_if (0) )\
+                signal(C0)
+            }
+        }
+        if (crtIdx+elemsInBlock < numMaxFloats)
+        {
+            if (currStream)
+            {
+                #pragma offload_transfer target(mic:micdev) if(useMIC) \
+                in(A0[crtIdx+elemsInBlock:elemsInBlock]: free_if (0)   \
+                     alloc_if (0))                                     \
+                in(B0[crtIdx+elemsInBlock:elemsInBlock]: free_if (0)   \
+                     alloc_if (0)) signal(A0)
+            }
+            else
+            {
+                #pragma offload_transfer target(mic:micdev) if(useMIC) \
+                in(A1[crtIdx+elemsInBlock:elemsInBlock]: free_if (0)   \
+                    alloc_if (0))                                      \
+                in(B1[crtIdx+elemsInBlock:elemsInBlock]: free_if (0)   \
+                    alloc_if (0)) signal(A1)
+            }
+        }
+        blockIdx += 1;
+        currStream = !currStream;
+    }
+}
+
+// ****************************************************************************
+// Function: OffloadTriadSerial
+//
+// Purpose:
+//   The same blocks without overlap: each block is sent, computed and
+//   brought back before the next one starts.
+//
+// Arguments:
+//   elemsInBlock: block size in elements
+//   numMaxFloats: array length in elements
+//   scalar:       the Triad scalar
+//   useMIC:       whether the offload regions run on the card
+//   micdev:       the card
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+static void OffloadTriadSerial(const int elemsInBlock,
+        const int numMaxFloats, const float scalar, const bool useMIC,
+        const int micdev)
+{
+    for (int crtIdx = 0; crtIdx < numMaxFloats; crtIdx += elemsInBlock)
+    {
+        #pragma offload target(mic:micdev) if(useMIC) \
+        in(A0[crtIdx:elemsInBlock]: free_if (0) alloc_if (0))       \
+        in(B0[crtIdx:elemsInBlock]: free_if (0) alloc_if (0))       \
+        out(C0[crtIdx:elemsInBlock]: free_if (0) alloc_if (0))
+        {
+            Triad(A0, B0, C0,  scalar, crtIdx, elemsInBlock);
+        }
+    }
+}
+
+// Adds the results of one block size; times <= 0 were not measured
+static void AddOverlapResults(ResultDatabase &resultDB, const char *sizeStr,
+                              double nFloats, double pipelined, double serial)
+{
+    const double bytes = nFloats * sizeof(float) * 3.0;
+    if (pipelined > 0)
+    {
+        resultDB.AddResult("TriadFlops", sizeStr, "GFLOP/s",
+                           nFloats * 2.0 / (pipelined * 1e9));
+        resultDB.AddResult("TriadBdwth", sizeStr, "GB/s",
+                           bytes / (pipelined * 1e9));
+    }
+    if (serial > 0)
+    {
+        resultDB.AddResult("TriadBdwth_Serial", sizeStr, "GB/s",
+                           bytes / (serial * 1e9));
+    }
+    if (pipelined > 0 && serial > 0)
+    {
+        resultDB.AddResult("TriadOverlapSpeedup", sizeStr, "x",
+                           serial / pipelined);
+    }
+}
+
+// Host stand-in for the card in the block pipeline: block buffers the
+// OpenMP team computes on, filled and drained by a copy thread the way the
+// DMA engines serve the card
+struct HostPipeline
+{
+    const float *A, *B;
+    float       *C;
+    float       *bufA[2], *bufB[2], *bufC[2];
+    size_t       n;
+    size_t       block;
+    int          nBlocks;
+    float        scalar;
+    pthread_barrier_t step;
+};
+
+static size_t HostBlockLength(const HostPipeline *p, int b)
+{
+    return min(p->block, p->n - (size_t)b * p->block);
+}
+
+static void HostBlockLoad(HostPipeline *p, int b, int set)
+{
+    size_t start = (size_t)b * p->block;
+    memcpy(p->bufA[set], p->A + start, HostBlockLength(p, b) * sizeof(float));
+    memcpy(p->bufB[set], p->B + start, HostBlockLength(p, b) * sizeof(float));
+}
+
+static void HostBlockStore(HostPipeline *p, int b, int set)
+{
+    size_t start = (size_t)b * p->block;
+    memcpy(p->C + start, p->bufC[set], HostBlockLength(p, b) * sizeof(float));
+}
+
+static void HostBlockCompute(HostPipeline *p, int b, int set)
+{
+    const size_t length = HostBlockLength(p, b);
+    #pragma omp parallel
+    {
+        size_t begin, end;
+        StreamChunk(length, omp_get_thread_num(), omp_get_num_threads(),
+                    begin, end);
+        StreamRun(STREAM_TRIAD, STREAM_COMPILER, p->bufA[set] + begin,
+                  p->bufB[set] + begin, p->bufC[set] + begin, p->scalar,
+                  end - begin, 0);
+    }
+}
+
+// Step s loads block s into set s&1 and stores block s-2 from the same set,
+// while the team computes block s-1 in the other set
+static void *HostPipelineCopier(void *arg)
+{
+    HostPipeline *p = (HostPipeline *)arg;
+    for (int s = 0; s < p->nBlocks + 2; s++)
+    {
+        if (s < p->nBlocks)
+            HostBlockLoad(p, s, s & 1);
+        if (s >= 2)
+            HostBlockStore(p, s - 2, s & 1);
+        pthread_barrier_wait(&p->step);
+    }
+    return NULL;
+}
+
+static void HostTriadPipelined(HostPipeline *p)
+{
+    pthread_t copier;
+    pthread_barrier_init(&p->step, NULL, 2);
+    pthread_create(&copier, NULL, HostPipelineCopier, p);
+    for (int s = 0; s < p->nBlocks + 2; s++)
+    {
+        if (s >= 1 && s <= p->nBlocks)
+            HostBlockCompute(p, s - 1, (s - 1) & 1);
+        pthread_barrier_wait(&p->step);
+    }
+    pthread_join(copier, NULL);
+    pthread_barrier_destroy(&p->step);
+}
+
+static void HostTriadSerial(HostPipeline *p)
+{
+    for (int b = 0; b < p->nBlocks; b++)
+    {
+        HostBlockLoad(p, b, 0);
+        HostBlockCompute(p, b, 0);
+        HostBlockStore(p, b, 0);
+    }
+}
+
+// ****************************************************************************
+// Function: RunHostPipeline
+//
+// Purpose:
+//   The block pipeline of the offload Triad on the host backend.  The
+//   arrays are moved block by block between host memory and small block
+//   buffers by one copy thread, standing in for the PCIe transfers, while
+//   the OpenMP team runs Triad on the buffers.  Pipelined and serial runs
+//   give the same results as on the card, so the benefit of overlapping
+//   transfers with compute can be compared.  Only block sizes that split
+//   the arrays into at least 8 blocks are run; with fewer there is little
+//   to overlap.
+//
+// Arguments:
+//   op:       the options parser / parameter database
+//   resultDB: where results are stored
+//   overlap:  "pipelined", "serial" or "both"
+//
+// Returns:  nothing
+//
+// Creation: October 16, 2026
+//
+// ****************************************************************************
+static void RunHostPipeline(OptionParser &op, ResultDatabase &resultDB,
+                            const string &overlap)
+{
+    const bool verbose = op.getOptionBool("verbose");
+    const int n_passes = op.getOptionInt("passes");
+    const size_t n = blockSizes[nSizes - 1] * 1024 / sizeof(float);
+
+    HostPipeline p;
+    p.n = n;
+    p.scalar = 1.75f;
+    float *A = (float *)BackendAlloc(n * sizeof(float), ALIGNMENT);
+    float *B = (float *)BackendAlloc(n * sizeof(float), ALIGNMENT);
+    float *C = (float *)BackendAlloc(n * sizeof(float), ALIGNMENT);
+    if (!A || !B || !C)
+    {
+        cerr << "Error: unable to allocate the Triad pipeline arrays" << endl;
+        BackendFree(A);
+        BackendFree(B);
+        BackendFree(C);
+        return;
+    }
+    #pragma omp parallel for schedule(static)
+    for (size_t j = 0; j < n; j++)
+    {
+        A[j] = StreamA(j);
+        B[j] = StreamB(j);
+    }
+    p.A = A;
+    p.B = B;
+    p.C = C;
+
+    char sizeStr[256];
+    RegionTimer timer;
+
+    for (int pass = 0; pass < n_passes; ++pass)
+    {
+        for (int i = 0; i < nSizes; ++i)
+        {
+            if (blockSizes[i] * 8 > blockSizes[nSizes - 1])
+                break;
+
+            p.block = blockSizes[i] * 1024 / sizeof(float);
+            p.nBlocks = (int)((n + p.block - 1) / p.block);
+            sprintf(sizeStr, "Block:%05ldKB", blockSizes[i]);
+            if (verbose)
+            {
+                cout << ">> Executing the Triad pipeline with vectors of "
+                     << "length " << n << " and block size of " << p.block
+                     << " elements." << "\n";
+            }
+
+            bool ok = true;
+            for (int s = 0; s < 2; s++)
+            {
+                p.bufA[s] = (float *)BackendAlloc(p.block * sizeof(float),
+                                                  ALIGNMENT);
+                p.bufB[s] = (float *)BackendAlloc(p.block * sizeof(float),
+                                                  ALIGNMENT);
+                p.bufC[s] = (float *)BackendAlloc(p.block * sizeof(float),
+                                                  ALIGNMENT);
+                ok = ok && p.bufA[s] && p.bufB[s] && p.bufC[s];
+            }
+
+            double times[2] = { 0.0, 0.0 };
+            const char *modes[2] = { "pipelined", "serial" };
+            for (int m = 0; ok && m < 2; m++)
+            {
+                if (overlap != "both" && overlap != modes[m])
+                    continue;
+
+                memset(C, 0, n * sizeof(float));
+                const string region = string(sizeStr) + "_" + modes[m];
+                timer.Start(region);
+                if (m == 0)
+                    HostTriadPipelined(&p);
+                else
+                    HostTriadSerial(&p);
+                times[m] = timer.Stop(region);
+
+                for (size_t j = 0; j < n; j += 997)
+                {
+                    float expect = StreamExpected(STREAM_TRIAD, j, p.scalar);
+                    if (C[j] != expect)
+                    {
+                        cout << "Error; " << modes[m] << " Triad C[" << j
+                             << "]=" << C[j] << " instead of " << expect
+                             << ", stopping check\n";
+                        break;
+                    }
+                }
+            }
+            if (!ok)
+            {
+                cerr << "Error: unable to allocate Triad pipeline blocks of "
+                     << blockSizes[i] << " KB" << endl;
+            }
+            AddOverlapResults(resultDB, sizeStr, n, times[0], times[1]);
+
+            for (int s = 0; s < 2; s++)
+            {
+                BackendFree(p.bufA[s]);
+                BackendFree(p.bufB[s]);
+                BackendFree(p.bufC[s]);
+            }
+        }
+    }
+
+    BackendFree(A);
+    BackendFree(B);
+    BackendFree(C);
+}
+
+static void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
 {
     const bool verbose = op.getOptionBool("verbose");
     const int n_passes = op.getOptionInt("passes");
     const int micdev = op.getOptionInt("target");
+    const bool useMIC = UseOffload(op);
+
+    const string overlap = op.getOptionString("overlap");
+    if (overlap != "pipelined" && overlap != "serial" && overlap != "both")
+    {
+        cerr << "Error: unknown overlap mode \"" << overlap
+             << "\" (expected pipelined, serial or both)" << endl;
+        return;
+    }
+
+    if (!useMIC)
+    {
+        RunHostStream(op, resultDB);
+        RunHostPipeline(op, resultDB, overlap);
+        return;
+    }
 
-    const int nSizes = 14;
-    const size_t blockSizes[] = { 64, 128, 256, 512, 1024, 2048, 4096, 8192,
-        16384, 32768, 65536, 131072, 262144, 524288, 1048576};
     const size_t memSize =  blockSizes[nSizes - 1];
     int  numMaxFloats = 1024 * memSize / sizeof(float);
     int  halfNumFloats = numMaxFloats / 2;
+    const size_t maxBytes = sizeof(float) * numMaxFloats;
 
     __declspec(target(MIC)) float *h_mem;
-    h_mem = (float *) _mm_malloc(sizeof(float)*numMaxFloats,ALIGNMENT);
+    h_mem = (float *) BackendAlloc(maxBytes, ALIGNMENT);
 
-    A0 =  (float *)_mm_malloc( blockSizes[nSizes - 1] * 1024, ALIGNMENT);
-    B0 =  (float *)_mm_malloc( blockSizes[nSizes - 1] * 1024, ALIGNMENT);
-    C0 =  (float *)_mm_malloc( blockSizes[nSizes - 1] * 1024, ALIGNMENT);
+    A0 =  (float *)BackendAlloc(maxBytes, ALIGNMENT);
+    B0 =  (float *)BackendAlloc(maxBytes, ALIGNMENT);
+    C0 =  (float *)BackendAlloc(maxBytes, ALIGNMENT);
 
     float *A0dummy, *B0dummy,  *C0dummy, *A1dummy, *B1dummy, * C1dummy;
     A0dummy = A0;
     B0dummy = B0;
     C0dummy = C0;
-    A1 =  ( float *)_mm_malloc( blockSizes[nSizes - 1] * 1024, ALIGNMENT);
-    B1 =  ( float *)_mm_malloc( blockSizes[nSizes - 1] * 1024, ALIGNMENT);
-    C1 =  ( float *)_mm_malloc( blockSizes[nSizes - 1] * 1024, ALIGNMENT);
+    A1 =  (float *)BackendAlloc(maxBytes, ALIGNMENT);
+    B1 =  (float *)BackendAlloc(maxBytes, ALIGNMENT);
+    C1 =  (float *)BackendAlloc(maxBytes, ALIGNMENT);
     A1dummy = A1;
     B1dummy = B1;
     C1dummy = C1;
 
-
-    #pragma offload target(MIC:0) \
-    in(A0:length(numMaxFloats) free_if (0) alloc_if (1) align(4096)) \
-    in(B0:length(numMaxFloats) free_if (0) alloc_if (1) align(4096)) \
-    inout(C0:length(numMaxFloats) free_if (0) alloc_if (1) align(4096))
-    { }
-
-    #pragma offload target(MIC:0) \
-    in(A1:length(numMaxFloats) free_if (0) alloc_if (1) align(4096)) \
-    in(B1:length(numMaxFloats) free_if (0) alloc_if (1) align(4096)) \
-    inout(C1:length(numMaxFloats) free_if (0) alloc_if (1) align(4096))
-    { }
+    // The blocks are sent by the pipeline itself
+    float *bufs[] = { A0, B0, C0, A1, B1, C1 };
+    for (int b = 0; b < 6; b++)
+    {
+        BackendCreate(op, bufs[b], maxBytes);
+    }
 
     float scalar = 1.75f;
     char sizeStr[256];
+    RegionTimer timer;
+    PerfCounters counters(op);
     
     for (int pass = 0; pass < n_passes; ++pass)
     {
@@ -144,101 +904,27 @@ void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
             }
             sprintf(sizeStr, "Block:%05ldKB", blockSizes[i]);
 
-            int crtIdx = 0;
-            double startTime = curr_second();
-
-            #pragma offload target(MIC:0) \
-            in(A0:length(elemsInBlock) free_if (0) alloc_if (0) ) \
-            in(B0:length(elemsInBlock) free_if (0) alloc_if (0) ) \
-            nocopy(C0:free_if (0) alloc_if (0))
+            double time = 0.0, serialTime = 0.0;
+            if (overlap != "serial")
             {
-                fflush(0);
-                Triad(A0, B0, C0,  scalar, crtIdx, elemsInBlock);
+                counters.Start();
+                timer.Start(sizeStr);
+                OffloadTriadPipelined(elemsInBlock, numMaxFloats, scalar,
+                                      useMIC, micdev);
+                time = timer.Stop(sizeStr);
+                counters.Stop();
+                counters.Record(resultDB, "TriadBdwth", sizeStr,
+                                numMaxFloats * 2.0);
             }
-            #pragma offload_transfer target(mic:0) \
-            out(C0 [0:elemsInBlock]:alloc_if (0) free_if (0)) signal(C0)
-
-            if (elemsInBlock < numMaxFloats)
+            if (overlap != "pipelined")
             {
-                // start downloading data for next block
-                #pragma offload_transfer target(MIC:0)                      \
-                in(A1[elemsInBlock:elemsInBlock]: free_if (0) alloc_if (0)) \
-                in(B1[elemsInBlock:elemsInBlock]: free_if (0) alloc_if (0)) \
-                signal(A1)
+                timer.Start(string(sizeStr) + "_serial");
+                OffloadTriadSerial(elemsInBlock, numMaxFloats, scalar,
+                                   useMIC, micdev);
+                serialTime = timer.Stop(string(sizeStr) + "_serial");
             }
-            int blockIdx = 1;
-            unsigned int currStream = 1;
-
-            while (crtIdx < numMaxFloats)
-            {
-                currStream = blockIdx & 1;
-                if (currStream)
-                {
-                    #pragma offload_wait target(mic:0) wait(C0)
-                }
-
-                else
-                {
-                    #pragma offload_wait target(mic:0) wait(C1)
-                }
-
-                crtIdx += elemsInBlock;
-                if (crtIdx < numMaxFloats)
-                {
-                    if (currStream)
-                    {
-                        #pragma offload target(MIC:0) \
-                        nocopy(A1,B1) wait(A1) nocopy(C1)
-                        {
-                            Triad(A1, B1, C1,  scalar, crtIdx, elemsInBlock);
-                        }
-                        #pragma offload_transfer target(mic:0)                 \
-                        out(C1[crtIdx:elemsInBlock]:alloc_if (0) free_if (0) ) \
-                        signal(C1)
-                    }
-                    else
-                    {
-                        #pragma offload target(MIC:0) nocopy(A0,B0) wait(A0)  \
-                        nocopy(C0)
-                        {
-                            Triad(A0, B0, C0,  scalar, crtIdx, elemsInBlock);
-                        }
-
-                        #pragma offload_transfer target(mic:0)                \
-                        out(C0[crtIdx:elemsInBlock]:alloc_if (0) free_if (0) )\
-                        signal(C0)
-                    }
-                }
-                if (crtIdx+elemsInBlock < numMaxFloats)
-                {
-                    if (currStream)
-                    {
-                        #pragma offload_transfer target(MIC:0)                 \
-                        in(A0[crtIdx+elemsInBlock:elemsInBlock]: free_if (0)   \
-                             alloc_if (0))                                     \
-                        in(B0[crtIdx+elemsInBlock:elemsInBlock]: free_if (0)   \
-                             alloc_if (0)) signal(A0)
-                    }
-                    else
-                    {
-                        #pragma offload_transfer target(MIC:0)                 \
-                        in(A1[crtIdx+elemsInBlock:elemsInBlock]: free_if (0)   \
-                            alloc_if (0))                                      \
-                        in(B1[crtIdx+elemsInBlock:elemsInBlock]: free_if (0)   \
-                            alloc_if (0)) signal(A1)
-                    }
-                }
-                blockIdx += 1;
-                currStream = !currStream;
-            } // end while
-
-            double time = curr_second()-startTime;
-            double triadFlops = ((double)numMaxFloats * 2.0) / (time*1e9);
-            resultDB.AddResult("TriadFlops", sizeStr, "GFLOP/s", triadFlops);
-
-            double bdwth = ((double)numMaxFloats*sizeof(float)*3.0)
-                / (time*1000.*1000.*1000.);
-            resultDB.AddResult("TriadBdwth", sizeStr, "GB/s", bdwth);
+            AddOverlapResults(resultDB, sizeStr, numMaxFloats, time,
+                              serialTime);
             fflush(stdout);
 
 	    if(blockSizes[i] >= 1024 * 1024)
@@ -269,17 +955,10 @@ void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
         } // end for
     } // end for
 
-    #pragma offload target(MIC:0)                        \
-    in(A0:length(numMaxFloats) alloc_if (0) free_if (1)) \
-    in(B0:length(numMaxFloats) alloc_if (0) free_if (1)) \
-    out(C0:length(numMaxFloats) alloc_if (0) free_if (1))
-    { }
-
-    #pragma offload target(MIC:0)                        \
-    in(A1:length(numMaxFloats) alloc_if (0) free_if (1)) \
-    in(B1:length(numMaxFloats) alloc_if (0) free_if (1)) \
-    out(C1:length(numMaxFloats) alloc_if (0) free_if (1))
-    { }
+    for (int b = 0; b < 6; b++)
+    {
+        BackendRelease(op, bufs[b], maxBytes);
+    }
 
     // Cleanup
     A0=A0dummy;
@@ -288,12 +967,13 @@ void RunBenchmark(OptionParser &op, ResultDatabase &resultDB)
     A1=A1dummy;
     B1=B1dummy;
     C1=C1dummy;
-    _mm_free(h_mem);
-    _mm_free(A0);
-    _mm_free(B0);
-    _mm_free(C0);
-    _mm_free(A1);
-    _mm_free(B1);
-    _mm_free(C1);
+    BackendFree(h_mem);
+    BackendFree(A0);
+    BackendFree(B0);
+    BackendFree(C0);
+    BackendFree(A1);
+    BackendFree(B1);
+    BackendFree(C1);
 }
 
+SHOC_REGISTER_BENCHMARK(Triad);